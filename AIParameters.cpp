@@ -0,0 +1,81 @@
+/* AIParameters.cpp
+ *
+ * Author: Colin Siles
+ *
+ * The AIParameters struct collects the IntelligentComputer's tunable settings, so that they can be tuned by self-play
+ * (see autotune.cpp) and read back from a parameter file when the game starts
+*/
+
+#include <fstream>
+#include <iostream>
+#include <sstream>
+
+#include "AIParameters.h"
+
+const string AIParameters::DEFAULT_FILE = "ai_parameters.txt";
+
+bool AIParameters::load(string filename) {
+    ifstream parameterFile(filename);
+    if(!parameterFile) {
+        return false;
+    }
+
+    string line;
+    while(getline(parameterFile, line)) {
+        // Drop comments, and skip lines with nothing left on them
+        line = line.substr(0, line.find('#'));
+
+        stringstream parts(line);
+        string name;
+        int value;
+
+        if(!(parts >> name)) {
+            continue;
+        }
+
+        if(!(parts >> value)) {
+            cerr << filename << ": no value given for " << name << endl;
+            continue;
+        }
+
+        if(!set(name, value)) {
+            cerr << filename << ": unknown parameter " << name << endl;
+        }
+    }
+
+    return true;
+}
+
+bool AIParameters::set(string name, int value) {
+    if(name == "endgameThreshold") {
+        endgameThreshold = value;
+    } else if(name == "endgameSteps") {
+        endgameSteps = value;
+    } else if(name == "latticePruning") {
+        latticePruning = value;
+    } else if(name == "informationGain") {
+        informationGain = value;
+    } else if(name == "entropyCandidates") {
+        entropyCandidates = value;
+    } else {
+        return false;
+    }
+
+    return true;
+}
+
+bool AIParameters::save(string filename) const {
+    ofstream parameterFile(filename);
+    if(!parameterFile) {
+        return false;
+    }
+
+    parameterFile << "# IntelligentComputer parameters" << endl;
+    parameterFile << "endgameThreshold " << endgameThreshold << endl;
+    parameterFile << "endgameSteps " << endgameSteps << endl;
+    parameterFile << "latticePruning " << latticePruning << endl;
+    parameterFile << "informationGain " << informationGain << endl;
+    parameterFile << "entropyCandidates " << entropyCandidates << endl;
+
+    return (bool) parameterFile;
+}
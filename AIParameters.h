@@ -0,0 +1,42 @@
+/* AIParameters.h
+ *
+ * Author: Colin Siles
+ *
+ * The AIParameters struct collects the IntelligentComputer's tunable settings, so that they can be tuned by self-play
+ * (see autotune.cpp) and read back from a parameter file when the game starts
+*/
+
+#ifndef SFML_TEMPLATE_AIPARAMETERS_H
+#define SFML_TEMPLATE_AIPARAMETERS_H
+
+#include <string>
+
+using namespace std;
+
+struct AIParameters {
+    // Endgame solver: the number of configurations it kicks in at (0 is off), and the work it may do per move
+    int endgameThreshold = 32;
+    int endgameSteps = 3000;
+
+    // Whether to search only the parity lattice in search mode, and whether to target by information gain (and over
+    // how many of the likeliest squares) rather than by density alone. The lattice is off by default, since the density
+    // already favors the squares it would keep, and it hasn't measurably cut the shots to win
+    bool latticePruning = false;
+    bool informationGain = false;
+    int entropyCandidates = 4;
+
+    // Reads parameters from a file of "name value" lines ('#' starts a comment). Parameters missing from the file
+    // keep their current values. Returns false if the file can't be opened
+    bool load(string filename);
+
+    // Sets the parameter with the given name. Returns false if there's no such parameter
+    bool set(string name, int value);
+
+    // Writes every parameter to the file, in the format load reads. Returns false if the file can't be written
+    bool save(string filename) const;
+
+    // File the game loads its parameters from at startup
+    static const string DEFAULT_FILE;
+};
+
+#endif //SFML_TEMPLATE_AIPARAMETERS_H
@@ -0,0 +1,96 @@
+/* AsyncValue.h (includes both the header and the implementation, since this class is templated)
+ *
+ * Author: Colin Siles
+ *
+ * The AsyncValue class hands a value from one thread to a coroutine waiting for it. The coroutine co_awaits the
+ * AsyncValue, and is suspended (using no thread at all) until some other thread calls set. It's then resumed on the
+ * Scheduler, or on the setting thread if there's no scheduler. Once the value is taken, the AsyncValue can be reused
+*/
+
+#ifndef SFML_TEMPLATE_ASYNCVALUE_H
+#define SFML_TEMPLATE_ASYNCVALUE_H
+
+#include <coroutine>
+#include <mutex>
+#include <optional>
+
+#include "Scheduler.h"
+
+using namespace std;
+
+template<typename T>
+class AsyncValue {
+public:
+    AsyncValue(Scheduler *scheduler = nullptr) {
+        _scheduler = scheduler;
+    }
+
+    void setScheduler(Scheduler *scheduler) {
+        lock_guard<mutex> lock(_mutex);
+        _scheduler = scheduler;
+    }
+
+    // Provides the value, resuming the coroutine waiting for it if there is one. If a value is already waiting to be
+    // taken, it's replaced
+    void set(T value) {
+        coroutine_handle<> waiting;
+        Scheduler *scheduler;
+
+        {
+            lock_guard<mutex> lock(_mutex);
+            _value = move(value);
+
+            waiting = _waiting;
+            _waiting = nullptr;
+            scheduler = _scheduler;
+        }
+
+        if(waiting) {
+            if(scheduler) {
+                scheduler->schedule(waiting);
+            } else {
+                waiting.resume();
+            }
+        }
+    }
+
+    // True if a value has been set, and not taken yet
+    bool ready() {
+        lock_guard<mutex> lock(_mutex);
+        return _value.has_value();
+    }
+
+    // Awaiting takes the value, waiting for it to be set if it hasn't been yet. Only one coroutine can wait at a time
+    bool await_ready() {
+        return ready();
+    }
+
+    bool await_suspend(coroutine_handle<> handle) {
+        lock_guard<mutex> lock(_mutex);
+
+        // The value may have arrived since await_ready checked, in which case there's no need to suspend
+        if(_value.has_value()) {
+            return false;
+        }
+
+        _waiting = handle;
+        return true;
+    }
+
+    T await_resume() {
+        lock_guard<mutex> lock(_mutex);
+
+        T value = move(*_value);
+        _value.reset();
+
+        return value;
+    }
+
+private:
+    mutex _mutex;
+    optional<T> _value;
+    coroutine_handle<> _waiting;
+    Scheduler *_scheduler;
+};
+
+#endif //SFML_TEMPLATE_ASYNCVALUE_H
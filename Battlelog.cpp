@@ -7,6 +7,7 @@
 
 #include <iostream>
 #include <iomanip>
+#include <algorithm>
 
 #include "Battlelog.h"
 
@@ -14,6 +15,19 @@ Battlelog::Battlelog(string filename, string p1Name, string p2Name) {
     // Record the first player first
     _firstPlayer = true;
 
+    _names[0] = p1Name;
+    _names[1] = p2Name;
+
+    for(int i = 0; i < 2; i++) {
+        _thinkTotal[i] = 0;
+        _thinkLongest[i] = 0;
+    }
+
+    // Nothing to write to if there's no file, and writing to a stream that isn't open does nothing
+    if(filename.empty()) {
+        return;
+    }
+
     // Attempt to open the battlelog file
     _battlelogFile.open(filename);
     if(!_battlelogFile) {
@@ -26,7 +40,7 @@ Battlelog::Battlelog(string filename, string p1Name, string p2Name) {
     _writeName(p1Name);
     _writeName(p2Name);
 
-    _battlelogFile << "|" << endl;
+    _battlelogFile << "|\n";
     _writeSeparator();
 }
 
@@ -47,7 +61,7 @@ void Battlelog::recordMove(int xPos, int yPos, ShotOutcome outcome) {
 
     // End with a new line of the second player's move
     if(!_firstPlayer) {
-        _battlelogFile << endl;
+        _battlelogFile << "\n";
     }
 
     // Switch players to record the next player when the function is called again
@@ -59,13 +73,59 @@ void Battlelog::recordWinner(string name) {
     // If the first player just won (since the player was toggled when writing the move)
     // Create a blank spot for the second player to complete the table
     if(!_firstPlayer) {
-        _battlelogFile << setw(12) << setfill(' ') << "" << "|" << endl;
+        _skipMove();
     }
 
     // Write the winner to the file
     _writeSeparator();
-    _battlelogFile << endl;
-    _battlelogFile << name << " wins!" << endl;
+    _battlelogFile << "\n";
+    _battlelogFile << name << " wins!\n";
+}
+
+// Writes the think times to the file, below the winner
+void Battlelog::recordThinkTime(string name, double totalMilliseconds, double longestMilliseconds) {
+    _battlelogFile << name << " thought for " << fixed << setprecision(1) << totalMilliseconds << " ms (longest move "
+                   << longestMilliseconds << " ms)\n";
+}
+
+// Writes the events that make it into the battlelog
+void Battlelog::onEvent(const GameEvent &event) {
+    switch(event.type) {
+        case SHOT_OUTCOME:
+            // In salvo games a player fires many shots in a row, so the other player's side of those rows is blank
+            if(event.player == _firstPlayer) {
+                _skipMove();
+            }
+
+            recordMove(event.xPos, event.yPos, {event.hit, event.sunkenIndex});
+            break;
+
+        case MOVE_TIMED:
+            _thinkTotal[event.player] += event.milliseconds;
+            _thinkLongest[event.player] = max(_thinkLongest[event.player], event.milliseconds);
+            break;
+
+        case GAME_OVER:
+            // Games without a winner just stop
+            if(event.player < 0) {
+                break;
+            }
+
+            recordWinner(_names[event.player]);
+
+            for(int i = 0; i < 2; i++) {
+                recordThinkTime(_names[i], _thinkTotal[i], _thinkLongest[i]);
+            }
+            break;
+
+        default:
+            break;
+    }
+}
+
+// Lines are buffered, rather than written out one at a time with endl, until the event bus says to flush
+void Battlelog::flush() {
+    _battlelogFile.flush();
 }
 
 // Converts the horizontal position of a move made by a player to the corresponding character
@@ -89,7 +149,7 @@ string Battlelog::_getOutcomeString(ShotOutcome outcome) {
 
 // Write the Equal sign separator for the class
 void Battlelog::_writeSeparator() {
-    _battlelogFile << "|" << setw(25) << setfill('=') << "" << "|" << endl;
+    _battlelogFile << "|" << setw(25) << setfill('=') << "" << "|\n";
 }
 
 // Writes a name to the file, with proper padding
@@ -97,6 +157,21 @@ void Battlelog::_writeName(string name) {
     _battlelogFile << "| " << setw(10) << setfill(' ') << left << name << " ";
 }
 
+// Writes a blank spot in place of a move, for whichever player is next
+void Battlelog::_skipMove() {
+    if(_firstPlayer) {
+        _battlelogFile << "|";
+    }
+
+    _battlelogFile << setw(12) << setfill(' ') << "" << "|";
+
+    if(!_firstPlayer) {
+        _battlelogFile << "\n";
+    }
+
+    _firstPlayer = !_firstPlayer;
+}
+
 // Writes a move and its corresponding outcome tp the file, using other helper functions
 void Battlelog::_writeMove(int xPos, int yPos, ShotOutcome outcome) {
     _battlelogFile << " " << setw(5) << setfill(' ') << left << (_convertYPos(yPos) + to_string(_convertXPos(xPos)));
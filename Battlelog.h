@@ -2,7 +2,8 @@
  *
  * Author: Colin Siles
  *
- * The Battlelog class writes the moves made by the players to a file for review later
+ * The Battlelog class writes the moves made by the players to a file for review later. It's handed the game's events
+ * by the game itself, or listens for them on an event bus
 */
 
 #ifndef SFML_TEMPLATE_BATTLELOG_H
@@ -12,11 +13,13 @@
 #include <fstream>
 
 #include "Board.h"
+#include "GameEventSubscriber.h"
 
 using namespace std;
 
-class Battlelog {
+class Battlelog : public GameEventSubscriber {
 public:
+    // An empty filename turns the battlelog off (e.g. for the many games run on a Scheduler)
     Battlelog(string filename, string p1Name, string p2Name);
     ~Battlelog(); // Destructor, for closing the file that is written to
 
@@ -24,7 +27,22 @@ public:
     void recordMove(int xPos, int yPos, ShotOutcome outcome);
     void recordWinner(string name);
 
+    // Writes how long a player spent choosing their moves, in total and on their longest move (in milliseconds)
+    // Called after the winner is recorded
+    void recordThinkTime(string name, double totalMilliseconds, double longestMilliseconds);
+
+    // Records the outcome of every shot, and the winner along with the think times at the end of the game
+    void onEvent(const GameEvent &event) override;
+    void flush() override;
+
 private:
+    // The names of the players, for writing the winner
+    string _names[2];
+
+    // How long each player spent thinking in total, and on their longest move (in milliseconds)
+    double _thinkTotal[2];
+    double _thinkLongest[2];
+
     // File object
     ofstream _battlelogFile;
 
@@ -35,6 +53,7 @@ private:
     void _writeSeparator();
     void _writeName(string name);
     void _writeMove(int xPos, int yPos, ShotOutcome outcome);
+    void _skipMove();
 
     // Helper functions for getting strings to be written to the file
     static char _convertYPos(int yPos);
@@ -0,0 +1,100 @@
+/* BattlelogReader.cpp
+ *
+ * Author: Colin Siles
+ *
+ * The BattlelogReader class parses the table written by the Battlelog class back into a GameRecord, so that old games
+ * can be analyzed or learned from
+*/
+
+#include <fstream>
+#include <sstream>
+
+#include "BattlelogReader.h"
+
+bool BattlelogReader::read(string filename, GameRecord &record) {
+    ifstream battlelogFile(filename);
+    if(!battlelogFile) {
+        return false;
+    }
+
+    record.playerNames.clear();
+    record.shipLengths.clear();
+    record.moves.clear();
+    record.seed = 0;
+    record.winner = -1;
+
+    string line;
+    int separators = 0;
+
+    while(getline(battlelogFile, line)) {
+        // The table is broken up by separator lines: after them come the names, then the moves, then the winner
+        if(line.find("|==") == 0) {
+            separators++;
+            continue;
+        }
+
+        // Header row, with the players' names
+        if(separators == 1) {
+            stringstream row(line);
+            string cell;
+
+            getline(row, cell, '|'); // Nothing before the first bar
+            while(getline(row, cell, '|')) {
+                record.playerNames.push_back(_trim(cell));
+            }
+
+        // Rows of moves, with the first player's move on the left and the second player's on the right
+        } else if(separators == 2) {
+            stringstream row(line);
+            string cell;
+
+            getline(row, cell, '|');
+            for(int player = 0; player < 2 && getline(row, cell, '|'); player++) {
+                RecordedMove move;
+
+                if(_parseMove(cell, player, move)) {
+                    record.moves.push_back(move);
+                }
+            }
+
+        // The winner is written after the table as "<name> wins!"
+        } else if(separators >= 3 && line.size() > 6 && line.substr(line.size() - 6) == " wins!") {
+            string winner = line.substr(0, line.size() - 6);
+
+            for(int i = 0; i < record.playerNames.size(); i++) {
+                if(record.playerNames.at(i) == winner) {
+                    record.winner = i;
+                }
+            }
+        }
+    }
+
+    return record.playerNames.size() == 2;
+}
+
+string BattlelogReader::_trim(string text) {
+    int start = text.find_first_not_of(' ');
+    int end = text.find_last_not_of(' ');
+
+    return start < 0 ? "" : text.substr(start, end - start + 1);
+}
+
+// Parses a cell like "B7    MISS": the letter is the y position, the number is the x position (counting from 1)
+bool BattlelogReader::_parseMove(string cell, int player, RecordedMove &move) {
+    stringstream parts(cell);
+    string position;
+    string outcome;
+
+    if(!(parts >> position >> outcome) || position.size() < 2) {
+        return false;
+    }
+
+    move.player = player;
+    move.yPos = position.at(0) - 'A';
+    move.xPos = atoi(position.substr(1).c_str()) - 1;
+    move.hit = outcome != "MISS";
+    move.sunk = outcome == "SUNK";
+    move.sunkenIndex = -1;
+
+    return true;
+}
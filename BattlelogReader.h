@@ -0,0 +1,29 @@
+/* BattlelogReader.h
+ *
+ * Author: Colin Siles
+ *
+ * The BattlelogReader class parses the table written by the Battlelog class back into a GameRecord, so that old games
+ * can be analyzed or learned from
+*/
+
+#ifndef SFML_TEMPLATE_BATTLELOGREADER_H
+#define SFML_TEMPLATE_BATTLELOGREADER_H
+
+#include <string>
+
+#include "GameRecord.h"
+
+using namespace std;
+
+class BattlelogReader {
+public:
+    // Reads the battlelog in the given file. Returns false if the file can't be opened or isn't a battlelog
+    static bool read(string filename, GameRecord &record);
+
+private:
+    // Helper functions for pulling apart the table
+    static string _trim(string text);
+    static bool _parseMove(string cell, int player, RecordedMove &move);
+};
+
+#endif //SFML_TEMPLATE_BATTLELOGREADER_H
@@ -0,0 +1,222 @@
+/* BinaryBattlelogReader.cpp
+ *
+ * Author: Colin Siles
+ *
+ * The BinaryBattlelogReader class reads the games in a binary battlelog (see BinaryBattlelogWriter.h for the layout).
+ * The file is memory mapped, and games are read straight out of it without copying anything
+*/
+
+#include <cstring>
+#include <iostream>
+
+#include "BinaryBattlelogReader.h"
+#include "BinaryBattlelogWriter.h"
+
+// Offsets of the fields in a game's header
+static const int BOARD_SIZE_OFFSET = 2;
+static const int NUM_SHIPS_OFFSET = 3;
+static const int WINNER_OFFSET = 4;
+static const int NAME_LENGTHS_OFFSET = 5;
+static const int SEED_OFFSET = 7;
+static const int NUM_MOVES_OFFSET = 15;
+
+// Helper functions for reading little-endian numbers
+static uint16_t get16(const uint8_t *bytes) {
+    return bytes[0] | (bytes[1] << 8);
+}
+
+static uint32_t get32(const uint8_t *bytes) {
+    return bytes[0] | (bytes[1] << 8) | (bytes[2] << 16) | ((uint32_t) bytes[3] << 24);
+}
+
+static uint64_t get64(const uint8_t *bytes) {
+    return get32(bytes) | ((uint64_t) get32(bytes + 4) << 32);
+}
+
+int BinaryGameView::getBoardSize() const {
+    return _record[BOARD_SIZE_OFFSET];
+}
+
+int BinaryGameView::getNumShips() const {
+    return _record[NUM_SHIPS_OFFSET];
+}
+
+int BinaryGameView::getShipLength(int index) const {
+    return _record[BinaryBattlelogWriter::GAME_HEADER_SIZE + index];
+}
+
+int BinaryGameView::getWinner() const {
+    int winner = _record[WINNER_OFFSET];
+    return winner == BinaryBattlelogWriter::NO_WINNER ? -1 : winner;
+}
+
+uint64_t BinaryGameView::getSeed() const {
+    return get64(_record + SEED_OFFSET);
+}
+
+int BinaryGameView::getNumMoves() const {
+    return get16(_record + NUM_MOVES_OFFSET);
+}
+
+// The names come right after the ship lengths
+string_view BinaryGameView::getPlayerName(int player) const {
+    const uint8_t *name = _record + BinaryBattlelogWriter::GAME_HEADER_SIZE + getNumShips();
+    if(player == 1) {
+        name += _record[NAME_LENGTHS_OFFSET];
+    }
+
+    return string_view((const char *) name, _record[NAME_LENGTHS_OFFSET + player]);
+}
+
+bool BinaryGameView::nextMove(RecordedMove &move) {
+    if(_nextMove >= _end) {
+        return false;
+    }
+
+    int boardSize = _boardSize;
+    uint8_t code = *_nextMove++;
+
+    move.player = _moveIndex % 2;
+    _moveIndex++;
+
+    // Sinking shots have the ship first, then the cell
+    if(code >= BinaryBattlelogWriter::SUNK_CODE) {
+        if(_nextMove >= _end) {
+            return false;
+        }
+
+        int ship = code - BinaryBattlelogWriter::SUNK_CODE;
+        int cell = *_nextMove++;
+
+        move.xPos = cell / boardSize;
+        move.yPos = cell % boardSize;
+        move.hit = true;
+        move.sunk = true;
+        move.sunkenIndex = ship == BinaryBattlelogWriter::UNKNOWN_SHIP ? -1 : ship;
+
+        return true;
+    }
+
+    int cell = code & ~BinaryBattlelogWriter::HIT_BIT;
+
+    move.xPos = cell / boardSize;
+    move.yPos = cell % boardSize;
+    move.hit = code & BinaryBattlelogWriter::HIT_BIT;
+    move.sunk = false;
+    move.sunkenIndex = -1;
+
+    return true;
+}
+
+void BinaryGameView::rewindMoves() {
+    _nextMove = _moves;
+    _moveIndex = 0;
+}
+
+void BinaryGameView::toRecord(GameRecord &record) const {
+    record.playerNames = {string(getPlayerName(0)), string(getPlayerName(1))};
+    record.shipLengths.clear();
+    record.moves.clear();
+    record.seed = getSeed();
+    record.winner = getWinner();
+
+    for(int i = 0; i < getNumShips(); i++) {
+        record.shipLengths.push_back(getShipLength(i));
+    }
+
+    // Decode from a copy of the view, so this one's place in the moves isn't lost
+    BinaryGameView moves = *this;
+    moves.rewindMoves();
+
+    RecordedMove move;
+    record.moves.reserve(getNumMoves());
+    while(moves.nextMove(move)) {
+        record.moves.push_back(move);
+    }
+}
+
+BinaryBattlelogReader::BinaryBattlelogReader() {
+    _data = nullptr;
+    _size = 0;
+    _position = 0;
+    _chunkEnd = 0;
+}
+
+bool BinaryBattlelogReader::open(string filename) {
+    _data = nullptr;
+
+    if(!_file.openReadOnly(filename)) {
+        return false;
+    }
+
+    const uint8_t *data = (const uint8_t *) _file.data();
+
+    if(_file.size() < BinaryBattlelogWriter::FILE_HEADER_SIZE || memcmp(data, "BSBL", 4) != 0 ||
+       get16(data + 4) != BinaryBattlelogWriter::VERSION) {
+        cerr << filename << " isn't a binary battlelog" << endl;
+        _file.close();
+        return false;
+    }
+
+    _data = data;
+    _size = _file.size();
+    rewind();
+
+    return true;
+}
+
+bool BinaryBattlelogReader::next(BinaryGameView &game) {
+    if(!_data) {
+        return false;
+    }
+
+    // Move on to the next chunk (skipping any empty ones), as long as it's all there
+    while(_position >= _chunkEnd) {
+        if(_position + BinaryBattlelogWriter::CHUNK_HEADER_SIZE > _size) {
+            return false;
+        }
+
+        size_t chunkBytes = get32(_data + _position + 4);
+        _position += BinaryBattlelogWriter::CHUNK_HEADER_SIZE;
+
+        if(_position + chunkBytes > _size) {
+            cerr << "Skipping a chunk that was cut short" << endl;
+            _position = _size;
+            return false;
+        }
+
+        _chunkEnd = _position + chunkBytes;
+    }
+
+    const uint8_t *record = _data + _position;
+    size_t recordBytes = _position + BinaryBattlelogWriter::GAME_HEADER_SIZE <= _chunkEnd ? get16(record) : 0;
+
+    // Everything before the moves has to fit in the record, and the record in its chunk
+    size_t movesOffset = recordBytes < BinaryBattlelogWriter::GAME_HEADER_SIZE ? 0 :
+            BinaryBattlelogWriter::GAME_HEADER_SIZE + record[NUM_SHIPS_OFFSET] + record[NAME_LENGTHS_OFFSET] +
+            record[NAME_LENGTHS_OFFSET + 1];
+
+    int boardSize = movesOffset == 0 ? 0 : record[BOARD_SIZE_OFFSET];
+
+    if(movesOffset == 0 || movesOffset > recordBytes || _position + recordBytes > _chunkEnd || boardSize == 0 ||
+       boardSize * boardSize > BinaryBattlelogWriter::MAX_CELLS) {
+        cerr << "Stopping at a damaged game" << endl;
+        _position = _size;
+        _chunkEnd = _size;
+        return false;
+    }
+
+    game._record = record;
+    game._moves = record + movesOffset;
+    game._end = record + recordBytes;
+    game._boardSize = boardSize;
+    game.rewindMoves();
+
+    _position += recordBytes;
+    return true;
+}
+
+void BinaryBattlelogReader::rewind() {
+    _position = BinaryBattlelogWriter::FILE_HEADER_SIZE;
+    _chunkEnd = _position;
+}
@@ -0,0 +1,76 @@
+/* BinaryBattlelogReader.h
+ *
+ * Author: Colin Siles
+ *
+ * The BinaryBattlelogReader class reads the games in a binary battlelog (see BinaryBattlelogWriter.h for the layout).
+ * The file is memory mapped, and games are read straight out of it without copying anything, so going through
+ * millions of games only takes a second or so. Chunks cut short by a crash while they were written are skipped
+*/
+
+#ifndef SFML_TEMPLATE_BINARYBATTLELOGREADER_H
+#define SFML_TEMPLATE_BINARYBATTLELOGREADER_H
+
+#include <cstdint>
+#include <string>
+#include <string_view>
+
+#include "GameRecord.h"
+#include "MappedFile.h"
+
+using namespace std;
+
+// A game in a binary battlelog, pointing into the mapped file. Only valid while the reader that filled it in is open
+class BinaryGameView {
+public:
+    int getBoardSize() const;
+    int getNumShips() const;
+    int getShipLength(int index) const;
+    int getWinner() const; // Index of the player that won, or -1 if the game didn't finish
+    uint64_t getSeed() const;
+    int getNumMoves() const;
+    string_view getPlayerName(int player) const;
+
+    // Decodes the game's moves one at a time, from the first. Returns false once there are no more
+    bool nextMove(RecordedMove &move);
+    void rewindMoves();
+
+    // Copies the whole game out, for code that works with GameRecords
+    void toRecord(GameRecord &record) const;
+
+private:
+    friend class BinaryBattlelogReader;
+
+    const uint8_t *_record;
+    const uint8_t *_moves;
+    const uint8_t *_end;
+    int _boardSize;
+
+    // Where the next move is, and whose it is
+    const uint8_t *_nextMove;
+    int _moveIndex;
+};
+
+class BinaryBattlelogReader {
+public:
+    BinaryBattlelogReader();
+
+    // Maps the file. Returns false if it can't be opened, or isn't a binary battlelog
+    bool open(string filename);
+
+    // Points the view at the next game. Returns false at the end of the file
+    bool next(BinaryGameView &game);
+
+    // Goes back to the first game
+    void rewind();
+
+private:
+    MappedFile _file;
+    const uint8_t *_data;
+    size_t _size;
+
+    // Where the next game is, and where the chunk it's in ends
+    size_t _position;
+    size_t _chunkEnd;
+};
+
+#endif //SFML_TEMPLATE_BINARYBATTLELOGREADER_H
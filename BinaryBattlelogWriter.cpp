@@ -0,0 +1,202 @@
+/* BinaryBattlelogWriter.cpp
+ *
+ * Author: Colin Siles
+ *
+ * The BinaryBattlelogWriter class appends games to a compact binary battlelog (see BinaryBattlelogWriter.h for the
+ * layout). It's a GameEventSubscriber, so one writer can record every game on a bus
+*/
+
+#include <algorithm>
+#include <cerrno>
+#include <cstring>
+#include <iostream>
+
+#include <fcntl.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include "Board.h"
+#include "BinaryBattlelogWriter.h"
+
+// Helper functions for writing little-endian numbers
+static void put16(string &bytes, uint16_t value) {
+    bytes += (char) (value & 0xFF);
+    bytes += (char) (value >> 8);
+}
+
+static void put32(string &bytes, uint32_t value) {
+    for(int i = 0; i < 4; i++) {
+        bytes += (char) ((value >> (8 * i)) & 0xFF);
+    }
+}
+
+static void put64(string &bytes, uint64_t value) {
+    for(int i = 0; i < 8; i++) {
+        bytes += (char) ((value >> (8 * i)) & 0xFF);
+    }
+}
+
+BinaryBattlelogWriter::BinaryBattlelogWriter(string filename, vector<int> shipLengths) {
+    _shipLengths = shipLengths;
+    _chunkGames = 0;
+
+    // Appending, so that many writers (even in other processes) can share a file, a chunk at a time
+    _fileDescriptor = open(filename.c_str(), O_WRONLY | O_CREAT | O_APPEND | O_CLOEXEC, 0644);
+    if(_fileDescriptor < 0) {
+        cerr << "Failed to open " << filename << endl;
+        return;
+    }
+
+    // New files start with the header
+    struct stat info;
+    if(fstat(_fileDescriptor, &info) == 0 && info.st_size == 0) {
+        string header = "BSBL";
+        put16(header, VERSION);
+        put16(header, 0);
+
+        if(write(_fileDescriptor, header.data(), header.size()) != header.size()) {
+            cerr << "Failed to write to " << filename << endl;
+        }
+    }
+}
+
+BinaryBattlelogWriter::~BinaryBattlelogWriter() {
+    flush();
+
+    if(_fileDescriptor >= 0) {
+        close(_fileDescriptor);
+    }
+}
+
+bool BinaryBattlelogWriter::isOpen() {
+    return _fileDescriptor >= 0;
+}
+
+void BinaryBattlelogWriter::append(const GameRecord &record) {
+    string game;
+    game.reserve(GAME_HEADER_SIZE + 64 + record.moves.size() + 8);
+
+    // Names are cut off at 255 bytes, to fit their lengths in a byte
+    string names[2];
+    for(int i = 0; i < 2; i++) {
+        names[i] = record.playerNames.size() > i ? record.playerNames.at(i).substr(0, 255) : "";
+    }
+
+    int numShips = min((int) record.shipLengths.size(), MAX_SHIPS);
+
+    put16(game, 0); // The record's size, filled in at the end
+    game += (char) Board::GRID_SIZE;
+    game += (char) numShips;
+    game += (char) (record.winner >= 0 ? record.winner : NO_WINNER);
+    game += (char) names[0].size();
+    game += (char) names[1].size();
+    put64(game, record.seed);
+    put16(game, record.moves.size());
+
+    for(int i = 0; i < numShips; i++) {
+        game += (char) record.shipLengths.at(i);
+    }
+
+    game += names[0];
+    game += names[1];
+
+    for(int i = 0; i < record.moves.size(); i++) {
+        const RecordedMove &move = record.moves.at(i);
+        uint8_t cell = move.xPos * Board::GRID_SIZE + move.yPos;
+
+        if(move.sunk) {
+            int ship = move.sunkenIndex >= 0 && move.sunkenIndex < MAX_SHIPS ? move.sunkenIndex : UNKNOWN_SHIP;
+            game += (char) (SUNK_CODE + ship);
+            game += (char) cell;
+        } else {
+            game += (char) (move.hit ? cell | HIT_BIT : cell);
+        }
+    }
+
+    game[0] = (char) (game.size() & 0xFF);
+    game[1] = (char) (game.size() >> 8);
+
+    lock_guard<mutex> lock(_mutex);
+
+    _chunk += game;
+    _chunkGames++;
+
+    if(_chunk.size() >= CHUNK_BYTES) {
+        _writeChunk();
+    }
+}
+
+void BinaryBattlelogWriter::flush() {
+    lock_guard<mutex> lock(_mutex);
+    _writeChunk();
+}
+
+void BinaryBattlelogWriter::onEvent(const GameEvent &event) {
+    switch(event.type) {
+        case GAME_STARTED: {
+            GameRecord &record = _playing[event.gameId];
+
+            for(int i = 0; i < 2; i++) {
+                record.playerNames.push_back(string(event.playerNames[i],
+                                                    strnlen(event.playerNames[i], GameEvent::NAME_LENGTH)));
+            }
+
+            record.shipLengths = _shipLengths;
+            record.seed = event.seed;
+            record.winner = -1;
+            break;
+        }
+
+        case SHOT_OUTCOME:
+            _playing[event.gameId].moves.push_back({event.player, event.xPos, event.yPos, event.hit,
+                                                    event.sunkenIndex >= 0, event.sunkenIndex});
+            break;
+
+        // Games without a winner are still recorded, as far as they got
+        case GAME_OVER: {
+            auto found = _playing.find(event.gameId);
+
+            if(found != _playing.end()) {
+                found->second.winner = event.player;
+                append(found->second);
+                _playing.erase(found);
+            }
+            break;
+        }
+
+        default:
+            break;
+    }
+}
+
+// Writes the chunk in one go, so that a chunk from another writer can't end up in the middle of it
+void BinaryBattlelogWriter::_writeChunk() {
+    if(_chunkGames == 0 || _fileDescriptor < 0) {
+        return;
+    }
+
+    string chunk;
+    chunk.reserve(CHUNK_HEADER_SIZE + _chunk.size());
+    put32(chunk, _chunkGames);
+    put32(chunk, _chunk.size());
+    chunk += _chunk;
+
+    int written = 0;
+    while(written < chunk.size()) {
+        ssize_t result = write(_fileDescriptor, chunk.data() + written, chunk.size() - written);
+
+        if(result < 0 && errno == EINTR) {
+            continue;
+        }
+
+        if(result <= 0) {
+            cerr << "Failed to write a chunk of the battlelog" << endl;
+            break;
+        }
+
+        written += result;
+    }
+
+    _chunk.clear();
+    _chunkGames = 0;
+}
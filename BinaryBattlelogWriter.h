@@ -0,0 +1,87 @@
+/* BinaryBattlelogWriter.h
+ *
+ * Author: Colin Siles
+ *
+ * The BinaryBattlelogWriter class appends games to a compact binary battlelog, which takes a few percent of the space
+ * of the text one, and can be read back by the BinaryBattlelogReader millions of games a second. It's a
+ * GameEventSubscriber, so one writer can record every game on a bus, and games can also be added directly from
+ * GameRecords (e.g. converted from text battlelogs)
+ *
+ * Numbers are stored little-endian, and nothing is aligned:
+ *
+ * File:   "BSBL", u16 version, u16 unused, then any number of chunks. Files are only ever appended to
+ * Chunk:  u32 number of games, u32 number of bytes in the games, then the games. A chunk is written all at once, so a
+ *         chunk cut short (by a crash mid-write) can only be the last one, and is skipped by the reader
+ * Game:   u16 bytes in the whole record, u8 board size, u8 number of ships, u8 winner (0xFF for none),
+ *         u8 name lengths[2], u64 seed, u16 number of moves, u8 ship lengths[], the names, then the moves
+ * Move:   The players take turns, starting with the first, so the player isn't stored. Each move is one byte, with the
+ *         cell (xPos * board size + yPos) in the low 7 bits, and the top bit set for a hit. A shot that sinks a ship
+ *         is two bytes: SUNK_CODE plus the index of the ship sunk (which can't be a cell), then the cell. Records that
+ *         don't say which ship was sunk (like text battlelogs) use UNKNOWN_SHIP for the index
+*/
+
+#ifndef SFML_TEMPLATE_BINARYBATTLELOGWRITER_H
+#define SFML_TEMPLATE_BINARYBATTLELOGWRITER_H
+
+#include <cstdint>
+#include <map>
+#include <mutex>
+#include <string>
+#include <vector>
+
+#include "GameEventSubscriber.h"
+#include "GameRecord.h"
+
+using namespace std;
+
+class BinaryBattlelogWriter : public GameEventSubscriber {
+public:
+    // Appends to the given file (creating it if needed). Games recorded from events are played with the given fleet
+    BinaryBattlelogWriter(string filename, vector<int> shipLengths = {5, 4, 4, 3, 2});
+    ~BinaryBattlelogWriter() override; // Destructor, which writes the last chunk
+
+    bool isOpen();
+
+    // Adds a finished game. Games are written a chunk at a time
+    void append(const GameRecord &record);
+
+    // Writes the games added so far, as a chunk (as well as whenever a chunk fills up)
+    void flush() override;
+
+    // Builds up each game on the bus from its events, and appends it when it's over
+    void onEvent(const GameEvent &event) override;
+
+    // Layout constants, shared with the BinaryBattlelogReader
+    static constexpr uint16_t VERSION = 1;
+    static constexpr int FILE_HEADER_SIZE = 8;
+    static constexpr int CHUNK_HEADER_SIZE = 8;
+    static constexpr int GAME_HEADER_SIZE = 17;
+
+    static constexpr int MAX_CELLS = 100;             // Cells have to fit in the low 7 bits, below the sinking codes
+    static constexpr uint8_t HIT_BIT = 0x80;
+    static constexpr uint8_t SUNK_CODE = 0x80 | MAX_CELLS;
+    static constexpr int MAX_SHIPS = 0x80 - MAX_CELLS - 1;
+    static constexpr int UNKNOWN_SHIP = MAX_SHIPS;    // Sinking index for a ship the record didn't say
+    static constexpr uint8_t NO_WINNER = 0xFF;
+
+    // Chunks are written once they have this many bytes of games
+    static constexpr int CHUNK_BYTES = 1 << 16;
+
+private:
+    int _fileDescriptor;
+    vector<int> _shipLengths;
+
+    // Games waiting to be written, in one chunk
+    string _chunk;
+    int _chunkGames;
+
+    // Games being played, by their ids on the bus
+    map<uint64_t, GameRecord> _playing;
+
+    // Games can be appended from any thread
+    mutex _mutex;
+
+    void _writeChunk();
+};
+
+#endif //SFML_TEMPLATE_BINARYBATTLELOGWRITER_H
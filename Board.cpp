@@ -7,7 +7,10 @@
  * to ensure that ships are placed only in valid locations, and guesses are also made in valid locations
 */
 
+#include <algorithm>
+
 #include "Board.h"
+#include "PlacementTable.h"
 
 // Function similar to "make_pair" that allows for quickly returning a ShotOutcome object
 ShotOutcome makeOutcome(bool hit, int sunkenIndex) {
@@ -45,6 +48,37 @@ ShotOutcome Board::fireShotAt(int xPos, int yPos) {
     return makeOutcome(hit, sunkIndex);
 }
 
+void Board::fireShotsAt(const vector<pair<int, int>> &shots, vector<ShotOutcome> &outcomes) {
+    CellMask shotCells;
+    int shotAt[NUM_CELLS];
+
+    outcomes.resize(shots.size());
+    fill(shotAt, shotAt + NUM_CELLS, -1);
+
+    for(int i = 0; i < shots.size(); i++) {
+        shotCells.set(cellIndex(shots[i].first, shots[i].second));
+    }
+
+    CellMask hits = shotCells & _shipCells;
+
+    for(int i = 0; i < shots.size(); i++) {
+        int cell = cellIndex(shots[i].first, shots[i].second);
+        bool hit = hits.test(cell);
+
+        _grid.at(shots[i].first).at(shots[i].second) = hit ? HIT_MARKER : MISS_MARKER;
+        outcomes[i] = makeOutcome(hit, -1);
+
+        if(hit) {
+            shotAt[cell] = i;
+        }
+    }
+
+    // A salvo of misses doesn't need the fleet at all
+    if(hits.any()) {
+        _fleet->markShipsHit(shotAt, outcomes.data());
+    }
+}
+
 // Returns true if the provided ship fits at its location in this board
 bool Board::shipFits(Ship ship) {
     // Exit early if the ship's position is negative (likely because it hasn't been assigned a position yet)
@@ -78,6 +112,7 @@ void Board::placeShip(Ship &ship) {
 
         // Mark the grid as having a square at the location
         _grid.at(squarePos.first).at(squarePos.second) = SHIP;
+        _shipCells.set(cellIndex(squarePos.first, squarePos.second));
     }
 
     // Mark the ship as placed
@@ -103,7 +138,21 @@ bool Board::validGuess(int xPos, int yPos) {
     return _posInsideGrid(xPos, yPos) && _grid.at(xPos).at(yPos) == BLANK;
 }
 
+void Board::setAimed(int xPos, int yPos, bool aimed) {
+    if(_posInsideGrid(xPos, yPos) && _grid.at(xPos).at(yPos) == (aimed ? BLANK : AIMED_MARKER)) {
+        _grid.at(xPos).at(yPos) = aimed ? AIMED_MARKER : BLANK;
+    }
+}
+
 // Return true if the position is inside the grid (e.g. not a negative coordinate, or too large)
 bool Board::_posInsideGrid(int xPos, int yPos){
     return xPos >=0 && xPos < GRID_SIZE && yPos >= 0 && yPos < GRID_SIZE;
 }
+
+void Board::clear() {
+    for(int i = 0; i < GRID_SIZE; i++) {
+        fill(_grid.at(i).begin(), _grid.at(i).end(), BLANK);
+    }
+
+    _shipCells.reset();
+}
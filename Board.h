@@ -10,6 +10,7 @@
 #ifndef SFML_TEMPLATE_BOARD_H
 #define SFML_TEMPLATE_BOARD_H
 
+#include <bitset>
 #include <vector>
 
 #include "Ship.h"
@@ -31,6 +32,12 @@ public:
     // Returns the outcome based on a shot
     ShotOutcome fireShotAt(int xPos, int yPos);
 
+    // Resolves a whole salvo of shots (for the salvo variant) at once: the shots are gathered into a mask and checked
+    // against the squares the ships are on, then the fleet is marked for all the hits together (see
+    // Fleet::markShipsHit). The outcome of each shot is written into outcomes, which is resized to fit, so a buffer
+    // kept from salvo to salvo doesn't allocate
+    void fireShotsAt(const vector<pair<int, int>> &shots, vector<ShotOutcome> &outcomes);
+
     // Returns true if the provided ship fits at its location in this board
     bool shipFits(Ship ship);
 
@@ -44,11 +51,17 @@ public:
     // Returns true if guess is valid (in grid and not already guessed) called by tracking grids, primarily
     bool validGuess(int xPos, int yPos);
 
+    // Marks (or unmarks) a square of a tracking board as aimed at by the salvo being chosen, so it isn't a valid guess
+    void setAimed(int xPos, int yPos, bool aimed);
+
+    // Empties the whole grid again, for a new game
+    void clear();
+
     // Determines the size of a board
     static const int GRID_SIZE = 10; // In theory, this could be changed to be a parameter, although renderer class probably couldnt handle that easily
 
     // These are the values that fill up the board
-    enum SquareState {BLANK, SHIP, HIT_MARKER, MISS_MARKER};
+    enum SquareState {BLANK, SHIP, HIT_MARKER, MISS_MARKER, AIMED_MARKER};
 
     // Marked as friend classes, since they benefit from access to the class's internal data structure
     // (Adding more public functions would just add a lot of extra code)
@@ -62,6 +75,9 @@ private:
     // The 2D vector that stores the state of all the objects in the grid
     vector<vector<SquareState>> _grid; // We intialize this in the constructor
 
+    // The squares the ships were placed on, as a CellMask (see PlacementTable.h)
+    bitset<GRID_SIZE * GRID_SIZE> _shipCells;
+
     // Checks that a shot is within the bounds of the board
     bool _posInsideGrid(int xPos, int yPos);
 };
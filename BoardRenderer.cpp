@@ -8,9 +8,11 @@
 */
 
 #include "BoardRenderer.h"
+#include "VertexShapes.h"
 
 // Primary constructor
-BoardRenderer::BoardRenderer(RenderWindow &window, Board &board, double dispX, double dispY, string label) {
+BoardRenderer::BoardRenderer(RenderWindow &window, Board &board, double dispX, double dispY, string label)
+        : _gridLines(Triangles), _squares(Triangles) {
     // Store pointer to the necessary objects
     _window = &window;
     _board = &board;
@@ -25,55 +27,36 @@ BoardRenderer::BoardRenderer(RenderWindow &window, Board &board, double dispX, d
     if(!_font.loadFromFile("data/arial.ttf")) {
         cerr << "Error loading font" << endl;
     }
-}
 
-// Draws the board, with its label onto an SFML Window object
-void BoardRenderer::draw() {
-    // Iterate over the 2D array of the board
-    for(int i = 0; i < Board::GRID_SIZE; i++) {
-        for(int j = 0; j < Board::GRID_SIZE; j++) {
-            // Get the value of the given square
-            Board::SquareState value = _board->_grid.at(i).at(j);
+    // The label for the board (communicates whose board it is)
+    _labelText.setFont(_font);
+    _labelText.setString(_label);
+    _labelText.setFillColor(Color::White);
+    _labelText.setPosition(_dispX, _dispY + 25 + 50 * (Board::GRID_SIZE));
 
-            Color color;
-
-            // The square's background color is blue if blank or a miss
-            if (value == Board::BLANK || value == Board::MISS_MARKER) {
-                color = Color::Blue;
+    // Each square used to be drawn with a 2 pixel outline, each one drawn over the last, which left a line just
+    // before the start of each square, and one just past the end of the last
+    float size = 50 * Board::GRID_SIZE;
 
-            // The square's background color is grey if a hit or a ship
-            } else {
-                color = Color(120, 120, 120);
-            }
+    for(int i = 0; i <= Board::GRID_SIZE; i++) {
+        float offset = i < Board::GRID_SIZE ? 50 * i - 2 : size;
 
-            // Draws the square onto the window, the the correct color
-            RectangleShape square(Vector2f(50, 50));
-            square.setPosition(_dispX + 50 * i, _dispY + 50 * j);
-            square.setFillColor(color);
-            square.setOutlineColor(Color::Black);
-            square.setOutlineThickness(2);
-            _window->draw(square);
-
-            // If the square is a miss or a hit, draw a marker to display that
-            if (value == Board::MISS_MARKER || value == Board::HIT_MARKER) {
-                CircleShape marker(20, 20);
-                marker.setPosition(_dispX + 5 + 50 * i, _dispY + 5 + 50 * j);
-
-                // Color Determined by whether it was a hit or a miss
-                marker.setFillColor(value == Board::MISS_MARKER ? Color::White : Color::Red);
-                _window->draw(marker);
-            }
-        }
+        addRectangle(_gridLines, _dispX + offset, _dispY - 2, 2, size + 4, Color::Black);
+        addRectangle(_gridLines, _dispX - 2, _dispY + offset, size + 4, 2, Color::Black);
     }
 
-    // Draw the label for the board (communicates whose board it is)
-    Text boardLabel;
-    boardLabel.setFont(_font);
-    boardLabel.setString(_label);
-    boardLabel.setFillColor(Color::White);
-    boardLabel.setPosition(_dispX, _dispY + 25 + 50 * (Board::GRID_SIZE));
+    // Drawing with some alpha makes the sqaure partially transparent
+    _statusSquare.setSize(Vector2f(50, 50));
+    _statusSquare.setFillColor(Color(255, 255, 255, 100));
+}
+
+// Draws the board, with its label onto an SFML Window object
+void BoardRenderer::draw() {
+    _updateSquares();
 
-    _window->draw(boardLabel);
+    _window->draw(_squares);
+    _window->draw(_gridLines);
+    _window->draw(_labelText);
 }
 
 // Draws a little white square to show which square the user is currently selecting
@@ -86,13 +69,8 @@ void BoardRenderer::drawStatusSquare(double mouseX, double mouseY) {
 
     // As long as the mouse is inside the grid, draw the status square
     if(xPos >=0 && xPos < 10 && yPos >=0 && yPos < 10) {
-        RectangleShape selectionSquare(Vector2f(50, 50));
-        selectionSquare.setPosition(xPos * 50 + _dispX, yPos * 50 + _dispY);
-
-        // Drawing with some alpha makes the sqaure partially transparent
-        selectionSquare.setFillColor(Color(255, 255, 255, 100));
-
-        _window->draw(selectionSquare);
+        _statusSquare.setPosition(xPos * 50 + _dispX, yPos * 50 + _dispY);
+        _window->draw(_statusSquare);
     }
 }
 
@@ -117,3 +95,55 @@ double BoardRenderer::getDispX() const {
 double BoardRenderer::getDispY() const {
     return _dispY;
 }
+
+// The squares are compared against the states they were built from every frame, which is far cheaper than building
+// them again
+void BoardRenderer::_updateSquares() {
+    bool changed = _drawnStates.size() != Board::GRID_SIZE * Board::GRID_SIZE;
+
+    for(int i = 0; i < Board::GRID_SIZE && !changed; i++) {
+        for(int j = 0; j < Board::GRID_SIZE && !changed; j++) {
+            changed = _board->_grid.at(i).at(j) != _drawnStates.at(i * Board::GRID_SIZE + j);
+        }
+    }
+
+    if(!changed) {
+        return;
+    }
+
+    _squares.clear();
+    _drawnStates.clear();
+
+    // Iterate over the 2D array of the board
+    for(int i = 0; i < Board::GRID_SIZE; i++) {
+        for(int j = 0; j < Board::GRID_SIZE; j++) {
+            // Get the value of the given square
+            Board::SquareState value = _board->_grid.at(i).at(j);
+            _drawnStates.push_back(value);
+
+            Color color;
+
+            // The square's background color is blue if blank, a miss, or aimed at by a salvo
+            if (value == Board::BLANK || value == Board::MISS_MARKER || value == Board::AIMED_MARKER) {
+                color = Color::Blue;
+
+            // The square's background color is grey if a hit or a ship
+            } else {
+                color = Color(120, 120, 120);
+            }
+
+            addRectangle(_squares, _dispX + 50 * i, _dispY + 50 * j, 50, 50, color);
+
+            // If the square is a miss or a hit, add a marker to display that, colored by whether it was a hit or a miss
+            if (value == Board::MISS_MARKER || value == Board::HIT_MARKER) {
+                addCircle(_squares, _dispX + 5 + 50 * i, _dispY + 5 + 50 * j, 20, 20,
+                          value == Board::MISS_MARKER ? Color::White : Color::Red);
+            }
+
+            // Squares aimed at by the salvo being chosen get a smaller marker, until the salvo is fired
+            if (value == Board::AIMED_MARKER) {
+                addCircle(_squares, _dispX + 15 + 50 * i, _dispY + 15 + 50 * j, 10, 20, Color::Yellow);
+            }
+        }
+    }
+}
@@ -5,6 +5,10 @@
  * The BoardRenderer class is responsible for displaying a board onto an SFML window
  * It essentially wraps a Board object, and tracking the x and y position in order to draw it
  * The class also provides public methods to get information about the grid position of the mouse
+ *
+ * Drawing is retained from frame to frame: the grid lines are built once, the squares (backgrounds and markers) are
+ * kept in a single VertexArray that's only rebuilt when a square of the board changes, and the label is set up once.
+ * A frame is three draw calls, however many squares have been fired at
 */
 
 #ifndef SFML_TEMPLATE_BOARDRENDERER_H
@@ -13,6 +17,8 @@
 #include <SFML/Graphics.hpp>
 using namespace sf;
 
+#include <vector>
+
 #include "Board.h"
 
 class BoardRenderer {
@@ -46,6 +52,19 @@ protected:
     // Other members for text
     Font _font;
     string _label;
+    Text _labelText;
+
+    // The black lines between the squares, which never change
+    VertexArray _gridLines;
+
+    // Each square's background and marker, and the state of the squares when they were built
+    VertexArray _squares;
+    vector<Board::SquareState> _drawnStates;
+
+    RectangleShape _statusSquare;
+
+    // Rebuilds the squares' vertices if any square has changed since they were built
+    void _updateSquares();
 };
 
 #endif //SFML_TEMPLATE_BOARDRENDERER_H
@@ -0,0 +1,20 @@
+/* CancellationToken.cpp
+ *
+ * Author: Colin Siles
+ *
+ * The CancellationToken class lets one thread ask work running on another to stop early (e.g. a game being shut
+ * down while a player is still thinking). Players see it through a Deadline, and check it as they work
+*/
+
+#include "CancellationToken.h"
+
+CancellationToken::CancellationToken() : _cancelled(false) {
+}
+
+void CancellationToken::cancel() {
+    _cancelled = true;
+}
+
+bool CancellationToken::isCancelled() const {
+    return _cancelled;
+}
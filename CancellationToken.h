@@ -0,0 +1,28 @@
+/* CancellationToken.h
+ *
+ * Author: Colin Siles
+ *
+ * The CancellationToken class lets one thread ask work running on another to stop early (e.g. a game being shut
+ * down while a player is still thinking). Players see it through a Deadline, and check it as they work
+*/
+
+#ifndef SFML_TEMPLATE_CANCELLATIONTOKEN_H
+#define SFML_TEMPLATE_CANCELLATIONTOKEN_H
+
+#include <atomic>
+
+using namespace std;
+
+class CancellationToken {
+public:
+    CancellationToken();
+
+    // Asks whoever is watching the token to stop. Safe to call from any thread
+    void cancel();
+    bool isCancelled() const;
+
+private:
+    atomic<bool> _cancelled;
+};
+
+#endif //SFML_TEMPLATE_CANCELLATIONTOKEN_H
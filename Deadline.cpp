@@ -0,0 +1,41 @@
+/* Deadline.cpp
+ *
+ * Author: Colin Siles
+ *
+ * The Deadline class tells a player how long it has to choose a move. It expires at a point in time, or as soon as
+ * its cancellation token is cancelled, whichever comes first. A default constructed deadline never expires
+*/
+
+#include <algorithm>
+
+#include "Deadline.h"
+
+Deadline::Deadline() {
+    _time = chrono::steady_clock::time_point::max();
+    _token = nullptr;
+}
+
+Deadline::Deadline(chrono::steady_clock::time_point time, const CancellationToken *token) {
+    _time = time;
+    _token = token;
+}
+
+Deadline Deadline::after(double milliseconds, const CancellationToken *token) {
+    return Deadline(chrono::steady_clock::now() + chrono::microseconds((long) (milliseconds * 1000)), token);
+}
+
+bool Deadline::expired() const {
+    return (_token && _token->isCancelled()) || chrono::steady_clock::now() >= _time;
+}
+
+double Deadline::remaining() const {
+    if(_token && _token->isCancelled()) {
+        return 0;
+    }
+
+    return max(0.0, chrono::duration<double, milli>(_time - chrono::steady_clock::now()).count());
+}
+
+chrono::steady_clock::time_point Deadline::getTime() const {
+    return _time;
+}
@@ -0,0 +1,39 @@
+/* Deadline.h
+ *
+ * Author: Colin Siles
+ *
+ * The Deadline class tells a player how long it has to choose a move. It expires at a point in time, or as soon as
+ * its cancellation token is cancelled, whichever comes first. A default constructed deadline never expires
+*/
+
+#ifndef SFML_TEMPLATE_DEADLINE_H
+#define SFML_TEMPLATE_DEADLINE_H
+
+#include <chrono>
+
+#include "CancellationToken.h"
+
+using namespace std;
+
+class Deadline {
+public:
+    Deadline();
+    Deadline(chrono::steady_clock::time_point time, const CancellationToken *token = nullptr);
+
+    // A deadline the given number of milliseconds from now
+    static Deadline after(double milliseconds, const CancellationToken *token = nullptr);
+
+    // True once the time has passed, or the token was cancelled
+    bool expired() const;
+
+    // Milliseconds left until the deadline (0 once it has expired)
+    double remaining() const;
+
+    chrono::steady_clock::time_point getTime() const;
+
+private:
+    chrono::steady_clock::time_point _time;
+    const CancellationToken *_token;
+};
+
+#endif //SFML_TEMPLATE_DEADLINE_H
@@ -0,0 +1,397 @@
+/* EndgameSolver.cpp
+ *
+ * Author: Colin Siles
+ *
+ * The EndgameSolver class plays out the end of a game exactly. Once only a handful of fleet configurations are still
+ * consistent with the tracking board, it enumerates all of them and searches for the order of shots that minimizes the
+ * expected number of shots needed to sink every remaining ship. States are bitmasks of the configurations that are
+ * still possible (plus the cells hit so far), values are cached in a bounded memo table, and branches that can't beat
+ * the best move found so far are cut off early
+*/
+
+#include <algorithm>
+#include <functional>
+#include <limits>
+
+#include "EndgameSolver.h"
+
+// Configurations are stored as bits in a 64 bit integer, so that's the most the solver can handle
+static const int MAX_SUPPORTED_CONFIGURATIONS = 64;
+
+EndgameSolver::EndgameSolver(int maxConfigurations, int maxMemoEntries, int maxSteps) {
+    setMaxConfigurations(maxConfigurations);
+    _maxMemoEntries = maxMemoEntries;
+    _maxSteps = maxSteps;
+
+    _steps = 0;
+    _outOfBudget = false;
+    _deadline = nullptr;
+}
+
+void EndgameSolver::setMaxConfigurations(int maxConfigurations) {
+    _maxConfigurations = max(0, min(maxConfigurations, MAX_SUPPORTED_CONFIGURATIONS));
+}
+
+int EndgameSolver::getMaxConfigurations() const {
+    return _maxConfigurations;
+}
+
+void EndgameSolver::setMaxSteps(int maxSteps) {
+    _maxSteps = max(1, maxSteps);
+}
+
+void EndgameSolver::setDeadline(const Deadline *deadline) {
+    _deadline = deadline;
+}
+
+// Reading the clock costs more than a step, so the deadline is only checked every 64 steps
+bool EndgameSolver::_overBudget() {
+    _steps++;
+
+    return _steps > _maxSteps || (_deadline && _steps % 64 == 0 && _deadline->expired());
+}
+
+int EndgameSolver::numConfigurations() const {
+    return _configCells.size();
+}
+
+bool EndgameSolver::enumerate(const CellMask &blocked, const CellMask &hits, const CellMask &required,
+        const vector<int> &shipLengths) {
+    _blocked = blocked;
+    _hits = hits;
+    _required = required;
+    _shipLengths = shipLengths;
+
+    _configCells.clear();
+    _shipCells.clear();
+    _shipAt.clear();
+
+    // Nothing to do if the solver is turned off
+    if(_maxConfigurations == 0 || shipLengths.empty()) {
+        return false;
+    }
+
+    // Filter out the placements that hit a blocked cell, or that only cover hits (that ship would have been sunk)
+    _fittingPlacements.resize(shipLengths.size());
+
+    for(int i = 0; i < shipLengths.size(); i++) {
+        const vector<Placement> &placements = PlacementTable::forLength(shipLengths.at(i)).placements();
+
+        _fittingPlacements.at(i).clear();
+
+        for(int j = 0; j < placements.size(); j++) {
+            const CellMask &mask = placements.at(j).mask;
+
+            if((mask & blocked).none() && (mask & ~hits).any()) {
+                _fittingPlacements.at(i).push_back(j);
+            }
+        }
+    }
+
+    // The enumeration has a budget too, so that it can't run away in the early game
+    _steps = 0;
+
+    vector<int> chosen;
+    return _enumerate(0, CellMask(), chosen);
+}
+
+bool EndgameSolver::_enumerate(int depth, CellMask occupied, vector<int> &chosen) {
+    // All the ships have been placed. Keep the configuration if it explains every required hit
+    if(depth == _shipLengths.size()) {
+        if((_required & ~occupied).any()) {
+            return true;
+        }
+
+        // Too many configurations to solve exactly
+        if(_configCells.size() >= _maxConfigurations) {
+            return false;
+        }
+
+        _configCells.push_back(occupied);
+        _shipAt.insert(_shipAt.end(), NUM_CELLS, -1);
+
+        for(int i = 0; i < chosen.size(); i++) {
+            const Placement &placement = PlacementTable::forLength(_shipLengths.at(i)).placements().at(chosen.at(i));
+
+            _shipCells.push_back(placement.mask);
+
+            for(int j = 0; j < placement.cells.size(); j++) {
+                _shipAt.at((_configCells.size() - 1) * NUM_CELLS + placement.cells.at(j)) = i;
+            }
+        }
+
+        return true;
+    }
+
+    // Stop early if the remaining ships can't possibly cover all the required hits that haven't been explained yet
+    int remainingLength = 0;
+    for(int i = depth; i < _shipLengths.size(); i++) {
+        remainingLength += _shipLengths.at(i);
+    }
+
+    if((_required & ~occupied).count() > remainingLength) {
+        return true;
+    }
+
+    const vector<Placement> &placements = PlacementTable::forLength(_shipLengths.at(depth)).placements();
+    const vector<int> &fitting = _fittingPlacements.at(depth);
+
+    for(int i = 0; i < fitting.size(); i++) {
+        // Give up if this is taking too long; there are almost certainly too many configurations
+        if(_overBudget()) {
+            return false;
+        }
+
+        const CellMask &mask = placements.at(fitting.at(i)).mask;
+
+        // The ship can't overlap another ship in this configuration
+        if((mask & occupied).any()) {
+            continue;
+        }
+
+        chosen.push_back(fitting.at(i));
+        bool keepGoing = _enumerate(depth + 1, occupied | mask, chosen);
+        chosen.pop_back();
+
+        if(!keepGoing) {
+            return false;
+        }
+    }
+
+    return true;
+}
+
+int EndgameSolver::solve(double &expectedShots) {
+    uint64_t allConfigs = _configCells.size() == 64 ? ~0ULL : (1ULL << _configCells.size()) - 1;
+
+    // The memo table is only valid for this set of configurations, so start fresh
+    _memo.clear();
+    _steps = 0;
+    _outOfBudget = false;
+
+    int bestCell = -1;
+    expectedShots = _expected(allConfigs, _hits, numeric_limits<double>::infinity(), &bestCell);
+
+    // If the search ran out of time, the result can't be trusted, so fall back to the shot most likely to hit
+    if(_outOfBudget || bestCell < 0) {
+        bestCell = _mostLikelyCell(allConfigs, _hits);
+        expectedShots = _lowerBound(allConfigs, _hits);
+    }
+
+    return bestCell;
+}
+
+double EndgameSolver::_expected(uint64_t configs, const CellMask &hits, double alpha, int *bestCell) {
+    int numConfigs = _configCells.size();
+    int numShips = _shipLengths.size();
+
+    // Find the remaining cells (not hit yet) of each configuration, and every cell worth shooting at
+    int remaining[MAX_SUPPORTED_CONFIGURATIONS];
+    int totalConfigs = 0;
+    int lastConfig = 0;
+    CellMask candidates;
+
+    for(int i = 0; i < numConfigs; i++) {
+        if(configs >> i & 1) {
+            CellMask unhit = _configCells.at(i) & ~hits;
+
+            remaining[i] = unhit.count();
+            candidates |= unhit;
+
+            totalConfigs++;
+            lastConfig = i;
+        }
+    }
+
+    // With only one configuration left, we know exactly where the ships are: just shoot the rest of them
+    if(totalConfigs == 1) {
+        if(bestCell) {
+            *bestCell = _mostLikelyCell(configs, hits);
+        }
+
+        return remaining[lastConfig];
+    }
+
+    // Once the budget is spent, every state just reports its lower bound, which lets the search unwind quickly
+    if(_outOfBudget || _overBudget()) {
+        _outOfBudget = true;
+        return _lowerBound(configs, hits);
+    }
+
+    MemoKey key = {configs, hits};
+
+    // The best move isn't stored in the memo table, so the top level of the search always has to be expanded
+    if(!bestCell) {
+        auto cached = _memo.find(key);
+
+        if(cached != _memo.end()) {
+            return cached->second;
+        }
+    }
+
+    // Order the candidate shots by how many configurations they hit, since those tend to be the best moves
+    // That way good moves are found first, and more of the remaining ones can be cut off
+    pair<int, int> order[NUM_CELLS];
+    int numCandidates = 0;
+
+    for(int c = 0; c < NUM_CELLS; c++) {
+        if(!candidates.test(c)) {
+            continue;
+        }
+
+        int hitCount = 0;
+        for(int i = 0; i < numConfigs; i++) {
+            if((configs >> i & 1) && _shipAt[i * NUM_CELLS + c] >= 0) {
+                hitCount++;
+            }
+        }
+
+        order[numCandidates++] = make_pair(-hitCount, c);
+    }
+
+    sort(order, order + numCandidates);
+
+    // Outcomes are grouped as: miss, hit, sunk (one per ship), and game over
+    int numOutcomes = numShips + 3;
+    int gameoverOutcome = numShips + 2;
+
+    vector<uint64_t> groups(numOutcomes);
+    vector<double> groupBounds(numOutcomes);
+
+    double best = alpha;
+
+    for(int n = 0; n < numCandidates; n++) {
+        int c = order[n].second;
+
+        CellMask hitsAfterShot = hits;
+        hitsAfterShot.set(c);
+
+        fill(groups.begin(), groups.end(), 0);
+        fill(groupBounds.begin(), groupBounds.end(), 0.0);
+
+        // Split the configurations by the outcome the shot would have in each of them
+        for(int i = 0; i < numConfigs; i++) {
+            if(!(configs >> i & 1)) {
+                continue;
+            }
+
+            int outcome = 0;
+            int ship = _shipAt[i * NUM_CELLS + c];
+
+            if(ship >= 0) {
+                outcome = 1;
+
+                // The game is over if that was the last cell, otherwise check if the ship that was hit sank
+                if(remaining[i] == 1) {
+                    outcome = gameoverOutcome;
+                } else if((_shipCells[i * numShips + ship] & ~hitsAfterShot).none()) {
+                    outcome = 2 + ship;
+                }
+            }
+
+            groups[outcome] |= 1ULL << i;
+            groupBounds[outcome] += remaining[i] - (outcome != 0);
+        }
+
+        // Skip the shot if even the optimistic estimate can't beat the best move so far
+        double bound = 1;
+        for(int g = 0; g < numOutcomes; g++) {
+            groupBounds[g] /= totalConfigs;
+            bound += groupBounds[g];
+        }
+
+        if(bound >= best) {
+            continue;
+        }
+
+        // Otherwise, work out each outcome exactly, abandoning the shot as soon as it can't win
+        double value = 1;
+        double remainingBound = bound - 1;
+        bool cutOff = false;
+
+        for(int g = 0; g < numOutcomes && !cutOff; g++) {
+            if(!groups[g]) {
+                continue;
+            }
+
+            remainingBound -= groupBounds[g];
+
+            // The game is over in these configurations, no more shots needed
+            if(g == gameoverOutcome) {
+                continue;
+            }
+
+            double weight = (double) bitset<64>(groups[g]).count() / totalConfigs;
+            double childAlpha = (best - value - remainingBound) / weight;
+
+            value += weight * _expected(groups[g], g == 0 ? hits : hitsAfterShot, childAlpha, nullptr);
+
+            if(value + remainingBound >= best) {
+                cutOff = true;
+            }
+        }
+
+        if(!cutOff && value < best) {
+            best = value;
+
+            if(bestCell) {
+                *bestCell = c;
+            }
+        }
+    }
+
+    // Only exact values can be cached (a value at or above alpha only tells us no move was better than alpha)
+    if(best < alpha && !_outOfBudget && _memo.size() < _maxMemoEntries) {
+        _memo.emplace(key, best);
+    }
+
+    return best;
+}
+
+double EndgameSolver::_lowerBound(uint64_t configs, const CellMask &hits) {
+    double total = 0;
+    int totalConfigs = 0;
+
+    for(int i = 0; i < _configCells.size(); i++) {
+        if(configs >> i & 1) {
+            total += (_configCells[i] & ~hits).count();
+            totalConfigs++;
+        }
+    }
+
+    return totalConfigs > 0 ? total / totalConfigs : 0;
+}
+
+int EndgameSolver::_mostLikelyCell(uint64_t configs, const CellMask &hits) {
+    int bestCell = -1;
+    int bestCount = 0;
+
+    for(int c = 0; c < NUM_CELLS; c++) {
+        if(hits.test(c)) {
+            continue;
+        }
+
+        int count = 0;
+        for(int i = 0; i < _configCells.size(); i++) {
+            if((configs >> i & 1) && _configCells[i].test(c)) {
+                count++;
+            }
+        }
+
+        if(count > bestCount) {
+            bestCount = count;
+            bestCell = c;
+        }
+    }
+
+    return bestCell;
+}
+
+// The memo key is compared and hashed by both of its fields
+bool EndgameSolver::MemoKey::operator==(const MemoKey &other) const {
+    return configs == other.configs && hits == other.hits;
+}
+
+size_t EndgameSolver::MemoKeyHash::operator()(const MemoKey &key) const {
+    return hash<uint64_t>()(key.configs) * 31 + hash<CellMask>()(key.hits);
+}
@@ -0,0 +1,108 @@
+/* EndgameSolver.h
+ *
+ * Author: Colin Siles
+ *
+ * The EndgameSolver class plays out the end of a game exactly. Once only a handful of fleet configurations are still
+ * consistent with the tracking board, it enumerates all of them and searches for the order of shots that minimizes the
+ * expected number of shots needed to sink every remaining ship. States are bitmasks of the configurations that are
+ * still possible (plus the cells hit so far), values are cached in a bounded memo table, and branches that can't beat
+ * the best move found so far are cut off early
+*/
+
+#ifndef SFML_TEMPLATE_ENDGAMESOLVER_H
+#define SFML_TEMPLATE_ENDGAMESOLVER_H
+
+#include <cstdint>
+#include <unordered_map>
+#include <vector>
+
+#include "Deadline.h"
+#include "PlacementTable.h"
+
+using namespace std;
+
+class EndgameSolver {
+public:
+    EndgameSolver(int maxConfigurations = 32, int maxMemoEntries = 1 << 14, int maxSteps = 3000);
+
+    // The solver only kicks in at or below this many consistent configurations (at most 64, 0 turns the solver off)
+    void setMaxConfigurations(int maxConfigurations);
+    int getMaxConfigurations() const;
+
+    // Limit on the work done for a single move, after which the solver gives up and plays the most likely cell
+    void setMaxSteps(int maxSteps);
+
+    // The solver also gives up once this deadline expires (nullptr for no deadline). The deadline has to outlive
+    // any calls to enumerate and solve made while it's set
+    void setDeadline(const Deadline *deadline);
+
+    // Finds every configuration of the unsunk ships that avoids the blocked cells (misses and sunk ships) and covers
+    // all of the required hits (hits that can't belong to a sunken ship). Returns false if there are too many
+    // configurations to solve exactly
+    bool enumerate(const CellMask &blocked, const CellMask &hits, const CellMask &required, const vector<int> &shipLengths);
+
+    // Number of configurations found by the last call to enumerate
+    int numConfigurations() const;
+
+    // Returns the cell index of the shot that minimizes the expected number of remaining shots, and stores that
+    // expectation. Only valid after enumerate succeeded with at least one configuration
+    int solve(double &expectedShots);
+
+private:
+    // Key for the memo table: which configurations are still possible, and which of their cells have been hit
+    struct MemoKey {
+        uint64_t configs;
+        CellMask hits;
+
+        bool operator==(const MemoKey &other) const;
+    };
+
+    struct MemoKeyHash {
+        size_t operator()(const MemoKey &key) const;
+    };
+
+    // Limits that keep the solve fast, and its memory bounded
+    int _maxConfigurations;
+    int _maxMemoEntries;
+    int _maxSteps; // Placements tried while enumerating, or states expanded while searching
+
+    // The ships still afloat, and the state of the board the configurations were enumerated from
+    vector<int> _shipLengths;
+    CellMask _blocked;
+    CellMask _hits;
+    CellMask _required;
+
+    // The placements of each ship that avoid the blocked cells, filtered once before enumerating
+    vector<vector<int>> _fittingPlacements;
+
+    // Each configuration as a whole, the cells of each of its ships (numShips masks per configuration), and which of
+    // its ships sits on each cell (NUM_CELLS entries per configuration, -1 for water)
+    vector<CellMask> _configCells;
+    vector<CellMask> _shipCells;
+    vector<signed char> _shipAt;
+
+    // Counters for how much work the enumeration or the search has done, so both can bail out early
+    int _steps;
+    bool _outOfBudget;
+    const Deadline *_deadline;
+
+    // Counts a step, and returns true if the step budget is spent or the deadline has expired
+    bool _overBudget();
+
+    unordered_map<MemoKey, double, MemoKeyHash> _memo;
+
+    // Recursive helper for enumerate, places the ship at the given depth in every position that fits
+    bool _enumerate(int depth, CellMask occupied, vector<int> &chosen);
+
+    // Expected number of shots to finish the game from the given state. Returns a value of at least alpha if no move
+    // can do better than alpha. If bestCell isn't null, it is set to the best shot found
+    double _expected(uint64_t configs, const CellMask &hits, double alpha, int *bestCell);
+
+    // A lower bound on the expected number of shots: every configuration needs at least one shot per unhit cell
+    double _lowerBound(uint64_t configs, const CellMask &hits);
+
+    // The shot most likely to be a hit across the given configurations (used to order moves, and as a fallback)
+    int _mostLikelyCell(uint64_t configs, const CellMask &hits);
+};
+
+#endif //SFML_TEMPLATE_ENDGAMESOLVER_H
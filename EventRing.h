@@ -0,0 +1,135 @@
+/* EventRing.h (includes both the header and the implementation, since this class is templated)
+ *
+ * Author: Colin Siles
+ *
+ * The EventRing class is a fixed size, lock-free queue, used to pass game events from the threads running games to
+ * the threads of the subscribers consuming them. Any number of threads can push and pop at once. Each slot carries a
+ * sequence number saying whether it's ready to be written or read, so pushing and popping only take a compare and
+ * swap on the position, and never a lock (this is Dmitry Vyukov's bounded queue)
+*/
+
+#ifndef SFML_TEMPLATE_EVENTRING_H
+#define SFML_TEMPLATE_EVENTRING_H
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+
+using namespace std;
+
+template<typename T>
+class EventRing {
+public:
+    // The capacity is rounded up to a power of two
+    EventRing(size_t capacity);
+
+    // Adds an item, returning false (without blocking) if the ring is full
+    bool tryPush(const T &item);
+
+    // Takes the oldest item, returning false (without blocking) if the ring is empty
+    bool tryPop(T &item);
+
+    size_t capacity() const;
+
+private:
+    struct Slot {
+        atomic<size_t> sequence;
+        T item;
+    };
+
+    unique_ptr<Slot[]> _slots;
+    size_t _mask;
+
+    // Kept on separate cache lines, so the pushing and popping threads don't slow each other down
+    alignas(64) atomic<size_t> _pushPosition;
+    alignas(64) atomic<size_t> _popPosition;
+};
+
+template<typename T>
+EventRing<T>::EventRing(size_t capacity) {
+    size_t size = 2;
+    while(size < capacity) {
+        size *= 2;
+    }
+
+    _slots.reset(new Slot[size]);
+    _mask = size - 1;
+
+    // A slot is ready to be written at position i when its sequence is i, and ready to be read when it's i + 1
+    for(size_t i = 0; i < size; i++) {
+        _slots[i].sequence.store(i, memory_order_relaxed);
+    }
+
+    _pushPosition.store(0, memory_order_relaxed);
+    _popPosition.store(0, memory_order_relaxed);
+}
+
+template<typename T>
+bool EventRing<T>::tryPush(const T &item) {
+    size_t position = _pushPosition.load(memory_order_relaxed);
+    Slot *slot;
+
+    while(true) {
+        slot = &_slots[position & _mask];
+        intptr_t difference = (intptr_t) slot->sequence.load(memory_order_acquire) - (intptr_t) position;
+
+        // The slot is free: claim it by moving the position on (or try again if another thread got there first)
+        if(difference == 0) {
+            if(_pushPosition.compare_exchange_weak(position, position + 1, memory_order_relaxed)) {
+                break;
+            }
+
+        // The slot still holds an item from a lap ago, so the ring is full
+        } else if(difference < 0) {
+            return false;
+
+        // Another thread already claimed it
+        } else {
+            position = _pushPosition.load(memory_order_relaxed);
+        }
+    }
+
+    slot->item = item;
+    slot->sequence.store(position + 1, memory_order_release);
+
+    return true;
+}
+
+template<typename T>
+bool EventRing<T>::tryPop(T &item) {
+    size_t position = _popPosition.load(memory_order_relaxed);
+    Slot *slot;
+
+    while(true) {
+        slot = &_slots[position & _mask];
+        intptr_t difference = (intptr_t) slot->sequence.load(memory_order_acquire) - (intptr_t) (position + 1);
+
+        if(difference == 0) {
+            if(_popPosition.compare_exchange_weak(position, position + 1, memory_order_relaxed)) {
+                break;
+            }
+
+        // Nothing has been written to the slot yet, so the ring is empty
+        } else if(difference < 0) {
+            return false;
+
+        } else {
+            position = _popPosition.load(memory_order_relaxed);
+        }
+    }
+
+    item = slot->item;
+
+    // Free the slot for the push one lap later
+    slot->sequence.store(position + _mask + 1, memory_order_release);
+
+    return true;
+}
+
+template<typename T>
+size_t EventRing<T>::capacity() const {
+    return _mask + 1;
+}
+
+#endif //SFML_TEMPLATE_EVENTRING_H
@@ -0,0 +1,404 @@
+/* ExternalEnginePlayer.cpp
+ *
+ * Author: Colin Siles
+ *
+ * The ExternalEnginePlayer class is a Player subclass whose decisions are made by another program (an "engine"),
+ * started as a child process and spoken to over its stdin and stdout. See ExternalEnginePlayer.h for the protocol
+*/
+
+#include <algorithm>
+#include <cerrno>
+#include <chrono>
+#include <csignal>
+#include <iostream>
+#include <sstream>
+#include <thread>
+
+#include <fcntl.h>
+#include <poll.h>
+#include <spawn.h>
+#include <sys/wait.h>
+#include <unistd.h>
+
+#include "ExternalEnginePlayer.h"
+
+extern char **environ;
+
+// How long the engine gets to exit after being told to quit, before it's killed
+static const int QUIT_MILLISECONDS = 200;
+
+// Longest wait for the engine's answer between checks of the deadline
+static const int POLL_MILLISECONDS = 10;
+
+ExternalEnginePlayer::ExternalEnginePlayer(string name, vector<int> shipLengths, string command) :
+        Player(name, shipLengths) {
+    _pid = -1;
+    _toEngine = -1;
+    _fromEngine = -1;
+    _staleReplies = 0;
+    _running = false;
+    _requests = 0;
+    _roundTripTotal = 0;
+
+    _start(command);
+
+    // The engine gets the ship lengths along with the first request
+    string lengths = "ships";
+    for(int i = 0; i < shipLengths.size(); i++) {
+        lengths += " " + to_string(shipLengths.at(i));
+    }
+
+    _send(lengths);
+}
+
+ExternalEnginePlayer::~ExternalEnginePlayer() {
+    if(_running) {
+        _send("quit");
+        _flush();
+    }
+
+    if(_toEngine >= 0) {
+        close(_toEngine);
+    }
+
+    if(_fromEngine >= 0) {
+        close(_fromEngine);
+    }
+
+    if(_pid <= 0) {
+        return;
+    }
+
+    // Give the engine a moment to exit by itself, then make sure it does
+    chrono::steady_clock::time_point giveUp = chrono::steady_clock::now() + chrono::milliseconds(QUIT_MILLISECONDS);
+
+    while(waitpid(_pid, nullptr, WNOHANG) == 0) {
+        if(chrono::steady_clock::now() >= giveUp) {
+            kill(_pid, SIGKILL);
+            waitpid(_pid, nullptr, 0);
+            break;
+        }
+
+        this_thread::sleep_for(chrono::microseconds(100));
+    }
+}
+
+bool ExternalEnginePlayer::isRunning() {
+    return _running;
+}
+
+pair<int, int> ExternalEnginePlayer::getMove() {
+    return getMove(Deadline());
+}
+
+pair<int, int> ExternalEnginePlayer::getMove(const Deadline &deadline) {
+    // Only tell the engine how long it has if there's a limit
+    string request = "move";
+    if(deadline.getTime() != chrono::steady_clock::time_point::max()) {
+        request += " " + to_string((long) deadline.remaining());
+    }
+
+    string reply;
+    if(!_request(request, reply, deadline)) {
+        return make_pair(-1, -1);
+    }
+
+    stringstream words(reply);
+    string word;
+    int xPos;
+    int yPos;
+
+    if(!(words >> word >> xPos >> yPos) || word != "shot") {
+        cerr << _name << " sent \"" << reply << "\" instead of a shot" << endl;
+        return make_pair(-1, -1);
+    }
+
+    // A shot off the board, or at a square fired at already, can't be made, so the engine forfeits
+    if(!_trackingBoard.validGuess(xPos, yPos)) {
+        cerr << _name << " sent \"" << reply << "\", which isn't a square it can fire at" << endl;
+        return make_pair(-1, -1);
+    }
+
+    return make_pair(xPos, yPos);
+}
+
+// Ships the engine doesn't place properly are left unplaced, so the game ends before it starts
+void ExternalEnginePlayer::placeShips() {
+    string reply;
+    if(!_request("place", reply, Deadline())) {
+        return;
+    }
+
+    stringstream words(reply);
+    string word;
+    words >> word;
+
+    if(word != "placement") {
+        cerr << _name << " sent \"" << reply << "\" instead of a placement" << endl;
+        return;
+    }
+
+    for(int i = 0; i < _primaryFleet.size(); i++) {
+        int xPos;
+        int yPos;
+        string orientation;
+
+        if(!(words >> xPos >> yPos >> orientation) || (orientation != "h" && orientation != "v")) {
+            cerr << _name << " didn't place all of its ships" << endl;
+            return;
+        }
+
+        // Ships start out horizontal, so only vertical ones need a rotation
+        _primaryFleet.ship(i).setHorizontal();
+        if(orientation == "v") {
+            _primaryFleet.ship(i).rotate();
+        }
+
+        _primaryFleet.ship(i).setGridPos(xPos, yPos);
+
+        if(!_primaryBoard.shipFits(_primaryFleet.ship(i))) {
+            cerr << _name << " placed a ship where it doesn't fit" << endl;
+            return;
+        }
+
+        _primaryBoard.placeShip(_primaryFleet.ship(i));
+    }
+}
+
+void ExternalEnginePlayer::reportGameover(bool winner) {
+    _send(string("gameover ") + (winner ? "win" : "loss"));
+    _flush();
+}
+
+ShotOutcome ExternalEnginePlayer::fireShotAt(int xPos, int yPos) {
+    ShotOutcome outcome = Player::fireShotAt(xPos, yPos);
+    _send("incoming " + to_string(xPos) + " " + to_string(yPos) + " " + _outcomeString(outcome));
+
+    return outcome;
+}
+
+void ExternalEnginePlayer::fireShotsAt(const vector<pair<int, int>> &shots, vector<ShotOutcome> &outcomes) {
+    Player::fireShotsAt(shots, outcomes);
+
+    for(int i = 0; i < shots.size(); i++) {
+        _send("incoming " + to_string(shots.at(i).first) + " " + to_string(shots.at(i).second) + " " +
+              _outcomeString(outcomes.at(i)));
+    }
+}
+
+void ExternalEnginePlayer::markShot(int xPos, int yPos, ShotOutcome outcome) {
+    Player::markShot(xPos, yPos, outcome);
+    _send("outcome " + to_string(xPos) + " " + to_string(yPos) + " " + _outcomeString(outcome));
+}
+
+void ExternalEnginePlayer::reportOpponent(string name) {
+    Player::reportOpponent(name);
+    _send("opponent " + name);
+}
+
+void ExternalEnginePlayer::resetState() {
+    Player::resetState();
+    _send("newgame");
+}
+
+long ExternalEnginePlayer::getRequests() {
+    return _requests;
+}
+
+double ExternalEnginePlayer::getAverageRoundTrip() {
+    return _requests > 0 ? _roundTripTotal / _requests : 0;
+}
+
+// Runs the command with pipes in place of its stdin and stdout (its stderr is left as ours, for its error messages)
+void ExternalEnginePlayer::_start(string command) {
+    // Close-on-exec, so engines started from other threads don't hold on to each other's pipes
+    int toEngine[2];
+    int fromEngine[2];
+
+    if(pipe2(toEngine, O_CLOEXEC) != 0) {
+        cerr << "Failed to create a pipe for " << _name << endl;
+        return;
+    }
+
+    if(pipe2(fromEngine, O_CLOEXEC) != 0) {
+        cerr << "Failed to create a pipe for " << _name << endl;
+        close(toEngine[0]);
+        close(toEngine[1]);
+        return;
+    }
+
+    // dup2 clears close-on-exec on the copies, so the engine keeps its stdin and stdout
+    posix_spawn_file_actions_t actions;
+    posix_spawn_file_actions_init(&actions);
+    posix_spawn_file_actions_adddup2(&actions, toEngine[0], STDIN_FILENO);
+    posix_spawn_file_actions_adddup2(&actions, fromEngine[1], STDOUT_FILENO);
+
+    const char *arguments[] = {"sh", "-c", command.c_str(), nullptr};
+    int error = posix_spawn(&_pid, "/bin/sh", &actions, nullptr, (char *const *) arguments, environ);
+
+    posix_spawn_file_actions_destroy(&actions);
+    close(toEngine[0]);
+    close(fromEngine[1]);
+
+    if(error != 0) {
+        cerr << "Failed to start " << command << " for " << _name << endl;
+        close(toEngine[1]);
+        close(fromEngine[0]);
+        _pid = -1;
+        return;
+    }
+
+    _toEngine = toEngine[1];
+    _fromEngine = fromEngine[0];
+    _running = true;
+}
+
+void ExternalEnginePlayer::_send(string line) {
+    _pending += line;
+    _pending += '\n';
+}
+
+// Writes everything waiting to be sent. Writing to an engine that has exited raises SIGPIPE, which would kill the whole
+// program, and a pipe can't be written with MSG_NOSIGNAL like a socket. So the signal is blocked on this thread while
+// writing, and one the write raised is taken back off the thread before it's unblocked (unless one was already waiting)
+bool ExternalEnginePlayer::_flush() {
+    if(!_running) {
+        _pending.clear();
+        return false;
+    }
+
+    sigset_t pipeSignal;
+    sigset_t oldMask;
+    sigset_t waiting;
+
+    sigemptyset(&pipeSignal);
+    sigaddset(&pipeSignal, SIGPIPE);
+    pthread_sigmask(SIG_BLOCK, &pipeSignal, &oldMask);
+
+    sigpending(&waiting);
+    bool alreadyWaiting = sigismember(&waiting, SIGPIPE);
+
+    int written = 0;
+    while(written < _pending.size()) {
+        ssize_t result = write(_toEngine, _pending.data() + written, _pending.size() - written);
+
+        if(result < 0 && errno == EINTR) {
+            continue;
+        }
+
+        if(result <= 0) {
+            if(result < 0 && errno == EPIPE && !alreadyWaiting) {
+                struct timespec noWait = {0, 0};
+                while(sigtimedwait(&pipeSignal, nullptr, &noWait) < 0 && errno == EINTR) {
+                }
+            }
+
+            cerr << _name << " stopped listening" << endl;
+            _running = false;
+            break;
+        }
+
+        written += result;
+    }
+
+    pthread_sigmask(SIG_SETMASK, &oldMask, nullptr);
+
+    _pending.clear();
+    return _running;
+}
+
+// Sends a request (with everything held back before it) and reads the answer to it
+bool ExternalEnginePlayer::_request(string line, string &reply, const Deadline &deadline) {
+    chrono::steady_clock::time_point start = chrono::steady_clock::now();
+
+    _send(line);
+    if(!_flush()) {
+        return false;
+    }
+
+    // Answers to requests that ran out of time come first
+    while(_staleReplies > 0) {
+        if(!_readLine(reply, deadline)) {
+            return false;
+        }
+
+        _staleReplies--;
+    }
+
+    if(!_readLine(reply, deadline)) {
+        // Out of time: the answer may still come, and will have to be skipped
+        if(_running) {
+            _staleReplies++;
+        }
+
+        return false;
+    }
+
+    _requests++;
+    _roundTripTotal += chrono::duration<double, milli>(chrono::steady_clock::now() - start).count();
+
+    return true;
+}
+
+// Reads the next line that isn't info from the engine, waiting no later than the deadline for it
+bool ExternalEnginePlayer::_readLine(string &line, const Deadline &deadline) {
+    while(_running) {
+        int newline = _readBuffer.find('\n');
+
+        if(newline >= 0) {
+            line = _readBuffer.substr(0, newline);
+            _readBuffer.erase(0, newline + 1);
+
+            if(line.compare(0, 4, "info") != 0) {
+                return true;
+            }
+
+            continue;
+        }
+
+        // Wait for more to read (poll's timeout is in whole milliseconds, so round up). Waits are kept short even
+        // without a time limit, so that a cancelled deadline is noticed
+        if(deadline.expired()) {
+            return false;
+        }
+
+        struct pollfd request = {_fromEngine, POLLIN, 0};
+        double remaining = deadline.remaining();
+        int timeout = remaining < POLL_MILLISECONDS ? (int) remaining + 1 : POLL_MILLISECONDS;
+
+        int ready = poll(&request, 1, timeout);
+
+        if(ready < 0 && errno == EINTR) {
+            continue;
+        }
+
+        if(ready == 0) {
+            continue;
+        }
+
+        char buffer[4096];
+        ssize_t result = read(_fromEngine, buffer, sizeof(buffer));
+
+        if(result < 0 && errno == EINTR) {
+            continue;
+        }
+
+        if(result <= 0) {
+            cerr << _name << " stopped answering" << endl;
+            _running = false;
+            break;
+        }
+
+        _readBuffer.append(buffer, result);
+    }
+
+    return false;
+}
+
+string ExternalEnginePlayer::_outcomeString(ShotOutcome outcome) {
+    if(outcome.sunkenIndex >= 0) {
+        return "sunk " + to_string(outcome.sunkenIndex);
+    }
+
+    return outcome.hit ? "hit" : "miss";
+}
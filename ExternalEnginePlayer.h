@@ -0,0 +1,94 @@
+/* ExternalEnginePlayer.h
+ *
+ * Author: Colin Siles
+ *
+ * The ExternalEnginePlayer class is a Player subclass whose decisions are made by another program (an "engine"). The
+ * engine is started as a child process, and the player talks to it over its stdin and stdout with a line protocol, a
+ * bit like UCI for chess engines. Coordinates are the same as the game's (0-9, xPos then yPos)
+ *
+ * Sent to the engine:
+ *   ships 5 4 4 3 2                  The lengths of the ships, in order (first thing sent)
+ *   opponent <name>                  Who the engine is playing
+ *   place                            Asks for the ships' positions
+ *   move [ms]                        Asks for a shot, to be sent within the given milliseconds (if there's a limit)
+ *   outcome <x> <y> miss|hit|sunk n  How the engine's last shot went (n is the index of the ship it sank)
+ *   incoming <x> <y> miss|hit|sunk n Where the opponent shot, and how it went
+ *   gameover win|loss
+ *   newgame                          Another game is starting, with the same ships and opponent
+ *   quit                             The engine should exit
+ *
+ * Sent back by the engine (one line for each place and move, lines starting with "info" are ignored):
+ *   placement <x> <y> h|v ...        The position and orientation of each ship, in order
+ *   shot <x> <y>
+ *
+ * Only place and move need an answer. Everything else is held back and written with the next request, so each move
+ * costs one write and one read, however many notifications go with it
+*/
+
+#ifndef SFML_TEMPLATE_EXTERNALENGINEPLAYER_H
+#define SFML_TEMPLATE_EXTERNALENGINEPLAYER_H
+
+#include <sys/types.h>
+
+#include "Player.h"
+
+class ExternalEnginePlayer : public Player {
+public:
+    // Starts the engine with the given command (run by /bin/sh, so it can have arguments)
+    ExternalEnginePlayer(string name, vector<int> shipLengths, string command);
+    ~ExternalEnginePlayer() override; // Destructor, which tells the engine to quit and waits for it
+
+    // False if the engine couldn't be started, or has stopped answering properly
+    bool isRunning();
+
+    // Waits for the engine's shot until the deadline. A late, missing or malformed shot is returned as (-1, -1)
+    using Player::getMove;
+    pair<int, int> getMove() override;
+    pair<int, int> getMove(const Deadline &deadline) override;
+
+    void placeShips() override;
+    void reportGameover(bool winner) override;
+
+    // Pass the shots on to the engine, along with doing what a Player normally does
+    ShotOutcome fireShotAt(int xPos, int yPos) override;
+    void fireShotsAt(const vector<pair<int, int>> &shots, vector<ShotOutcome> &outcomes) override;
+    void markShot(int xPos, int yPos, ShotOutcome outcome) override;
+    void reportOpponent(string name) override;
+
+    // Tells the engine to start over, too
+    void resetState() override;
+
+    // Number of requests (place and move) made, and the average time from sending one to reading its answer, in
+    // milliseconds. That includes the engine's thinking, so for a trivial engine it's the cost of the IPC itself
+    long getRequests();
+    double getAverageRoundTrip();
+
+private:
+    pid_t _pid;
+    int _toEngine;    // Write end of the engine's stdin
+    int _fromEngine;  // Read end of the engine's stdout
+
+    // Lines waiting to go out with the next request, and what's been read past the end of the last line
+    string _pending;
+    string _readBuffer;
+
+    // Answers still to come for requests that ran out of time, which have to be skipped
+    int _staleReplies;
+
+    bool _running;
+
+    long _requests;
+    double _roundTripTotal;
+
+    // Helper functions for talking to the engine
+    void _start(string command);
+    void _send(string line);
+    bool _flush();
+    bool _request(string line, string &reply, const Deadline &deadline);
+    bool _readLine(string &line, const Deadline &deadline);
+
+    // The protocol's word for a shot's outcome ("miss", "hit" or "sunk n")
+    static string _outcomeString(ShotOutcome outcome);
+};
+
+#endif //SFML_TEMPLATE_EXTERNALENGINEPLAYER_H
@@ -0,0 +1,129 @@
+/* FiringProfile.cpp
+ *
+ * Author: Colin Siles
+ *
+ * The FiringProfile class learns where a particular opponent tends to shoot. For every square it counts how often the
+ * opponent fired there in their opening shots, and how many shots it took them to get there on average. The
+ * IntelligentComputer uses that to hide its ships on the squares that opponent gets to last
+ *
+ * Like the PlacementPrior, the profile is a small memory mapped file, so loading and updating it is nearly free
+*/
+
+#include <cstring>
+
+#include "FiringProfile.h"
+
+// How many games' worth of "random firing" the learned counts are blended with, so that a couple of games can't
+// swing the scores too far
+static const double PSEUDO_GAMES = 5.0;
+
+FiringProfile::FiringProfile() {
+    _data = nullptr;
+}
+
+bool FiringProfile::open(string filename) {
+    close();
+
+    bool created;
+    if(!_file.open(filename, sizeof(FiringProfileData), created)) {
+        return false;
+    }
+
+    _data = (FiringProfileData *) _file.data();
+
+    // Start over if the file is new, or isn't a profile this version understands
+    _file.lock(true);
+    if(created || memcmp(_data->magic, "BSFP", 4) != 0 || _data->version != VERSION) {
+        _initialize();
+    }
+    _file.unlock();
+
+    return true;
+}
+
+void FiringProfile::close() {
+    _file.close();
+    _data = nullptr;
+}
+
+bool FiringProfile::isOpen() const {
+    return _data != nullptr;
+}
+
+void FiringProfile::recordGame(const vector<int> &shotNumbers) {
+    if(!_data) {
+        return;
+    }
+
+    int lastShot = 0;
+    for(int cell = 0; cell < NUM_CELLS; cell++) {
+        lastShot = max(lastShot, shotNumbers.at(cell));
+    }
+
+    // Games where the opponent never fired say nothing about them
+    if(lastShot == 0) {
+        return;
+    }
+
+    // Other games (in this program or another) may be recording against the same opponent
+    _file.lock(true);
+
+    for(int cell = 0; cell < NUM_CELLS; cell++) {
+        int shot = shotNumbers.at(cell) > 0 ? shotNumbers.at(cell) : lastShot + 1;
+
+        _data->shotTotals[cell] += shot;
+
+        if(shot <= OPENING_SHOTS) {
+            _data->openingCounts[cell]++;
+        }
+    }
+
+    _data->games++;
+    _file.unlock();
+
+    _file.sync();
+}
+
+int FiringProfile::numGames() const {
+    return _data ? _data->games : 0;
+}
+
+vector<double> FiringProfile::cellScores() const {
+    vector<double> scores(NUM_CELLS, 1.0);
+
+    if(!_data) {
+        return scores;
+    }
+
+    // What a player firing at random would average: every shot number equally likely, and OPENING_SHOTS of the
+    // squares in the opening
+    double randomShot = (NUM_CELLS + 1) / 2.0;
+    double randomOpening = (double) OPENING_SHOTS / NUM_CELLS;
+
+    // Copied while locked, so a game being recorded at the same time isn't seen half way through
+    _file.lock(false);
+    FiringProfileData counts = *_data;
+    _file.unlock();
+
+    double games = counts.games;
+
+    for(int cell = 0; cell < NUM_CELLS; cell++) {
+        double averageShot = (counts.shotTotals[cell] + PSEUDO_GAMES * randomShot) / (games + PSEUDO_GAMES);
+        double opening = (counts.openingCounts[cell] + PSEUDO_GAMES * randomOpening) / (games + PSEUDO_GAMES);
+
+        // A square that's reached late is a good hiding spot, unless it's also one the opponent sometimes opens on
+        scores.at(cell) = (averageShot / randomShot) * (1 - opening) / (1 - randomOpening);
+    }
+
+    return scores;
+}
+
+string FiringProfile::filenameFor(string opponentName) {
+    return MappedFile::filenameFor("profile", opponentName);
+}
+
+void FiringProfile::_initialize() {
+    memset(_data, 0, sizeof(FiringProfileData));
+    memcpy(_data->magic, "BSFP", 4);
+    _data->version = VERSION;
+}
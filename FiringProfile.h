@@ -0,0 +1,68 @@
+/* FiringProfile.h
+ *
+ * Author: Colin Siles
+ *
+ * The FiringProfile class learns where a particular opponent tends to shoot. For every square it counts how often the
+ * opponent fired there in their opening shots, and how many shots it took them to get there on average. The
+ * IntelligentComputer uses that to hide its ships on the squares that opponent gets to last
+ *
+ * Like the PlacementPrior, the profile is a small memory mapped file, so loading and updating it is nearly free, and
+ * it's locked while it's updated or read, so several games can share it
+*/
+
+#ifndef SFML_TEMPLATE_FIRINGPROFILE_H
+#define SFML_TEMPLATE_FIRINGPROFILE_H
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#include "MappedFile.h"
+#include "PlacementTable.h"
+
+using namespace std;
+
+// Layout of the profile file. All fields are stored in the machine's native byte order
+struct FiringProfileData {
+    char magic[4];                     // "BSFP"
+    uint32_t version;                  // FiringProfile::VERSION
+    uint32_t games;                    // Number of games recorded
+    uint32_t openingCounts[NUM_CELLS]; // How many times each square was among the first OPENING_SHOTS shots
+    uint32_t shotTotals[NUM_CELLS];    // Sum over games of the shot number each square was fired at
+};
+
+class FiringProfile {
+public:
+    FiringProfile();
+
+    // Maps the profile file, creating an empty profile if the file doesn't exist yet. Returns false if that fails
+    bool open(string filename);
+    void close();
+    bool isOpen() const;
+
+    // Adds a game, given the shot number (counting from 1) the opponent fired at each square, or 0 for squares they
+    // never fired at. Those are counted as coming just after the last shot, since that's the earliest they could have
+    void recordGame(const vector<int> &shotNumbers);
+
+    int numGames() const;
+
+    // How late in a game the opponent gets to each square, relative to an opponent firing at random (1 is the same as
+    // random, higher is later). Squares they often open on are scored lower still
+    vector<double> cellScores() const;
+
+    // Number of shots at the start of a game counted as the opponent's opening
+    static const int OPENING_SHOTS = 20;
+    static const uint32_t VERSION = 1;
+
+    // Returns the profile file to use for the opponent with the given name
+    static string filenameFor(string opponentName);
+
+private:
+    MappedFile _file;
+    FiringProfileData *_data;
+
+    // Creates (or clears) the profile stored at _data
+    void _initialize();
+};
+
+#endif //SFML_TEMPLATE_FIRINGPROFILE_H
@@ -6,7 +6,10 @@
  * to mark ships as sunk, or check if all the ships in the fleet are sunk. An abstraction over a simple vector of Ships
 */
 
+#include <algorithm>
+
 #include "Fleet.h"
+#include "PlacementTable.h"
 
 // Constructor, simply creates ships that in the internally stroed vector of ships
 Fleet::Fleet(vector<int> lengths) {
@@ -41,6 +44,45 @@ int Fleet::markShipHit(int xPos, int yPos) {
     return -1;
 }
 
+// Each ship just looks up its own squares in the salvo, rather than each hit looking for its ship
+void Fleet::markShipsHit(const int *shotAt, ShotOutcome *outcomes) {
+    for(int i = 0; i < _ships.size(); i++) {
+        Ship &ship = _ships.at(i);
+
+        // A ship that's already sunk can't be hit again
+        if(ship._sunk) {
+            continue;
+        }
+
+        int lastHit = -1;
+        for(auto &square : ship._squares) {
+            int shot = shotAt[cellIndex(square.first.first, square.first.second)];
+
+            if(shot >= 0) {
+                square.second = true;
+                lastHit = max(lastHit, shot);
+            }
+        }
+
+        if(lastHit >= 0) {
+            ship.checkIfSunk();
+
+            if(ship._sunk) {
+                outcomes[lastHit].sunkenIndex = i;
+            }
+        }
+    }
+}
+
+int Fleet::numAfloat() {
+    int afloat = 0;
+    for(int i = 0; i < _ships.size(); i++) {
+        afloat += !_ships.at(i).isSunk();
+    }
+
+    return afloat;
+}
+
 // Simple getter for number of ships in the fleet
 int Fleet::size() {
     return _ships.size();
@@ -77,4 +119,10 @@ bool Fleet::allSunk() {
     }
 
     return true;
-}
\ No newline at end of file
+}
+
+void Fleet::reset() {
+    for(int i = 0; i < _ships.size(); i++) {
+        _ships.at(i) = Ship(_ships.at(i).getLength());
+    }
+}
@@ -13,6 +13,8 @@
 
 #include "Ship.h"
 
+struct ShotOutcome;
+
 class Fleet {
 public:
     Fleet(vector<int> lengths);
@@ -20,6 +22,14 @@ public:
     // Returns the index of the ship sunk, or -1 if non sunk
     int markShipHit(int xPos, int yPos);
 
+    // Marks a whole salvo of hits at once, going over the fleet once rather than once per hit. shotAt holds the
+    // position in the salvo of the shot at each cell (NUM_CELLS entries, -1 where nothing was hit), and each ship the
+    // salvo sinks is reported in the outcome of the last of its hits (outcomes has one for each shot)
+    void markShipsHit(const int *shotAt, ShotOutcome *outcomes);
+
+    // Returns the number of ships that haven't been sunk
+    int numAfloat();
+
     // Returns the size of the fleet
     int size();
 
@@ -32,6 +42,9 @@ public:
     // Returns true if all the ships in teh fleet were sunk, and the player as lost
     bool allSunk();
 
+    // Puts every ship back to how it was created (not placed, and not sunk), for a new game
+    void reset();
+
 private:
     // The class is just wrapping this singular vector of Ships with some member functions
     vector<Ship> _ships;
@@ -10,7 +10,8 @@
 #include "FleetRenderer.h"
 
 // Primary Constructor
-FleetRenderer::FleetRenderer(Fleet &fleet, BoardRenderer *boardRenderer, RenderWindow &window) {
+FleetRenderer::FleetRenderer(Fleet &fleet, BoardRenderer *boardRenderer, RenderWindow &window)
+        : _vertices(Triangles) {
     // Store the pointer to the boardRenderer, and reference to the window
     _boardRenderer = boardRenderer;
     _window = &window;
@@ -31,11 +32,26 @@ FleetRenderer::FleetRenderer(Fleet &fleet, BoardRenderer *boardRenderer, RenderW
 
 // Draws all of the ships
 // The placingShips parameter will hide placed ships if ships are being placed (since they are already displayed by the
-// BoardRenderer class)
+// BoardRenderer class). The whole fleet is drawn at once
 void FleetRenderer::draw(bool placingShips) {
+    bool changed = false;
     for(int i = 0; i < _shipRenderers.size(); i++) {
-        _shipRenderers.at(i).draw(placingShips);
+        changed |= _shipRenderers.at(i).updateVertices(placingShips);
     }
+
+    if(changed) {
+        _vertices.clear();
+
+        for(int i = 0; i < _shipRenderers.size(); i++) {
+            const VertexArray &shipVertices = _shipRenderers.at(i).getVertices();
+
+            for(int j = 0; j < shipVertices.getVertexCount(); j++) {
+                _vertices.append(shipVertices[j]);
+            }
+        }
+    }
+
+    _window->draw(_vertices);
 }
 
 // Resets the position of all the ships to be next to the board
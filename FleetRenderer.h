@@ -58,6 +58,9 @@ private:
     // The Fleet Renderer just wraps the shipRenderer class in a vector
     vector<ShipRenderer> _shipRenderers;
 
+    // Every ship's vertices together, put back together only when one of the ships changes
+    VertexArray _vertices;
+
     // Pointer to the window to draw on
     RenderWindow *_window;
 
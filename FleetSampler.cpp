@@ -0,0 +1,98 @@
+/* FleetSampler.cpp
+ *
+ * Author: Colin Siles
+ *
+ * The FleetSampler class draws whole fleets of the ships still afloat that fit everything known about the opponent's
+ * board, and stores what a shot at every cell would report in each of them
+*/
+
+#include <algorithm>
+
+#include "FleetSampler.h"
+
+FleetSampler::FleetSampler(int maxSamples, int maxAttempts) {
+    _maxSamples = max(1, maxSamples);
+    _maxAttempts = max(_maxSamples, maxAttempts);
+
+    _numShips = 0;
+    _numSamples = 0;
+
+    _outcomes.resize(NUM_CELLS * _maxSamples);
+}
+
+int FleetSampler::sample(const CellMask &blocked, const CellMask &hits, const CellMask &required,
+        const vector<int> &shipLengths, SeededRandom &random) {
+    _numShips = shipLengths.size();
+    _numSamples = 0;
+
+    // Filter out the placements that hit a blocked cell, or that only cover hits
+    _fittingPlacements.resize(_numShips);
+    _chosen.resize(_numShips);
+
+    for(int i = 0; i < _numShips; i++) {
+        const vector<Placement> &placements = PlacementTable::forLength(shipLengths.at(i)).placements();
+
+        _fittingPlacements.at(i).clear();
+
+        for(int j = 0; j < placements.size(); j++) {
+            const CellMask &mask = placements.at(j).mask;
+
+            if((mask & blocked).none() && (mask & ~hits).any()) {
+                _fittingPlacements.at(i).push_back(j);
+            }
+        }
+
+        if(_fittingPlacements.at(i).empty()) {
+            return 0;
+        }
+    }
+
+    fill(_outcomes.begin(), _outcomes.end(), 0);
+
+    for(int attempt = 0; attempt < _maxAttempts && _numSamples < _maxSamples; attempt++) {
+        CellMask occupied;
+        bool fits = true;
+
+        for(int i = 0; i < _numShips && fits; i++) {
+            const vector<int> &fitting = _fittingPlacements.at(i);
+            int placement = fitting.at(random() % fitting.size());
+            const CellMask &mask = PlacementTable::forLength(shipLengths.at(i)).placements().at(placement).mask;
+
+            fits = (mask & occupied).none();
+            occupied |= mask;
+            _chosen.at(i) = placement;
+        }
+
+        if(!fits || (required & ~occupied).any()) {
+            continue;
+        }
+
+        // A shot at a ship sinks it if it's the only square of the ship that hasn't been hit yet
+        unsigned char *outcomes = _outcomes.data();
+
+        for(int i = 0; i < _numShips; i++) {
+            const Placement &placement = PlacementTable::forLength(shipLengths.at(i)).placements().at(_chosen.at(i));
+            unsigned char outcome = (placement.mask & ~hits).count() == 1 ? 2 + i : 1;
+
+            for(int j = 0; j < placement.cells.size(); j++) {
+                outcomes[placement.cells[j] * _maxSamples + _numSamples] = outcome;
+            }
+        }
+
+        _numSamples++;
+    }
+
+    return _numSamples;
+}
+
+int FleetSampler::numSamples() const {
+    return _numSamples;
+}
+
+int FleetSampler::numOutcomes() const {
+    return 2 + _numShips;
+}
+
+const unsigned char *FleetSampler::outcomes(int cell) const {
+    return _outcomes.data() + cell * _maxSamples;
+}
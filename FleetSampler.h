@@ -0,0 +1,60 @@
+/* FleetSampler.h
+ *
+ * Author: Colin Siles
+ *
+ * The FleetSampler class draws whole fleets of the ships still afloat that fit everything known about the opponent's
+ * board: no ship on a miss or a sunken ship, every hit that has to belong to a ship afloat covered, and no ship lying
+ * only on hits (it would have been sunk). Each ship's placement is drawn independently, and any fleet that overlaps or
+ * leaves a hit uncovered is thrown out, so every consistent fleet is equally likely to be drawn
+ *
+ * For each sample, it stores what a shot at every cell would report, which is what the IntelligentComputer needs to
+ * work out how much a shot is expected to tell it
+*/
+
+#ifndef SFML_TEMPLATE_FLEETSAMPLER_H
+#define SFML_TEMPLATE_FLEETSAMPLER_H
+
+#include <random>
+#include <vector>
+
+#include "PlacementTable.h"
+#include "SeededRandom.h"
+
+using namespace std;
+
+class FleetSampler {
+public:
+    FleetSampler(int maxSamples = 256, int maxAttempts = 4096);
+
+    // Draws up to maxSamples fleets of the given ships, making at most maxAttempts draws. Returns the number of fleets
+    // kept, which is 0 if no consistent fleet turned up
+    int sample(const CellMask &blocked, const CellMask &hits, const CellMask &required, const vector<int> &shipLengths,
+               SeededRandom &random);
+
+    int numSamples() const;
+
+    // Number of different things a shot can report: a miss, a hit that doesn't sink anything, or sinking each ship
+    int numOutcomes() const;
+
+    // What a shot at the cell reports in each of the samples (numSamples entries): 0 for a miss, 1 for a hit, and 2 + i
+    // for sinking the ship at index i of the lengths given
+    const unsigned char *outcomes(int cell) const;
+
+private:
+    int _maxSamples;
+    int _maxAttempts;
+
+    int _numShips;
+    int _numSamples;
+
+    // The placements of each ship that fit on their own, filtered once before drawing
+    vector<vector<int>> _fittingPlacements;
+
+    // Outcomes by cell, then by sample (maxSamples entries per cell), so scoring a cell reads them in a row
+    vector<unsigned char> _outcomes;
+
+    // Placement drawn for each ship in the current attempt
+    vector<int> _chosen;
+};
+
+#endif //SFML_TEMPLATE_FLEETSAMPLER_H
@@ -0,0 +1,264 @@
+/* FreeForAll.cpp
+ *
+ * Author: Colin Siles
+ *
+ * The FreeForAll class plays a match between any number of players, each firing at whichever opponent they choose
+*/
+
+#include <algorithm>
+#include <random>
+
+#include "Board.h"
+#include "FreeForAll.h"
+#include "PlayerRegistry.h"
+
+FreeForAll::FreeForAll(vector<string> playerDescriptions, vector<int> shipLengths) {
+    _numPlayers = playerDescriptions.size();
+    _playerDescriptions = playerDescriptions;
+    _shipLengths = shipLengths;
+
+    _fleetSquares = 0;
+    for(int i = 0; i < _shipLengths.size(); i++) {
+        _fleetSquares += _shipLengths.at(i);
+    }
+
+    // Seats with the same description share a kind
+    _numKinds = 0;
+    for(int seat = 0; seat < _numPlayers; seat++) {
+        int earlier = find(_playerDescriptions.begin(), _playerDescriptions.begin() + seat,
+                           _playerDescriptions.at(seat)) - _playerDescriptions.begin();
+
+        _seatKinds.push_back(earlier < seat ? _seatKinds.at(earlier) : _numKinds++);
+    }
+
+    _players.resize(_numPlayers);
+    _trackers.resize(_numKinds * _numPlayers);
+
+    _shotCells.resize(_numPlayers);
+    _hitsTaken.resize(_numPlayers);
+    _sunkSquares.resize(_numPlayers);
+    _shots.resize(_numPlayers);
+    _hits.resize(_numPlayers);
+
+    // Reserved up front, so that taking players out (or choosing who to fire at) never has to allocate
+    _remaining.reserve(_numPlayers);
+    _eliminated.reserve(_numPlayers);
+    _targets.reserve(_numPlayers);
+
+    _playersCreated = _createPlayers();
+
+    reset(0);
+}
+
+bool FreeForAll::_createPlayers() {
+    for(int seat = 0; seat < _numPlayers; seat++) {
+        string name = "Player " + to_string(seat + 1);
+
+        _players.at(seat).reset(PlayerRegistry::create(_playerDescriptions.at(seat), name, _shipLengths));
+        if(!_players.at(seat)) {
+            return false;
+        }
+
+        for(int kind = 0; kind < _numKinds; kind++) {
+            int description = find(_seatKinds.begin(), _seatKinds.end(), kind) - _seatKinds.begin();
+            unique_ptr<Player> &tracker = _trackers.at(kind * _numPlayers + seat);
+
+            tracker.reset(PlayerRegistry::create(_playerDescriptions.at(description), name, _shipLengths));
+            if(!tracker) {
+                return false;
+            }
+        }
+    }
+
+    return true;
+}
+
+bool FreeForAll::reset(uint32_t seed) {
+    fill(_shotCells.begin(), _shotCells.end(), CellMask());
+    fill(_hitsTaken.begin(), _hitsTaken.end(), 0);
+    fill(_sunkSquares.begin(), _sunkSquares.end(), 0);
+    fill(_shots.begin(), _shots.end(), 0);
+    fill(_hits.begin(), _hits.end(), 0);
+
+    _remaining.clear();
+    _nextTurn = 0;
+    _eliminated.clear();
+    _winner = -1;
+    _turns = 0;
+
+    _lastShooter = -1;
+    _lastTarget = -1;
+    _lastMove = make_pair(-1, -1);
+
+    if(!_playersCreated) {
+        return false;
+    }
+
+    for(int seat = 0; seat < _numPlayers; seat++) {
+        seed_seq seeds = {seed, (uint32_t) seat};
+        mt19937 seeder(seeds);
+
+        Player *player = _players.at(seat).get();
+        player->resetState();
+        player->setSeed(seeder());
+        player->placeShips();
+
+        for(int kind = 0; kind < _numKinds; kind++) {
+            Player *tracker = _trackers.at(kind * _numPlayers + seat).get();
+            tracker->resetState();
+            tracker->setSeed(seeder());
+        }
+    }
+
+    // A match needs at least two players
+    for(int seat = 0; seat < _numPlayers && _numPlayers > 1; seat++) {
+        _remaining.push_back(seat);
+    }
+
+    return true;
+}
+
+bool FreeForAll::step() {
+    if(_remaining.size() < 2) {
+        return false;
+    }
+
+    int seat = _remaining.at(_nextTurn);
+
+    _gatherTargets();
+    int target = _players.at(seat)->chooseTarget(_targets);
+
+    bool validTarget = false;
+    for(int i = 0; i < _targets.size(); i++) {
+        validTarget = validTarget || _targets.at(i).seat == target;
+    }
+
+    pair<int, int> move = validTarget ? _trackers.at(_seatKinds.at(seat) * _numPlayers + target)->getMove()
+                                      : make_pair(-1, -1);
+
+    _turns++;
+    _lastShooter = seat;
+    _lastTarget = target;
+    _lastMove = move;
+
+    // A player that doesn't choose an opponent and a move that can be made forfeits (and the player after them moves
+    // next)
+    if(!validTarget || move.first < 0 || move.first >= Board::GRID_SIZE || move.second < 0 ||
+       move.second >= Board::GRID_SIZE || _shotCells.at(target).test(cellIndex(move.first, move.second))) {
+        _eliminate(seat);
+        return _remaining.size() > 1;
+    }
+
+    ShotOutcome outcome = _players.at(target)->fireShotAt(move.first, move.second);
+    _shotCells.at(target).set(cellIndex(move.first, move.second));
+    _shots.at(seat)++;
+
+    // Everyone sees the shot
+    for(int kind = 0; kind < _numKinds; kind++) {
+        _trackers.at(kind * _numPlayers + target)->markShot(move.first, move.second, outcome);
+    }
+
+    if(outcome.hit) {
+        _hits.at(seat)++;
+        _hitsTaken.at(target)++;
+    }
+
+    if(outcome.sunkenIndex >= 0) {
+        _sunkSquares.at(target) += _shipLengths.at(outcome.sunkenIndex);
+    }
+
+    if(_players.at(target)->allShipsSunk()) {
+        _eliminate(target);
+    }
+
+    if(_remaining.size() < 2) {
+        return false;
+    }
+
+    _nextTurn = (_nextTurn + 1) % _remaining.size();
+    return true;
+}
+
+int FreeForAll::run() {
+    while(step()) {
+    }
+
+    return _winner;
+}
+
+int FreeForAll::getNumPlayers() const {
+    return _numPlayers;
+}
+
+int FreeForAll::getNumRemaining() const {
+    return _remaining.size();
+}
+
+int FreeForAll::getWinner() const {
+    return _winner;
+}
+
+int FreeForAll::getTurns() const {
+    return _turns;
+}
+
+int FreeForAll::getShots(int seat) const {
+    return _shots.at(seat);
+}
+
+int FreeForAll::getHits(int seat) const {
+    return _hits.at(seat);
+}
+
+const vector<int> &FreeForAll::getEliminated() const {
+    return _eliminated;
+}
+
+const CellMask &FreeForAll::getShotCells(int seat) const {
+    return _shotCells.at(seat);
+}
+
+int FreeForAll::getLastShooter() const {
+    return _lastShooter;
+}
+
+int FreeForAll::getLastTarget() const {
+    return _lastTarget;
+}
+
+pair<int, int> FreeForAll::getLastMove() const {
+    return _lastMove;
+}
+
+void FreeForAll::_gatherTargets() {
+    _targets.clear();
+
+    for(int i = 1; i < _remaining.size(); i++) {
+        int target = _remaining.at((_nextTurn + i) % _remaining.size());
+
+        int openHits = _hitsTaken.at(target) - _sunkSquares.at(target);
+        int squaresLeft = _fleetSquares - _hitsTaken.at(target);
+
+        _targets.push_back({target, openHits, squaresLeft});
+    }
+}
+
+void FreeForAll::_eliminate(int seat) {
+    int position = find(_remaining.begin(), _remaining.end(), seat) - _remaining.begin();
+
+    _remaining.erase(_remaining.begin() + position);
+    _eliminated.push_back(seat);
+
+    // Keep pointing at the same player to move, or the one after a player that's taken out on their own turn
+    if(position < _nextTurn) {
+        _nextTurn--;
+    }
+
+    if(_nextTurn >= _remaining.size()) {
+        _nextTurn = 0;
+    }
+
+    if(_remaining.size() == 1) {
+        _winner = _remaining.at(0);
+    }
+}
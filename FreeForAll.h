@@ -0,0 +1,114 @@
+/* FreeForAll.h
+ *
+ * Author: Colin Siles
+ *
+ * The FreeForAll class plays a match between any number of players (created by the PlayerRegistry), without a window
+ * or battlelog. Players take turns in seat order, each choosing an opponent and a square to fire at, and a player is
+ * out once their whole fleet is sunk (or they forfeit by choosing an opponent who isn't in the match, or giving a move
+ * that isn't on the board, or was fired at already). The last player left wins. Who to fire at is up to each player
+ * (see Player::chooseTarget)
+ *
+ * Every shot is seen by everyone, so what's known of a player's board is the same whoever is looking at it. Rather
+ * than each player keeping its own copy of every opponent, there's one tracker per target for each kind of player in
+ * the match: a player of that kind that only ever marks the shots fired at the target, and chooses the shots at it.
+ * With one kind of player, that's two players per seat however many seats there are. The players in the seats just
+ * hold the ships
+ *
+ * The players are created along with the match, and reset just starts them over, so playing match after match doesn't
+ * create anything either (the players may allocate, choosing a move)
+*/
+
+#ifndef SFML_TEMPLATE_FREEFORALL_H
+#define SFML_TEMPLATE_FREEFORALL_H
+
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "Player.h"
+#include "PlacementTable.h"
+
+using namespace std;
+
+class FreeForAll {
+public:
+    // One seat for each description (see PlayerRegistry), which can repeat
+    FreeForAll(vector<string> playerDescriptions, vector<int> shipLengths = {5, 4, 4, 3, 2});
+
+    // Starts the match over, with the players seeded from the seed. Returns false if the players couldn't be created
+    // when the match was (it is then over, with no winner)
+    bool reset(uint32_t seed);
+
+    // Plays a single turn: the next player still in fires one shot. Returns false once the match is over
+    bool step();
+
+    // Plays the rest of the match, and returns the winner's seat (-1 if there isn't a match)
+    int run();
+
+    int getNumPlayers() const;
+    int getNumRemaining() const;
+    int getWinner() const; // -1 while the match is still going
+    int getTurns() const;
+
+    // Shots the player has fired, and how many of them hit
+    int getShots(int seat) const;
+    int getHits(int seat) const;
+
+    // Seats in the order they were knocked out, so the winner comes after the last of them
+    const vector<int> &getEliminated() const;
+
+    // Squares fired at on the seat's board so far
+    const CellMask &getShotCells(int seat) const;
+
+    // Who fired the last shot, at whom, and where (-1 before the first)
+    int getLastShooter() const;
+    int getLastTarget() const;
+    pair<int, int> getLastMove() const;
+
+private:
+    int _numPlayers;
+    vector<string> _playerDescriptions;
+    vector<int> _shipLengths;
+    int _fleetSquares;
+
+    // Each distinct description is a kind of player, with its own trackers
+    vector<int> _seatKinds;
+    int _numKinds;
+
+    vector<unique_ptr<Player>> _players;  // [seat]: holds the seat's ships, and chooses who to fire at
+    vector<unique_ptr<Player>> _trackers; // [kind * numPlayers + target]: chooses shots at the target
+    bool _playersCreated;
+
+    // What everyone knows of each seat's board
+    vector<CellMask> _shotCells; // [seat]
+    vector<int> _hitsTaken;      // [seat]: hits on the seat's ships
+    vector<int> _sunkSquares;    // [seat]: squares of the seat's ships that have been sunk
+
+    vector<int> _shots; // [seat]: shots fired by the seat
+    vector<int> _hits;
+
+    // Seats still in, in turn order, and the position in it of the player to move next
+    vector<int> _remaining;
+    int _nextTurn;
+
+    vector<int> _eliminated;
+    int _winner;
+    int _turns;
+
+    int _lastShooter;
+    int _lastTarget;
+    pair<int, int> _lastMove;
+
+    // The players the player to move can fire at, starting from the next seat around (kept to reuse its memory)
+    vector<TargetInfo> _targets;
+    void _gatherTargets();
+
+    // Creates every player and tracker, returning false if one of them couldn't be
+    bool _createPlayers();
+
+    // Takes the seat out of the match, ending it once only one player is left
+    void _eliminate(int seat);
+};
+
+#endif //SFML_TEMPLATE_FREEFORALL_H
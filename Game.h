@@ -11,11 +11,21 @@
 #ifndef SFML_TEMPLATE_GAME_H
 #define SFML_TEMPLATE_GAME_H
 
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <iostream>
+#include <random>
 #include <string>
 #include <vector>
 
 #include "Battlelog.h"
+#include "CancellationToken.h"
+#include "Deadline.h"
+#include "GameEventBus.h"
+#include "GameSnapshot.h"
 #include "Player.h"
+#include "Task.h"
 
 using namespace std;
 
@@ -27,6 +37,51 @@ public:
     // The only function that needs to be run: manages the entire game
     void runGame();
 
+    // Coroutine version of runGame, which suspends instead of blocking while a player is waiting on something (see
+    // Player::getMoveAsync), so that many games can share a few threads on a Scheduler
+    Task<void> runGameAsync();
+
+    // Limits how long each player may think, per move and over the whole game, in milliseconds (0 for no limit)
+    // A player that goes over a limit (by more than TIME_GRACE) loses on time. By default there are no limits
+    void setTimeControl(double moveMilliseconds, double gameMilliseconds);
+
+    // Ends the game before the next move, and tells the player whose turn it is to stop thinking
+    // Meant to be called from another thread (e.g. when a server shuts down)
+    void cancel();
+
+    // How long each move took to choose, in milliseconds, in the order the moves were made
+    const vector<double> &getThinkTimes();
+
+    // The players, so they can be set up before the game starts
+    p1Type &getPlayerOne();
+    p2Type &getPlayerTwo();
+
+    // Publishes the game's events to the given bus, tagged with the given id, instead of handing them to the battlelog
+    // (which the game otherwise does itself, on its own thread). Has to be called before the game starts
+    void setEventBus(GameEventBus *eventBus, uint64_t gameId);
+
+    // Seeds both players' random number generators from the given seed, so the game can be replayed, and records the
+    // seed with the game's start (for binary battlelogs). Has to be called before the game starts
+    void setSeed(uint64_t seed);
+
+    // Picks up a game saved in a snapshot (see GameSnapshot.h) instead of starting a new one: runGame then carries on
+    // from where it was saved, without the players placing their ships (their seeds come from the snapshot too).
+    // Has to be called before the game starts, after any other setup of the players. Returns false if there's no
+    // snapshot, or it doesn't fit the players, in which case the game starts from the beginning
+    bool loadSnapshot(string filename);
+
+    // Saves the game as it stands, so it can be picked up later with loadSnapshot
+    bool saveSnapshot(string filename);
+
+    // Saves the game to the given file every given number of moves, and whenever the game stops before it's over
+    // (like when the window is closed), then deletes the file once the game is over. An empty filename turns it off
+    void setAutosave(string filename, int everyMoves = 1);
+
+    // Plays the salvo variant: each turn, a player fires a salvo of as many shots as they have ships afloat, all
+    // resolved at once (see Player::getMoves). Off by default. Binary battlelogs assume the players take turns a shot
+    // at a time, so salvo games should be recorded in the text battlelog
+    void setSalvo(bool enabled);
+
 private:
     // Store players in a vector to prevent duplicate code
     vector<Player *> _players;
@@ -38,8 +93,67 @@ private:
     // Tracks whose turn it is. 0 is for the first player, 1 is for the second player
     int _turn;
 
-    // Battlelog objects
+    // Battlelog objects, and whether the battlelog is on (it's handed the game's events directly, unless they go to an
+    // event bus, so a game doesn't need a bus and a thread of its own just to write it)
     Battlelog _battlelog;
+    bool _battlelogOn;
+
+    // The bus the game publishes to (nullptr if it hasn't been given one), and the id it tags its events with
+    GameEventBus *_eventBus;
+    uint64_t _gameId;
+
+    // The seed set with setSeed, or 0 if there wasn't one
+    uint64_t _seed;
+
+    // Publishes an event to the bus, or hands it to the battlelog without one (if nothing is listening, it's skipped
+    // before being built)
+    void _publish(GameEventType type, int player, int xPos = -1, int yPos = -1, bool hit = false, int sunkenIndex = -1,
+                  double milliseconds = 0);
+
+    // Time controls, the time each player has used so far, and the think time of every move (all in milliseconds)
+    double _moveLimit;
+    double _gameLimit;
+    vector<double> _timeUsed;
+    vector<double> _thinkTimes;
+
+    // Cancelled by cancel(), and watched by every move's deadline
+    CancellationToken _cancellation;
+
+    // The moves made so far, and whether they were made before the game was picked up from a snapshot
+    vector<RecordedMove> _moves;
+    bool _resumed;
+
+    // The number of those moves each player made
+    vector<int> _shotsFired;
+
+    // Where to autosave the game, and how many moves apart (see setAutosave)
+    string _autosaveFile;
+    int _autosaveMoves;
+
+    // How far over a time limit a player can go before losing on time, to allow for the time it takes to notice the
+    // deadline has passed
+    static const double TIME_GRACE;
+
+    // Returns the deadline for the current player's move, from whichever time control runs out first
+    Deadline _moveDeadline();
+
+    // Publishes the end of the game, and reports it to both players
+    Task<void> _finishGame(int winner);
+
+    // Saves a snapshot to the autosave file, if there is one
+    void _autosave();
+
+    // Whether the game is played with salvos
+    bool _salvo;
+
+    // Returns true if the moves can be fired: there's at least one, none of them are off the board (which is how
+    // players forfeit) or fired at in an earlier turn (going by the shooter's tracking board), and no square is in the
+    // same salvo twice
+    bool _validMoves(const vector<pair<int, int>> &moves);
+
+    // The number of shots the player whose turn it is fires in a salvo: one for each of their ships afloat, but no
+    // more than the squares they haven't fired at
+    int _salvoSize();
 
     // Static object to store the default lengths for ships in Battleship
     static const vector<int> DEFAULT_LENGTHS;
@@ -49,6 +163,9 @@ private:
 template<typename p1Type, typename p2Type>
 const vector<int> Game<p1Type, p2Type>::DEFAULT_LENGTHS = {5, 4, 4, 3, 2};
 
+template<typename p1Type, typename p2Type>
+const double Game<p1Type, p2Type>::TIME_GRACE = 20;
+
 
 // Use intiizlier lists to initizilize both players
 template<typename p1Type, typename p2Type>
@@ -60,58 +177,369 @@ Game<p1Type, p2Type>::Game(string p1Name, string p2Name, vector<int> shipLengths
 
     // Deafult for turn is 0 (first player, obviously)
     _turn = 0;
+
+    // No time controls unless they're set
+    _moveLimit = 0;
+    _gameLimit = 0;
+    _timeUsed = {0, 0};
+
+    // A new game (unless a snapshot is loaded), and no autosaving unless it's set
+    _resumed = false;
+    _shotsFired = {0, 0};
+    _autosaveMoves = 1;
+
+    // One shot a turn, unless salvos are turned on
+    _salvo = false;
+
+    // The battlelog is written by the game itself, unless it's turned off
+    _battlelogOn = !battlelogName.empty();
+    _eventBus = nullptr;
+    _gameId = 0;
+    _seed = 0;
+}
+
+template<typename p1Type, typename p2Type>
+void Game<p1Type, p2Type>::setTimeControl(double moveMilliseconds, double gameMilliseconds) {
+    _moveLimit = moveMilliseconds;
+    _gameLimit = gameMilliseconds;
+}
+
+template<typename p1Type, typename p2Type>
+void Game<p1Type, p2Type>::cancel() {
+    _cancellation.cancel();
+}
+
+template<typename p1Type, typename p2Type>
+const vector<double> &Game<p1Type, p2Type>::getThinkTimes() {
+    return _thinkTimes;
+}
+
+template<typename p1Type, typename p2Type>
+p1Type &Game<p1Type, p2Type>::getPlayerOne() {
+    return _playerOne;
+}
+
+template<typename p1Type, typename p2Type>
+p2Type &Game<p1Type, p2Type>::getPlayerTwo() {
+    return _playerTwo;
+}
+
+template<typename p1Type, typename p2Type>
+void Game<p1Type, p2Type>::setEventBus(GameEventBus *eventBus, uint64_t gameId) {
+    _eventBus = eventBus;
+    _gameId = gameId;
+}
+
+template<typename p1Type, typename p2Type>
+void Game<p1Type, p2Type>::setSeed(uint64_t seed) {
+    _seed = seed;
+
+    // The players get different seeds, so they don't make the same choices
+    seed_seq sequence = {(uint32_t) seed, (uint32_t) (seed >> 32)};
+    vector<uint32_t> playerSeeds(2);
+    sequence.generate(playerSeeds.begin(), playerSeeds.end());
+
+    for(int i = 0; i < 2; i++) {
+        _players.at(i)->setSeed(playerSeeds.at(i));
+    }
+}
+
+template<typename p1Type, typename p2Type>
+bool Game<p1Type, p2Type>::loadSnapshot(string filename) {
+    GameSnapshot snapshot;
+    if(!snapshot.load(filename)) {
+        return false;
+    }
+
+    // The players hear who they're up against first, since the computer weighs what it works out from the shots by
+    // what it knows about its opponent
+    for(int i = 0; i < 2; i++) {
+        _players.at(i)->reportOpponent(_players.at(!i)->getName());
+    }
+
+    if(!snapshot.restore(_playerOne, _playerTwo)) {
+        return false;
+    }
+
+    _moves = snapshot.record.moves;
+    _turn = snapshot.turn;
+
+    _shotsFired = {0, 0};
+    for(int i = 0; i < _moves.size(); i++) {
+        _shotsFired.at(_moves.at(i).player)++;
+    }
+    _seed = snapshot.record.seed;
+    _timeUsed = {snapshot.timeUsed[0], snapshot.timeUsed[1]};
+    _resumed = true;
+
+    return true;
+}
+
+template<typename p1Type, typename p2Type>
+bool Game<p1Type, p2Type>::saveSnapshot(string filename) {
+    GameSnapshot snapshot = GameSnapshot::capture(_playerOne, _playerTwo, _moves, _turn);
+    snapshot.record.seed = _seed;
+
+    for(int i = 0; i < 2; i++) {
+        snapshot.timeUsed[i] = _timeUsed.at(i);
+    }
+
+    return snapshot.save(filename);
+}
+
+template<typename p1Type, typename p2Type>
+void Game<p1Type, p2Type>::setSalvo(bool enabled) {
+    _salvo = enabled;
+}
+
+template<typename p1Type, typename p2Type>
+void Game<p1Type, p2Type>::setAutosave(string filename, int everyMoves) {
+    _autosaveFile = filename;
+    _autosaveMoves = max(everyMoves, 1);
 }
 
+// The synchronous version just runs the coroutine version to completion on this thread
 template<typename p1Type, typename p2Type>
 void Game<p1Type, p2Type>::runGame() {
+    syncWait(runGameAsync());
+}
+
+template<typename p1Type, typename p2Type>
+Task<void> Game<p1Type, p2Type>::runGameAsync() {
+    _publish(GAME_STARTED, -1);
+
     // For both of the players
-    for(int i = 0; i < 2; i++) {
+    for(int i = 0; i < 2 && !_resumed; i++) {
+        // Let them know who they're playing against
+        _players.at(i)->reportOpponent(_players.at(!i)->getName());
+
         // Request that they place their ships
-        _players.at(i)->placeShips();
+        co_await _players.at(i)->placeShipsAsync();
 
         // But return an error and exit if the player doesn't palce all their ships
         if(!_players.at(i)->allShipsPlaced()) {
             cerr << _players.at(i)->getName() <<  " failed to place all their ships" << endl;
-            return;
+            _publish(GAME_OVER, -1);
+            co_return;
         }
+
+        _publish(SHIPS_PLACED, i);
     }
 
+    // A game picked up from a snapshot already has its ships placed, and lets the subscribers (like the battlelog)
+    // catch up on the moves made before it was saved
+    for(int i = 0; i < 2 && _resumed; i++) {
+        _publish(SHIPS_PLACED, i);
+    }
+
+    for(int i = 0; i < _moves.size() && _resumed; i++) {
+        const RecordedMove &move = _moves.at(i);
+        int sunkenIndex = move.sunk ? move.sunkenIndex : -1;
+
+        _publish(SHOT_FIRED, move.player, move.xPos, move.yPos);
+        _publish(SHOT_OUTCOME, move.player, move.xPos, move.yPos, move.hit, sunkenIndex);
+
+        if(sunkenIndex >= 0) {
+            _publish(SHIP_SUNK, move.player, move.xPos, move.yPos, true, sunkenIndex);
+        }
+    }
+
+    // The outcomes of each turn's shots, kept from turn to turn so resolving a salvo doesn't allocate
+    vector<ShotOutcome> outcomes;
+
     // Continue running until the game is over
     while(true) {
-        // Get the move from the player
-        pair<int, int> move = _players.at(_turn)->getMove();
+        // Get the move (or the salvo of moves) from the player, timing how long they take
+        Deadline deadline = _moveDeadline();
+        chrono::steady_clock::time_point start = chrono::steady_clock::now();
+
+        vector<pair<int, int>> moves;
+        if(_salvo) {
+            moves = co_await _players.at(_turn)->getMovesAsync(_salvoSize(), deadline);
+        } else {
+            pair<int, int> move = co_await _players.at(_turn)->getMoveAsync(deadline);
+            moves = {move};
+        }
+
+        double thinkTime = chrono::duration<double, milli>(chrono::steady_clock::now() - start).count();
+
+        _thinkTimes.push_back(thinkTime);
+        _timeUsed.at(_turn) += thinkTime;
+
+        _publish(MOVE_TIMED, _turn, -1, -1, false, -1, thinkTime);
+
+        if(_cancellation.isCancelled()) {
+            cerr << "The game was cancelled" << endl;
+            _autosave();
+            _publish(GAME_OVER, -1);
+            co_return;
+        }
+
+        bool valid = _validMoves(moves);
+
+        // A player that goes over either time control loses, as does one that gave up on moving because time ran out
+        if((_moveLimit > 0 && thinkTime > _moveLimit + TIME_GRACE) ||
+           (_gameLimit > 0 && _timeUsed.at(_turn) > _gameLimit + TIME_GRACE) ||
+           (!valid && deadline.expired())) {
+            cerr << _players.at(_turn)->getName() << " ran out of time" << endl;
+            co_await _finishGame(!_turn);
+            co_return;
+        }
 
         // Ensure that its valid, end the game if it's not
         // (HumanSFMLPlayer returns -1 if the player closes the window)
-        if(move.first < 0) {
+        if(!valid) {
             cerr << _players.at(_turn)->getName() << " has forfeited the match" << endl;
-            return;
+            _autosave();
+            _publish(GAME_OVER, -1);
+
+            // The players still hear how it ended (a remote player would otherwise wait on the result forever)
+            co_await _players.at(!_turn)->reportGameoverAsync(true);
+            co_await _players.at(_turn)->reportGameoverAsync(false);
+            co_return;
         }
 
-        // Capture the outcome of the shot at the opponent
-        ShotOutcome outcome = _players.at(!_turn)->fireShotAt(move.first, move.second);
+        for(int i = 0; i < moves.size(); i++) {
+            _publish(SHOT_FIRED, _turn, moves.at(i).first, moves.at(i).second);
+        }
 
-        // Allow the player to mark the outcome of their shot
-        _players.at(_turn)->markShot(move.first, move.second, outcome);
+        // Capture the outcome of the shots at the opponent (a salvo is resolved all at once)
+        if(_salvo) {
+            _players.at(!_turn)->fireShotsAt(moves, outcomes);
+        } else {
+            outcomes.assign(1, _players.at(!_turn)->fireShotAt(moves.at(0).first, moves.at(0).second));
+        }
 
-        // Record the move in the battlelog
-        _battlelog.recordMove(move.first, move.second, outcome);
+        int movesBefore = _moves.size();
 
-        // If all the opponents ships were sunk...
-        if(_players.at(!_turn)->allShipsSunk()) {
-            // Record the winner in the battlelog
-            _battlelog.recordWinner(_players.at(_turn)->getName());
+        for(int i = 0; i < moves.size(); i++) {
+            pair<int, int> move = moves.at(i);
+            ShotOutcome outcome = outcomes.at(i);
+
+            // Allow the player to mark the outcome of their shot
+            _players.at(_turn)->markShot(move.first, move.second, outcome);
 
-            // Report that the game ended, and who won to the players
-            _players.at(_turn)->reportGameover(true);
-            _players.at(!_turn)->reportGameover(false);
+            // Let the subscribers (like the battlelog) know how it went
+            _publish(SHOT_OUTCOME, _turn, move.first, move.second, outcome.hit, outcome.sunkenIndex);
+            _moves.push_back({_turn, move.first, move.second, outcome.hit, outcome.sunkenIndex >= 0,
+                              outcome.sunkenIndex});
+            _shotsFired.at(_turn)++;
 
-            // Exit the game
-            return;
+            if(outcome.sunkenIndex >= 0) {
+                _publish(SHIP_SUNK, _turn, move.first, move.second, true, outcome.sunkenIndex);
+            }
+        }
+
+        // If all the opponents ships were sunk, the game is over
+        if(_players.at(!_turn)->allShipsSunk()) {
+            co_await _finishGame(_turn);
+            co_return;
         }
 
         // Toggle the turn
         _turn = !_turn;
+
+        if(_moves.size() / _autosaveMoves > movesBefore / _autosaveMoves) {
+            _autosave();
+        }
+    }
+}
+
+template<typename p1Type, typename p2Type>
+bool Game<p1Type, p2Type>::_validMoves(const vector<pair<int, int>> &moves) {
+    if(moves.empty()) {
+        return false;
+    }
+
+    CellMask aimed;
+
+    for(int i = 0; i < moves.size(); i++) {
+        int xPos = moves.at(i).first;
+        int yPos = moves.at(i).second;
+
+        // Off the board, or already fired at
+        if(!_players.at(_turn)->validGuess(xPos, yPos)) {
+            return false;
+        }
+
+        if(aimed.test(cellIndex(xPos, yPos))) {
+            return false;
+        }
+
+        aimed.set(cellIndex(xPos, yPos));
+    }
+
+    return true;
+}
+
+template<typename p1Type, typename p2Type>
+int Game<p1Type, p2Type>::_salvoSize() {
+    return min(_players.at(_turn)->numShipsAfloat(), NUM_CELLS - _shotsFired.at(_turn));
+}
+
+template<typename p1Type, typename p2Type>
+Deadline Game<p1Type, p2Type>::_moveDeadline() {
+    // Without any time controls, the move can only be cut short by cancelling the game
+    if(_moveLimit <= 0 && _gameLimit <= 0) {
+        return Deadline(chrono::steady_clock::time_point::max(), &_cancellation);
+    }
+
+    double limit = _moveLimit > 0 ? _moveLimit : _gameLimit;
+    if(_gameLimit > 0) {
+        limit = min(limit, _gameLimit - _timeUsed.at(_turn));
+    }
+
+    return Deadline::after(limit, &_cancellation);
+}
+
+template<typename p1Type, typename p2Type>
+Task<void> Game<p1Type, p2Type>::_finishGame(int winner) {
+    _publish(GAME_OVER, winner);
+
+    // A finished game can't be picked up again
+    if(!_autosaveFile.empty()) {
+        remove(_autosaveFile.c_str());
+    }
+
+    // Report that the game ended, and who won to the players
+    co_await _players.at(winner)->reportGameoverAsync(true);
+    co_await _players.at(!winner)->reportGameoverAsync(false);
+}
+
+template<typename p1Type, typename p2Type>
+void Game<p1Type, p2Type>::_autosave() {
+    if(!_autosaveFile.empty()) {
+        saveSnapshot(_autosaveFile);
+    }
+}
+
+template<typename p1Type, typename p2Type>
+void Game<p1Type, p2Type>::_publish(GameEventType type, int player, int xPos, int yPos, bool hit, int sunkenIndex,
+                                    double milliseconds) {
+    if(_eventBus ? !_eventBus->hasSubscribers() : !_battlelogOn) {
+        return;
+    }
+
+    GameEvent event = {type, _gameId, player, xPos, yPos, hit, sunkenIndex, milliseconds, 0, {}};
+
+    // Only the start of the game carries the seed and names
+    if(type == GAME_STARTED) {
+        event.seed = _seed;
+
+        for(int i = 0; i < 2; i++) {
+            _players.at(i)->getName().copy(event.playerNames[i], GameEvent::NAME_LENGTH - 1);
+        }
+    }
+
+    if(_eventBus) {
+        _eventBus->publish(event);
+        return;
+    }
+
+    // The battlelog is written out at the end of each game, the way the bus's default flush policy would
+    _battlelog.onEvent(event);
+    if(type == GAME_OVER) {
+        _battlelog.flush();
     }
 }
 
@@ -0,0 +1,219 @@
+/* GameBatch.cpp
+ *
+ * Author: Colin Siles
+ *
+ * The GameBatch class plays many games at once, a few moves at a time, keeping their state in flat arrays
+*/
+
+#include <algorithm>
+#include <random>
+
+#include "Board.h"
+#include "GameBatch.h"
+#include "IntelligentComputer.h"
+#include "PlacementTable.h"
+#include "PlayerRegistry.h"
+#include "Simulation.h"
+
+// Games handed to a thread at a time
+static const int GAMES_PER_JOB = 16;
+
+GameBatch::GameBatch(int numGames, string firstPlayer, string secondPlayer, vector<int> shipLengths, uint64_t seed) {
+    _numGames = max(numGames, 0);
+    _playerDescriptions[0] = firstPlayer;
+    _playerDescriptions[1] = secondPlayer;
+    _shipLengths = shipLengths;
+
+    _players.resize(2 * _numGames);
+    _numRunning = 0;
+
+    _boards.resize(_numGames * 2 * NUM_CELLS);
+    _densities.resize(_numGames * 2 * NUM_CELLS);
+    _lastMoves.resize(_numGames * 2 * 2);
+    _shots.resize(_numGames * 2);
+    _shipsAfloat.resize(_numGames * 2);
+    _turns.resize(_numGames);
+    _winners.resize(_numGames);
+
+    reset(seed);
+}
+
+bool GameBatch::reset(uint64_t seed) {
+    fill(_boards.begin(), _boards.end(), UNKNOWN);
+    fill(_densities.begin(), _densities.end(), 0);
+    fill(_lastMoves.begin(), _lastMoves.end(), -1);
+    fill(_shots.begin(), _shots.end(), 0);
+    fill(_shipsAfloat.begin(), _shipsAfloat.end(),
+         _shipLengths.size() >= 32 ? UINT32_MAX : (1u << _shipLengths.size()) - 1);
+    fill(_turns.begin(), _turns.end(), 0);
+    fill(_winners.begin(), _winners.end(), -1);
+
+    _numRunning = 0;
+
+    for(int game = 0; game < _numGames; game++) {
+        // Seeded the same way whatever else is in the batch, so a game can be played again on its own
+        seed_seq seeds = {(uint32_t) seed, (uint32_t) (seed >> 32), (uint32_t) game};
+        mt19937 seeder(seeds);
+
+        for(int i = 0; i < 2; i++) {
+            Player *player = PlayerRegistry::create(_playerDescriptions[i], "Player " + to_string(i + 1), _shipLengths);
+            if(!player) {
+                _players.clear();
+                _players.resize(2 * _numGames);
+                return false;
+            }
+
+            player->setSeed(seeder());
+            player->placeShips();
+            _players.at(2 * game + i).reset(player);
+        }
+    }
+
+    _numRunning = _numGames;
+    return true;
+}
+
+int GameBatch::step(int moves, int numThreads) {
+    int numJobs = (_numGames + GAMES_PER_JOB - 1) / GAMES_PER_JOB;
+
+    runJobs(numJobs, max(numThreads, 1), [&](int job) {
+        int endGame = min((job + 1) * GAMES_PER_JOB, _numGames);
+
+        for(int game = job * GAMES_PER_JOB; game < endGame; game++) {
+            _stepGame(game, moves);
+        }
+    });
+
+    _numRunning = count(_winners.begin(), _winners.end(), -1);
+    if(_players.empty() || !_players.at(0)) {
+        _numRunning = 0;
+    }
+
+    return _numRunning;
+}
+
+void GameBatch::run(int numThreads) {
+    // Every move fills in a cell, so no game lasts longer than this
+    step(2 * NUM_CELLS, numThreads);
+}
+
+int GameBatch::getNumGames() const {
+    return _numGames;
+}
+
+int GameBatch::getNumRunning() const {
+    return _numRunning;
+}
+
+const vector<int> &GameBatch::getShipLengths() const {
+    return _shipLengths;
+}
+
+const uint8_t *GameBatch::getBoards() const {
+    return _boards.data();
+}
+
+const int32_t *GameBatch::getDensities() const {
+    return _densities.data();
+}
+
+const int16_t *GameBatch::getLastMoves() const {
+    return _lastMoves.data();
+}
+
+const int16_t *GameBatch::getShots() const {
+    return _shots.data();
+}
+
+const uint32_t *GameBatch::getShipsAfloat() const {
+    return _shipsAfloat.data();
+}
+
+const int8_t *GameBatch::getTurns() const {
+    return _turns.data();
+}
+
+const int8_t *GameBatch::getWinners() const {
+    return _winners.data();
+}
+
+vector<int32_t> GameBatch::densityFor(const vector<RecordedMove> &moves, vector<int> shipLengths) {
+    IntelligentComputer computer("Analysis", shipLengths);
+    computer.setPlacementLearning(false);
+    computer.setFiringProfiling(false);
+    computer.setEndgameThreshold(0);
+
+    for(int i = 0; i < moves.size(); i++) {
+        const RecordedMove &move = moves.at(i);
+
+        if(move.xPos >= 0 && move.xPos < Board::GRID_SIZE && move.yPos >= 0 && move.yPos < Board::GRID_SIZE) {
+            computer.markShot(move.xPos, move.yPos, {move.hit, move.sunk ? move.sunkenIndex : -1});
+        }
+    }
+
+    // Working out the next move works out the density
+    computer.getMove();
+
+    vector<int32_t> density;
+    const vector<vector<int>> &grid = computer.getLastDensity();
+
+    for(int x = 0; x < Board::GRID_SIZE; x++) {
+        for(int y = 0; y < Board::GRID_SIZE; y++) {
+            density.push_back(grid.at(x).at(y));
+        }
+    }
+
+    return density;
+}
+
+// Same loop as playGame (see Simulation.h), a move at a time
+void GameBatch::_stepGame(int game, int moves) {
+    if(!_players.at(2 * game)) {
+        return;
+    }
+
+    for(int i = 0; i < moves && _winners.at(game) < 0; i++) {
+        int turn = _turns.at(game);
+        Player &shooter = *_players.at(2 * game + turn);
+        Player &target = *_players.at(2 * game + !turn);
+
+        int player = 2 * game + turn;
+        pair<int, int> move = shooter.getMove();
+
+        // A player that doesn't give a move forfeits
+        if(move.first < 0 || move.first >= Board::GRID_SIZE || move.second < 0 || move.second >= Board::GRID_SIZE) {
+            _winners.at(game) = !turn;
+            break;
+        }
+
+        IntelligentComputer *computer = dynamic_cast<IntelligentComputer *>(&shooter);
+        if(computer) {
+            const vector<vector<int>> &density = computer->getLastDensity();
+
+            for(int x = 0; x < Board::GRID_SIZE; x++) {
+                copy(density.at(x).begin(), density.at(x).end(),
+                     _densities.begin() + player * NUM_CELLS + x * Board::GRID_SIZE);
+            }
+        }
+
+        ShotOutcome outcome = target.fireShotAt(move.first, move.second);
+        shooter.markShot(move.first, move.second, outcome);
+
+        _boards.at(player * NUM_CELLS + cellIndex(move.first, move.second)) = outcome.hit ? HIT : MISS;
+        _lastMoves.at(2 * player) = move.first;
+        _lastMoves.at(2 * player + 1) = move.second;
+        _shots.at(player)++;
+
+        if(outcome.sunkenIndex >= 0 && outcome.sunkenIndex < 32) {
+            _shipsAfloat.at(player) &= ~(1u << outcome.sunkenIndex);
+        }
+
+        if(target.allShipsSunk()) {
+            shooter.reportGameover(true);
+            target.reportGameover(false);
+            _winners.at(game) = turn;
+        }
+
+        _turns.at(game) = !turn;
+    }
+}
@@ -0,0 +1,83 @@
+/* GameBatch.h
+ *
+ * Author: Colin Siles
+ *
+ * The GameBatch class plays many games at once, a few moves at a time, between players created by the
+ * PlayerRegistry. The state of every game is kept in flat arrays that are updated in place, so that other code (like
+ * the Python bindings, see pybattleship.cpp) can look straight at it between steps without copying anything. Steps
+ * are split between threads, a block of games to each
+*/
+
+#ifndef SFML_TEMPLATE_GAMEBATCH_H
+#define SFML_TEMPLATE_GAMEBATCH_H
+
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "GameRecord.h"
+#include "Player.h"
+
+using namespace std;
+
+class GameBatch {
+public:
+    GameBatch(int numGames, string firstPlayer = "intelligent", string secondPlayer = "intelligent",
+              vector<int> shipLengths = {5, 4, 4, 3, 2}, uint64_t seed = 0);
+
+    // Starts every game over, each seeded from the seed and its index. Returns false if the players couldn't be
+    // created (the batch then has no games running)
+    bool reset(uint64_t seed);
+
+    // Makes up to the given number of moves (one player's shot each) in every game still going. Returns the number of
+    // games still going
+    int step(int moves, int numThreads = 1);
+
+    // Plays every game to the end
+    void run(int numThreads = 1);
+
+    int getNumGames() const;
+    int getNumRunning() const;
+    const vector<int> &getShipLengths() const;
+
+    // The state of the games. Each array is the same size for as long as the batch exists, so pointers into them
+    // stay valid, and they're only changed by reset and step
+    const uint8_t *getBoards() const;       // [game][player][x][y]: what the player knows of the opponent's board
+    const int32_t *getDensities() const;    // [game][player][x][y]: the density behind the player's last move
+    const int16_t *getLastMoves() const;    // [game][player][2]: the player's last move, or -1, -1
+    const int16_t *getShots() const;        // [game][player]: shots the player has fired
+    const uint32_t *getShipsAfloat() const; // [game][player]: bit i set if the opponent's ship i is still afloat
+    const int8_t *getTurns() const;         // [game]: the player to move next
+    const int8_t *getWinners() const;       // [game]: the winner, or -1 while the game is still going
+
+    // Values in the boards array
+    static constexpr uint8_t UNKNOWN = 0;
+    static constexpr uint8_t MISS = 1;
+    static constexpr uint8_t HIT = 2;
+
+    // The density an IntelligentComputer would work out after the given moves had been made against an opponent
+    // with the given fleet, indexed [x][y]. The endgame solver is turned off, so the density is always worked out
+    static vector<int32_t> densityFor(const vector<RecordedMove> &moves, vector<int> shipLengths = {5, 4, 4, 3, 2});
+
+private:
+    int _numGames;
+    string _playerDescriptions[2];
+    vector<int> _shipLengths;
+
+    vector<unique_ptr<Player>> _players; // [game * 2 + player]
+    int _numRunning;
+
+    vector<uint8_t> _boards;
+    vector<int32_t> _densities;
+    vector<int16_t> _lastMoves;
+    vector<int16_t> _shots;
+    vector<uint32_t> _shipsAfloat;
+    vector<int8_t> _turns;
+    vector<int8_t> _winners;
+
+    // Makes up to the given number of moves in one game
+    void _stepGame(int game, int moves);
+};
+
+#endif //SFML_TEMPLATE_GAMEBATCH_H
@@ -0,0 +1,333 @@
+/* GameColumns.cpp
+ *
+ * Author: Colin Siles
+ *
+ * The GameColumns class reads a store of games kept column by column, and the GameColumnWriter class appends to one
+ * (see GameColumns.h for the layout)
+*/
+
+#include <cerrno>
+#include <cstring>
+#include <fstream>
+#include <iostream>
+
+#include <fcntl.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include "Board.h"
+#include "GameColumns.h"
+
+const vector<string> GameColumns::MOVE_COLUMNS = {"moves.game", "moves.index", "moves.x", "moves.y", "moves.outcome",
+                                                  "moves.player"};
+const vector<string> GameColumns::GAME_COLUMNS = {"games.winner", "games.first", "games.moves", "games.player0",
+                                                  "games.player1", "games.shots0", "games.shots1"};
+const string GameColumns::NAMES_FILE = "names.txt";
+
+// Where each column is in the writer's lists, and how many bytes a row of it takes
+static const int MOVE_GAME = 0, MOVE_INDEX = 1, MOVE_X = 2, MOVE_Y = 3, MOVE_OUTCOME = 4, MOVE_PLAYER = 5;
+static const int GAME_WINNER = 6, GAME_FIRST = 7, GAME_MOVES = 8, GAME_PLAYER = 9, GAME_SHOTS = 11;
+static const int COLUMN_WIDTHS[] = {4, 2, 1, 1, 1, 1, 1, 8, 2, 2, 2, 2, 2};
+
+// Adds a number to a column's rows, in the machine's byte order (the same way it's read back)
+template<typename T>
+static void put(string &rows, T value) {
+    rows.append((const char *) &value, sizeof(T));
+}
+
+static string columnFilename(string directory, int column) {
+    int moveColumns = GameColumns::MOVE_COLUMNS.size();
+    return directory + "/" + (column < moveColumns ? GameColumns::MOVE_COLUMNS.at(column)
+                                                   : GameColumns::GAME_COLUMNS.at(column - moveColumns));
+}
+
+static size_t fileSize(string filename) {
+    struct stat info;
+    return stat(filename.c_str(), &info) == 0 ? info.st_size : 0;
+}
+
+bool GameColumns::open(string directory) {
+    _names.clear();
+    ifstream names(directory + "/" + NAMES_FILE);
+    string name;
+    while(getline(names, name)) {
+        _names.push_back(name);
+    }
+
+    _numGames = 0;
+    _numMoves = 0;
+
+    // A store with no games has nothing worth mapping
+    if(fileSize(columnFilename(directory, GAME_WINNER)) == 0) {
+        return false;
+    }
+
+    _moveGames.open(columnFilename(directory, MOVE_GAME));
+    _moveIndices.open(columnFilename(directory, MOVE_INDEX));
+    _moveX.open(columnFilename(directory, MOVE_X));
+    _moveY.open(columnFilename(directory, MOVE_Y));
+    _moveOutcomes.open(columnFilename(directory, MOVE_OUTCOME));
+    _movePlayers.open(columnFilename(directory, MOVE_PLAYER));
+
+    _winners.open(columnFilename(directory, GAME_WINNER));
+    _firstMoves.open(columnFilename(directory, GAME_FIRST));
+    _moveCounts.open(columnFilename(directory, GAME_MOVES));
+    for(int i = 0; i < 2; i++) {
+        _players[i].open(columnFilename(directory, GAME_PLAYER + i));
+        _shots[i].open(columnFilename(directory, GAME_SHOTS + i));
+    }
+
+    // Only whole rows count, and only games whose moves were all written
+    _numMoves = min({_moveGames.size(), _moveIndices.size(), _moveX.size(), _moveY.size(), _moveOutcomes.size(),
+                     _movePlayers.size()});
+    _numGames = min({_winners.size(), _firstMoves.size(), _moveCounts.size(), _players[0].size(), _players[1].size(),
+                     _shots[0].size(), _shots[1].size()});
+
+    while(_numGames > 0 && getFirstMoves()[_numGames - 1] + getMoveCounts()[_numGames - 1] > _numMoves) {
+        _numGames--;
+    }
+
+    _numMoves = _numGames > 0 ? getFirstMoves()[_numGames - 1] + getMoveCounts()[_numGames - 1] : 0;
+
+    _moveGames.truncate(_numMoves);
+    _moveIndices.truncate(_numMoves);
+    _moveX.truncate(_numMoves);
+    _moveY.truncate(_numMoves);
+    _moveOutcomes.truncate(_numMoves);
+    _movePlayers.truncate(_numMoves);
+
+    _winners.truncate(_numGames);
+    _firstMoves.truncate(_numGames);
+    _moveCounts.truncate(_numGames);
+    for(int i = 0; i < 2; i++) {
+        _players[i].truncate(_numGames);
+        _shots[i].truncate(_numGames);
+    }
+
+    return _numGames > 0;
+}
+
+size_t GameColumns::getNumGames() const {
+    return _numGames;
+}
+
+size_t GameColumns::getNumMoves() const {
+    return _numMoves;
+}
+
+const vector<string> &GameColumns::getNames() const {
+    return _names;
+}
+
+const uint8_t *GameColumns::getWinners() const {
+    return _winners.data();
+}
+
+const uint64_t *GameColumns::getFirstMoves() const {
+    return _firstMoves.data();
+}
+
+const uint16_t *GameColumns::getMoveCounts() const {
+    return _moveCounts.data();
+}
+
+const uint16_t *GameColumns::getPlayers(int player) const {
+    return _players[player].data();
+}
+
+const uint16_t *GameColumns::getShots(int player) const {
+    return _shots[player].data();
+}
+
+const uint32_t *GameColumns::getMoveGames() const {
+    return _moveGames.data();
+}
+
+const uint16_t *GameColumns::getMoveIndices() const {
+    return _moveIndices.data();
+}
+
+const uint8_t *GameColumns::getMoveX() const {
+    return _moveX.data();
+}
+
+const uint8_t *GameColumns::getMoveY() const {
+    return _moveY.data();
+}
+
+const uint8_t *GameColumns::getMoveOutcomes() const {
+    return _moveOutcomes.data();
+}
+
+const uint8_t *GameColumns::getMovePlayers() const {
+    return _movePlayers.data();
+}
+
+GameColumnWriter::GameColumnWriter(string directory) {
+    _directory = directory;
+    _open = false;
+    _numGames = 0;
+    _numMoves = 0;
+
+    if(mkdir(directory.c_str(), 0755) != 0 && errno != EEXIST) {
+        cerr << "Failed to create " << directory << endl;
+        return;
+    }
+
+    // Carries on from the games already in the store
+    {
+        GameColumns existing;
+        existing.open(directory);
+
+        _numGames = existing.getNumGames();
+        _numMoves = existing.getNumMoves();
+
+        for(int i = 0; i < existing.getNames().size(); i++) {
+            _nameIds[existing.getNames().at(i)] = i;
+        }
+    }
+
+    int numColumns = GameColumns::MOVE_COLUMNS.size() + GameColumns::GAME_COLUMNS.size();
+
+    _open = true;
+    for(int i = 0; i < numColumns; i++) {
+        string filename = columnFilename(directory, i);
+        int fileDescriptor = ::open(filename.c_str(), O_WRONLY | O_CREAT | O_APPEND | O_CLOEXEC, 0644);
+
+        // Drops any rows left over from a writer that stopped partway through
+        size_t rows = i < GAME_WINNER ? _numMoves : _numGames;
+        if(fileDescriptor < 0 || ftruncate(fileDescriptor, rows * COLUMN_WIDTHS[i]) != 0) {
+            cerr << "Failed to open " << filename << endl;
+            _open = false;
+        }
+
+        _fileDescriptors.push_back(fileDescriptor);
+        _buffers.push_back("");
+    }
+}
+
+GameColumnWriter::~GameColumnWriter() {
+    flush();
+
+    for(int i = 0; i < _fileDescriptors.size(); i++) {
+        if(_fileDescriptors.at(i) >= 0) {
+            close(_fileDescriptors.at(i));
+        }
+    }
+}
+
+bool GameColumnWriter::isOpen() {
+    return _open;
+}
+
+size_t GameColumnWriter::getNumGames() {
+    return _numGames;
+}
+
+void GameColumnWriter::append(const GameRecord &record) {
+    if(!_open) {
+        return;
+    }
+
+    uint16_t players[2];
+    for(int i = 0; i < 2; i++) {
+        players[i] = _nameId(record.playerNames.size() > i ? record.playerNames.at(i) : "");
+    }
+
+    uint16_t shots[2] = {0, 0};
+    uint16_t numMoves = 0;
+
+    for(int i = 0; i < record.moves.size() && numMoves < UINT16_MAX; i++) {
+        const RecordedMove &move = record.moves.at(i);
+
+        if(move.player < 0 || move.player > 1 || move.xPos < 0 || move.xPos >= Board::GRID_SIZE || move.yPos < 0 ||
+           move.yPos >= Board::GRID_SIZE) {
+            continue;
+        }
+
+        uint8_t outcome = move.hit ? GameColumns::HIT : GameColumns::MISS;
+        if(move.sunk) {
+            bool known = move.sunkenIndex >= 0 && move.sunkenIndex < GameColumns::MAX_SHIPS;
+            outcome = known ? GameColumns::SUNK + move.sunkenIndex : GameColumns::SUNK_UNKNOWN;
+        }
+
+        put<uint32_t>(_buffers.at(MOVE_GAME), _numGames);
+        put<uint16_t>(_buffers.at(MOVE_INDEX), shots[move.player]++);
+        put<uint8_t>(_buffers.at(MOVE_X), move.xPos);
+        put<uint8_t>(_buffers.at(MOVE_Y), move.yPos);
+        put<uint8_t>(_buffers.at(MOVE_OUTCOME), outcome);
+        put<uint8_t>(_buffers.at(MOVE_PLAYER), move.player);
+        numMoves++;
+    }
+
+    put<uint8_t>(_buffers.at(GAME_WINNER), record.winner == 0 || record.winner == 1 ? record.winner
+                                                                                     : GameColumns::NO_WINNER);
+    put<uint64_t>(_buffers.at(GAME_FIRST), _numMoves);
+    put<uint16_t>(_buffers.at(GAME_MOVES), numMoves);
+    for(int i = 0; i < 2; i++) {
+        put<uint16_t>(_buffers.at(GAME_PLAYER + i), players[i]);
+        put<uint16_t>(_buffers.at(GAME_SHOTS + i), shots[i]);
+    }
+
+    _numGames++;
+    _numMoves += numMoves;
+
+    if(_buffers.at(MOVE_GAME).size() >= BATCH_MOVES * sizeof(uint32_t)) {
+        flush();
+    }
+}
+
+// Writes the names first and the game columns last, so a game is only in the store once everything it needs is
+void GameColumnWriter::flush() {
+    if(!_open) {
+        return;
+    }
+
+    if(!_newNames.empty()) {
+        ofstream names(_directory + "/" + GameColumns::NAMES_FILE, ios::app);
+        names << _newNames;
+        _newNames.clear();
+    }
+
+    for(int i = 0; i < _buffers.size(); i++) {
+        string &rows = _buffers.at(i);
+        int written = 0;
+
+        while(written < rows.size()) {
+            ssize_t result = write(_fileDescriptors.at(i), rows.data() + written, rows.size() - written);
+
+            if(result < 0 && errno == EINTR) {
+                continue;
+            }
+
+            if(result <= 0) {
+                cerr << "Failed to write to " << _directory << endl;
+                break;
+            }
+
+            written += result;
+        }
+
+        rows.clear();
+    }
+}
+
+int GameColumnWriter::_nameId(string name) {
+    auto found = _nameIds.find(name);
+    if(found != _nameIds.end()) {
+        return found->second;
+    }
+
+    int id = _nameIds.size();
+    _nameIds[name] = id;
+
+    // One name a line, so a name can't have line breaks of its own
+    for(int i = 0; i < name.size(); i++) {
+        if(name.at(i) == '\n' || name.at(i) == '\r') {
+            name.at(i) = ' ';
+        }
+    }
+    _newNames += name + "\n";
+
+    return id;
+}
@@ -0,0 +1,167 @@
+/* GameColumns.h
+ *
+ * Author: Colin Siles
+ *
+ * Archived games stored column by column, for analysis. Each column is its own file in the store's directory: a plain
+ * array of fixed size numbers (in the machine's byte order), which is memory mapped, so a query only reads the
+ * columns it needs, and scans them as arrays. The GameColumnWriter fills a store from GameRecords, and GameColumns
+ * reads it
+ *
+ * Game columns (one row per game):
+ *   games.winner    u8   Index of the player that won, or NO_WINNER
+ *   games.first     u64  Row of the game's first move in the move columns (a game's moves are all together)
+ *   games.moves     u16  Number of moves in the game
+ *   games.player0/1 u16  Each player's name, as a line number in names.txt
+ *   games.shots0/1  u16  Number of shots each player fired
+ *
+ * Move columns (one row per move, in the order they were made):
+ *   moves.game      u32  Row of the game the move was made in
+ *   moves.index     u16  Which of the player's shots it was (0 for the player's first shot)
+ *   moves.x/y       u8   The cell fired at
+ *   moves.outcome   u8   MISS, HIT, or SUNK plus the index of the ship sunk (SUNK_UNKNOWN if the record didn't say)
+ *   moves.player    u8   Index of the player that fired
+ *
+ * The writer only ever appends, writing the move columns before the game columns. If it's stopped partway through,
+ * the rows past the last complete game are ignored (and dropped the next time the store is written to)
+*/
+
+#ifndef SFML_TEMPLATE_GAMECOLUMNS_H
+#define SFML_TEMPLATE_GAMECOLUMNS_H
+
+#include <algorithm>
+#include <cstdint>
+#include <map>
+#include <string>
+#include <vector>
+
+#include "GameRecord.h"
+#include "MappedFile.h"
+
+using namespace std;
+
+// One column of a store, mapped for reading
+template<typename T>
+class Column {
+public:
+    Column() {
+        _size = 0;
+    }
+
+    // Maps the column's file. A missing or empty file is an empty column
+    void open(string filename) {
+        _size = _file.openReadOnly(filename) ? _file.size() / sizeof(T) : 0;
+    }
+
+    const T *data() const {
+        return (const T *) _file.data();
+    }
+
+    size_t size() const {
+        return _size;
+    }
+
+    // Ignores the rows past the given number
+    void truncate(size_t size) {
+        _size = min(_size, size);
+    }
+
+private:
+    MappedFile _file;
+    size_t _size;
+};
+
+class GameColumns {
+public:
+    // Maps the store in the given directory. Returns false if it has no games
+    bool open(string directory);
+
+    size_t getNumGames() const;
+    size_t getNumMoves() const;
+
+    // The names of the players, indexed by the player columns
+    const vector<string> &getNames() const;
+
+    // Game columns
+    const uint8_t *getWinners() const;
+    const uint64_t *getFirstMoves() const;
+    const uint16_t *getMoveCounts() const;
+    const uint16_t *getPlayers(int player) const;
+    const uint16_t *getShots(int player) const;
+
+    // Move columns
+    const uint32_t *getMoveGames() const;
+    const uint16_t *getMoveIndices() const;
+    const uint8_t *getMoveX() const;
+    const uint8_t *getMoveY() const;
+    const uint8_t *getMoveOutcomes() const;
+    const uint8_t *getMovePlayers() const;
+
+    // Values of the winner and outcome columns
+    static const uint8_t NO_WINNER = 0xFF;
+    static const uint8_t MISS = 0;
+    static const uint8_t HIT = 1;
+    static const uint8_t SUNK = 2;
+    static const uint8_t SUNK_UNKNOWN = 0xFF;
+    static const int MAX_SHIPS = SUNK_UNKNOWN - SUNK;
+
+    // The files making up a store, in the order the writer writes them
+    static const vector<string> MOVE_COLUMNS;
+    static const vector<string> GAME_COLUMNS;
+    static const string NAMES_FILE;
+
+private:
+    Column<uint8_t> _winners;
+    Column<uint64_t> _firstMoves;
+    Column<uint16_t> _moveCounts;
+    Column<uint16_t> _players[2];
+    Column<uint16_t> _shots[2];
+
+    Column<uint32_t> _moveGames;
+    Column<uint16_t> _moveIndices;
+    Column<uint8_t> _moveX;
+    Column<uint8_t> _moveY;
+    Column<uint8_t> _moveOutcomes;
+    Column<uint8_t> _movePlayers;
+
+    vector<string> _names;
+    size_t _numGames;
+    size_t _numMoves;
+};
+
+class GameColumnWriter {
+public:
+    // Appends to the store in the given directory, creating it if needed
+    GameColumnWriter(string directory);
+    ~GameColumnWriter(); // Destructor, which writes the last games
+
+    bool isOpen();
+    size_t getNumGames();
+
+    // Adds a game. Moves off the board are left out. Games are written a batch at a time
+    void append(const GameRecord &record);
+
+    // Writes the games added so far (as well as whenever enough moves have built up)
+    void flush();
+
+    // Games are written once they have this many moves between them
+    static const int BATCH_MOVES = 1 << 16;
+
+private:
+    string _directory;
+    bool _open;
+
+    // One file for each column (move columns first, then game columns), and the rows waiting to be written to it
+    vector<int> _fileDescriptors;
+    vector<string> _buffers;
+
+    // Every name so far, and the ones not written to names.txt yet
+    map<string, int> _nameIds;
+    string _newNames;
+
+    size_t _numGames;
+    size_t _numMoves;
+
+    int _nameId(string name);
+};
+
+#endif //SFML_TEMPLATE_GAMECOLUMNS_H
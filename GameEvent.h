@@ -0,0 +1,39 @@
+/* GameEvent.h
+ *
+ * Author: Colin Siles
+ *
+ * The GameEvent struct describes something that happened in a game, as published on a GameEventBus. Every event has
+ * the same fixed size, so that events can be passed around in an EventRing without allocating
+*/
+
+#ifndef SFML_TEMPLATE_GAMEEVENT_H
+#define SFML_TEMPLATE_GAMEEVENT_H
+
+#include <cstdint>
+
+// GAME_STARTED:   seed (0 if the game wasn't given one), playerNames
+// SHIPS_PLACED:   player (once for each player)
+// SHOT_FIRED:     player, xPos, yPos (published before the shot's outcome is known)
+// SHOT_OUTCOME:   player, xPos, yPos, hit, sunkenIndex (-1 unless the shot sank a ship)
+// SHIP_SUNK:      player (who sank it), xPos, yPos (the shot that sank it), sunkenIndex
+// MOVE_TIMED:     player, milliseconds (how long they took to choose the move)
+// GAME_OVER:      player (the winner, or -1 if the game ended without one)
+enum GameEventType {GAME_STARTED, SHIPS_PLACED, SHOT_FIRED, SHOT_OUTCOME, SHIP_SUNK, MOVE_TIMED, GAME_OVER};
+
+struct GameEvent {
+    GameEventType type;
+    uint64_t gameId;    // Set by the game, so one bus can carry the events of many games
+    int player;         // 0 for the first player, 1 for the second
+    int xPos;
+    int yPos;
+    bool hit;
+    int sunkenIndex;
+    double milliseconds;
+    uint64_t seed;
+
+    // Names are kept short and inline, so the event doesn't need to allocate (longer names are cut off)
+    static const int NAME_LENGTH = 24;
+    char playerNames[2][NAME_LENGTH];
+};
+
+#endif //SFML_TEMPLATE_GAMEEVENT_H
@@ -0,0 +1,249 @@
+/* GameEventBus.cpp
+ *
+ * Author: Colin Siles
+ *
+ * The GameEventBus class carries game events from games to subscribers. Each subscriber has its own EventRing and its
+ * own thread: publishing an event just pushes it onto the rings, and the subscribers' threads handle it from there.
+ * With no subscribers, publishing is a single atomic load, so games pay close to nothing for the bus. Publishing never
+ * waits for a subscriber: if its ring is full, events spill into an overflow list until it catches up. Subscribers
+ * that write files (like the battlelogs) are told when to write out what they have by their FlushPolicy
+ *
+ * Subscribers have to be added before the games publishing to the bus start, and stay subscribed until the bus is
+ * destroyed (which handles any events still waiting, then stops the subscribers' threads)
+*/
+
+#include <algorithm>
+#include <chrono>
+
+#include "GameEventBus.h"
+
+// A sleeping subscriber's thread is woken once a quarter of its ring is waiting (or a game ends, for subscribers
+// flushed after each game)
+static const int WAKE_SHARE = 4;
+
+// Events handled between checks of the clock, for subscribers flushed on a timer
+static const int TIMER_CHECK_EVENTS = 64;
+
+GameEventBus::Subscription::Subscription(GameEventSubscriber *subscriber, FlushPolicy flushPolicy, int capacity,
+                                         bool dropWhenFull) : ring(capacity) {
+    this->subscriber = subscriber;
+    this->flushPolicy = flushPolicy;
+    this->dropWhenFull = dropWhenFull;
+    overflowing = false;
+    published = 0;
+    handled = 0;
+    flushRequested = false;
+    flushTarget = 0;
+    flushedThrough = 0;
+    sleeping = false;
+    wakeEvents = ring.capacity() / WAKE_SHARE;
+}
+
+GameEventBus::GameEventBus() {
+    _numSubscribers = 0;
+    _dropped = 0;
+    _stopping = false;
+}
+
+GameEventBus::~GameEventBus() {
+    flush();
+
+    _stopping = true;
+
+    for(int i = 0; i < _subscriptions.size(); i++) {
+        _wake(_subscriptions.at(i).get());
+        _subscriptions.at(i)->worker.join();
+    }
+}
+
+void GameEventBus::subscribe(GameEventSubscriber *subscriber, FlushPolicy flushPolicy, int capacity,
+                             bool dropWhenFull) {
+    _subscriptions.push_back(make_unique<Subscription>(subscriber, flushPolicy, capacity, dropWhenFull));
+
+    Subscription *subscription = _subscriptions.back().get();
+    subscription->worker = thread(&GameEventBus::_work, this, subscription);
+
+    _numSubscribers.store(_subscriptions.size(), memory_order_release);
+}
+
+void GameEventBus::publish(const GameEvent &event) {
+    int numSubscribers = _numSubscribers.load(memory_order_acquire);
+
+    for(int i = 0; i < numSubscribers; i++) {
+        Subscription *subscription = _subscriptions.at(i).get();
+
+        // The usual case is that there's room in the ring. Otherwise the event goes in the overflow list, unless the
+        // subscriber emptied the ring and ended the overflow while we were getting the lock (the lock is only held
+        // briefly by the subscriber's thread, never while it handles events)
+        if(subscription->overflowing.load(memory_order_acquire) || !subscription->ring.tryPush(event)) {
+            if(subscription->dropWhenFull) {
+                _dropped++;
+                continue;
+            }
+
+            lock_guard<mutex> lock(subscription->overflowMutex);
+
+            if(subscription->overflowing || !subscription->ring.tryPush(event)) {
+                subscription->overflow.push_back(event);
+                subscription->overflowing.store(true, memory_order_release);
+            }
+        }
+
+        // Counted before looking at whether the thread is sleeping, and it checks the count after saying it is, so
+        // one of the two always sees the other
+        long waiting = ++subscription->published - subscription->handled.load();
+
+        bool gameOver = event.type == GAME_OVER && subscription->flushPolicy.mode == FLUSH_PER_GAME;
+
+        if((waiting >= subscription->wakeEvents || gameOver) && subscription->sleeping.load() &&
+           subscription->sleeping.exchange(false)) {
+            _wake(subscription);
+        }
+    }
+}
+
+// Asks each subscriber's thread to flush once it has handled everything published so far, and waits for it to say
+// it has
+void GameEventBus::flush() {
+    for(int i = 0; i < _subscriptions.size(); i++) {
+        Subscription *subscription = _subscriptions.at(i).get();
+        unique_lock<mutex> lock(subscription->flushMutex);
+
+        long target = subscription->published.load();
+        subscription->flushTarget = max(subscription->flushTarget, target);
+        subscription->flushRequested = true;
+
+        lock.unlock();
+        _wake(subscription);
+        lock.lock();
+
+        subscription->flushed.wait(lock, [&]() {
+            return subscription->flushedThrough >= target;
+        });
+    }
+}
+
+long GameEventBus::numDropped() const {
+    return _dropped;
+}
+
+void GameEventBus::_work(Subscription *subscription) {
+    GameEventSubscriber *subscriber = subscription->subscriber;
+    const FlushPolicy &policy = subscription->flushPolicy;
+
+    GameEvent event;
+    vector<GameEvent> spilled;
+
+    // Events handled since the subscriber was last flushed, and when that was
+    long unflushed = 0;
+    chrono::steady_clock::time_point lastFlush = chrono::steady_clock::now();
+
+    auto flushSubscriber = [&]() {
+        subscriber->flush();
+        unflushed = 0;
+        lastFlush = chrono::steady_clock::now();
+    };
+
+    auto timerDue = [&]() {
+        return policy.mode == FLUSH_ON_TIMER && unflushed > 0 &&
+               chrono::steady_clock::now() - lastFlush >= chrono::milliseconds(policy.milliseconds);
+    };
+
+    // Hands an event to the subscriber, and flushes it afterwards if the policy says to
+    auto handle = [&](const GameEvent &event) {
+        subscriber->onEvent(event);
+        subscription->handled++;
+        unflushed++;
+
+        if((policy.mode == FLUSH_PER_GAME && event.type == GAME_OVER) ||
+           (policy.mode == FLUSH_EVERY_N_EVENTS && unflushed >= policy.events) ||
+           (unflushed % TIMER_CHECK_EVENTS == 0 && timerDue())) {
+            flushSubscriber();
+        }
+    };
+
+    while(true) {
+        if(subscription->ring.tryPop(event)) {
+            handle(event);
+            continue;
+        }
+
+        if(subscription->overflowing.load(memory_order_acquire)) {
+            _takeOverflow(subscription, spilled);
+
+            for(int i = 0; i < spilled.size(); i++) {
+                handle(spilled.at(i));
+            }
+
+            spilled.clear();
+            continue;
+        }
+
+        // Caught up, so this is when to flush if it's been asked for (once everything flush is waiting for has been
+        // handled), or it's time
+        if(subscription->flushRequested) {
+            unique_lock<mutex> lock(subscription->flushMutex);
+            long target = subscription->flushTarget;
+            lock.unlock();
+
+            if(subscription->handled.load() >= target) {
+                flushSubscriber();
+
+                lock.lock();
+                subscription->flushedThrough = target;
+                subscription->flushRequested = subscription->flushTarget > target;
+                lock.unlock();
+
+                subscription->flushed.notify_all();
+            }
+        } else if(timerDue()) {
+            flushSubscriber();
+        }
+
+        // The destructor flushes before stopping, so once it says stop, there's nothing left to handle
+        if(_stopping) {
+            return;
+        }
+
+        // Sleep until woken, or until the timer says to flush (a timer with nothing handled since the last flush
+        // still wakes the thread every so often, for any events that haven't made a batch). Everything that wakes the
+        // thread changes what's checked here before taking the lock to wake it, so a batch, the end of a game, a flush
+        // or the destructor can't be missed
+        subscription->sleeping = true;
+
+        {
+            unique_lock<mutex> lock(subscription->wakeMutex);
+
+            if(!subscription->flushRequested && !_stopping &&
+               subscription->handled.load() == subscription->published.load()) {
+                if(policy.mode == FLUSH_ON_TIMER) {
+                    chrono::steady_clock::time_point timer = unflushed > 0 ? lastFlush : chrono::steady_clock::now();
+                    subscription->wake.wait_until(lock, timer + chrono::milliseconds(policy.milliseconds));
+                } else {
+                    subscription->wake.wait(lock);
+                }
+            }
+        }
+
+        subscription->sleeping = false;
+    }
+}
+
+void GameEventBus::_wake(Subscription *subscription) {
+    lock_guard<mutex> lock(subscription->wakeMutex);
+    subscription->wake.notify_one();
+}
+
+// Anything still in the ring was published before the overflow started, so it comes first
+void GameEventBus::_takeOverflow(Subscription *subscription, vector<GameEvent> &events) {
+    lock_guard<mutex> lock(subscription->overflowMutex);
+
+    GameEvent event;
+    while(subscription->ring.tryPop(event)) {
+        events.push_back(event);
+    }
+
+    events.insert(events.end(), subscription->overflow.begin(), subscription->overflow.end());
+    subscription->overflow.clear();
+    subscription->overflowing.store(false, memory_order_release);
+}
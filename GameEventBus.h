@@ -0,0 +1,120 @@
+/* GameEventBus.h
+ *
+ * Author: Colin Siles
+ *
+ * The GameEventBus class carries game events from games to subscribers. Each subscriber has its own EventRing and its
+ * own thread: publishing an event just pushes it onto the rings, and the subscribers' threads handle it from there.
+ * With no subscribers, publishing is a single atomic load, so games pay close to nothing for the bus. Publishing never
+ * waits for a subscriber: if its ring is full, events spill into an overflow list until it catches up. Subscribers
+ * that write files (like the battlelogs) are told when to write out what they have by their FlushPolicy
+ *
+ * Subscribers have to be added before the games publishing to the bus start, and stay subscribed until the bus is
+ * destroyed (which handles any events still waiting, then stops the subscribers' threads)
+*/
+
+#ifndef SFML_TEMPLATE_GAMEEVENTBUS_H
+#define SFML_TEMPLATE_GAMEEVENTBUS_H
+
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#include "EventRing.h"
+#include "GameEvent.h"
+#include "GameEventSubscriber.h"
+
+using namespace std;
+
+// When a subscriber is told to flush: after each game, after every so many events, or every so often (if it has
+// handled anything since the last time)
+enum FlushMode {FLUSH_PER_GAME, FLUSH_EVERY_N_EVENTS, FLUSH_ON_TIMER};
+
+struct FlushPolicy {
+    FlushMode mode = FLUSH_PER_GAME;
+    int events = 4096;        // For FLUSH_EVERY_N_EVENTS
+    int milliseconds = 1000;  // For FLUSH_ON_TIMER
+};
+
+class GameEventBus {
+public:
+    GameEventBus();
+    ~GameEventBus(); // Destructor, which handles the remaining events and stops the subscribers' threads
+
+    // Adds a subscriber, with room for the given number of events waiting for it. When the ring is full, events either
+    // go into the overflow list, or are dropped (for subscribers like spectators, that can afford to miss some)
+    void subscribe(GameEventSubscriber *subscriber, FlushPolicy flushPolicy = FlushPolicy(), int capacity = 4096,
+                   bool dropWhenFull = false);
+
+    // True if anything is subscribed. Games check this before building an event, so they skip even that
+    bool hasSubscribers() const {
+        return _numSubscribers.load(memory_order_acquire) > 0;
+    }
+
+    // Passes the event to every subscriber. Safe to call from any number of threads at once
+    void publish(const GameEvent &event);
+
+    // Blocks until every event published so far has been handled, and the subscribers have been flushed
+    void flush();
+
+    // Number of events dropped because a subscriber's ring was full
+    long numDropped() const;
+
+private:
+    struct Subscription {
+        GameEventSubscriber *subscriber;
+        FlushPolicy flushPolicy;
+        EventRing<GameEvent> ring;
+        bool dropWhenFull;
+
+        // Events that didn't fit in the ring. While there are any, new events go here too, so they stay in order
+        mutex overflowMutex;
+        deque<GameEvent> overflow;
+        atomic<bool> overflowing;
+
+        // Counts of events pushed and handled, so flush can tell when the subscriber has caught up
+        atomic<long> published;
+        atomic<long> handled;
+
+        // Set by flush, along with how many events have to be handled before the subscriber is flushed, and cleared by
+        // the subscriber's thread once it has flushed the subscriber that far. Flush waits on flushed until then
+        atomic<bool> flushRequested;
+        mutex flushMutex;
+        condition_variable flushed;
+        long flushTarget;
+        long flushedThrough;
+
+        // The subscriber's thread sleeps once it has caught up, until publishing wakes it: once a batch of events is
+        // waiting, or a game ends (if it's flushed after each one), so a steady trickle of events doesn't wake it for
+        // each one. Flush, the destructor and the flush timer wake it too. Only the first publisher to find it sleeping
+        // wakes it
+        mutex wakeMutex;
+        condition_variable wake;
+        atomic<bool> sleeping;
+        long wakeEvents;
+
+        thread worker;
+
+        Subscription(GameEventSubscriber *subscriber, FlushPolicy flushPolicy, int capacity, bool dropWhenFull);
+    };
+
+    vector<unique_ptr<Subscription>> _subscriptions;
+    atomic<int> _numSubscribers;
+    atomic<long> _dropped;
+    atomic<bool> _stopping;
+
+    // Loop each subscription's thread runs, handing events to the subscriber
+    void _work(Subscription *subscription);
+
+    // Wakes the subscription's thread
+    void _wake(Subscription *subscription);
+
+    // Takes everything in the ring and the overflow list, in order, and ends the overflow
+    void _takeOverflow(Subscription *subscription, vector<GameEvent> &events);
+};
+
+#endif //SFML_TEMPLATE_GAMEEVENTBUS_H
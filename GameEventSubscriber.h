@@ -0,0 +1,27 @@
+/* GameEventSubscriber.h
+ *
+ * Author: Colin Siles
+ *
+ * The GameEventSubscriber class is the interface for anything that consumes game events from a GameEventBus
+ * (loggers like the Battlelog, stats collectors, spectators, trainers...). Each subscriber gets its events on its own
+ * thread, in the order each game published them, so it never slows the games down
+*/
+
+#ifndef SFML_TEMPLATE_GAMEEVENTSUBSCRIBER_H
+#define SFML_TEMPLATE_GAMEEVENTSUBSCRIBER_H
+
+#include "GameEvent.h"
+
+class GameEventSubscriber {
+public:
+    virtual ~GameEventSubscriber() = default;
+
+    // Called on the subscriber's thread for every event published to the bus
+    virtual void onEvent(const GameEvent &event) = 0;
+
+    // Called on the subscriber's thread when what it has handled so far should be written out (how often depends on
+    // the FlushPolicy it was subscribed with). Subscribers that write files should buffer until then
+    virtual void flush() {}
+};
+
+#endif //SFML_TEMPLATE_GAMEEVENTSUBSCRIBER_H
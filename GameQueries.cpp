@@ -0,0 +1,354 @@
+/* GameQueries.cpp
+ *
+ * Author: Colin Siles
+ *
+ * The GameQueries class answers questions about a store of archived games, and the QueryTable class holds and
+ * prints the answers
+*/
+
+#include <algorithm>
+#include <cstdio>
+
+#include "Board.h"
+#include "GameQueries.h"
+#include "Simulation.h"
+
+// Formats a number with the given number of decimal places
+static string format(double value, int decimals) {
+    char text[32];
+    snprintf(text, sizeof(text), "%.*f", decimals, value);
+    return text;
+}
+
+QueryTable::QueryTable(vector<string> columns) {
+    _columns = columns;
+}
+
+void QueryTable::addRow(vector<string> row) {
+    row.resize(_columns.size());
+    _rows.push_back(row);
+}
+
+int QueryTable::getNumRows() const {
+    return _rows.size();
+}
+
+// The first column is lined up on the left, and the rest (the numbers) on the right
+void QueryTable::print(ostream &out) const {
+    vector<int> widths;
+    for(int i = 0; i < _columns.size(); i++) {
+        widths.push_back(_columns.at(i).size());
+
+        for(int j = 0; j < _rows.size(); j++) {
+            widths.at(i) = max(widths.at(i), (int) _rows.at(j).at(i).size());
+        }
+    }
+
+    auto printRow = [&](const vector<string> &row) {
+        for(int i = 0; i < row.size(); i++) {
+            string padding(widths.at(i) - row.at(i).size(), ' ');
+            out << (i == 0 ? row.at(i) + padding : "  " + padding + row.at(i));
+        }
+        out << "\n";
+    };
+
+    printRow(_columns);
+
+    int totalWidth = 0;
+    for(int i = 0; i < widths.size(); i++) {
+        totalWidth += widths.at(i) + (i == 0 ? 0 : 2);
+    }
+    out << string(totalWidth, '-') << "\n";
+
+    for(int i = 0; i < _rows.size(); i++) {
+        printRow(_rows.at(i));
+    }
+}
+
+void QueryTable::printCsv(ostream &out) const {
+    auto printRow = [&](const vector<string> &row) {
+        for(int i = 0; i < row.size(); i++) {
+            string field = row.at(i);
+
+            // Fields with commas or quotes in them (only ever names) are quoted, with their quotes doubled
+            if(field.find_first_of(",\"") != string::npos) {
+                string quoted = "\"";
+                for(int j = 0; j < field.size(); j++) {
+                    quoted += field.at(j) == '"' ? "\"\"" : string(1, field.at(j));
+                }
+                field = quoted + "\"";
+            }
+
+            out << (i == 0 ? "" : ",") << field;
+        }
+        out << "\n";
+    };
+
+    printRow(_columns);
+    for(int i = 0; i < _rows.size(); i++) {
+        printRow(_rows.at(i));
+    }
+}
+
+GameQueries::GameQueries(const GameColumns &store, int numThreads) : _store(store) {
+    _numThreads = max(numThreads, 1);
+}
+
+QueryTable GameQueries::shotsToWin() {
+    struct Totals {
+        long games = 0;
+        long wins = 0;
+        long winningShots = 0;
+        int fewestShots = INT32_MAX;
+        int mostShots = 0;
+    };
+
+    int numNames = _store.getNames().size();
+    vector<vector<Totals>> partials(_numJobs(), vector<Totals>(numNames));
+
+    const uint8_t *winners = _store.getWinners();
+    const uint16_t *players[2] = {_store.getPlayers(0), _store.getPlayers(1)};
+    const uint16_t *shots[2] = {_store.getShots(0), _store.getShots(1)};
+
+    _scan([&](int job, size_t firstGame, size_t endGame) {
+        vector<Totals> &totals = partials.at(job);
+
+        for(size_t game = firstGame; game < endGame; game++) {
+            for(int i = 0; i < 2; i++) {
+                if(players[i][game] < numNames) {
+                    totals[players[i][game]].games++;
+                }
+            }
+
+            uint8_t winner = winners[game];
+            if(winner > 1 || players[winner][game] >= numNames) {
+                continue;
+            }
+
+            Totals &winnerTotals = totals[players[winner][game]];
+            int winningShots = shots[winner][game];
+
+            winnerTotals.wins++;
+            winnerTotals.winningShots += winningShots;
+            winnerTotals.fewestShots = min(winnerTotals.fewestShots, winningShots);
+            winnerTotals.mostShots = max(winnerTotals.mostShots, winningShots);
+        }
+    });
+
+    vector<Totals> totals(numNames);
+    for(int i = 0; i < partials.size(); i++) {
+        for(int j = 0; j < numNames; j++) {
+            const Totals &partial = partials.at(i).at(j);
+
+            totals.at(j).games += partial.games;
+            totals.at(j).wins += partial.wins;
+            totals.at(j).winningShots += partial.winningShots;
+            totals.at(j).fewestShots = min(totals.at(j).fewestShots, partial.fewestShots);
+            totals.at(j).mostShots = max(totals.at(j).mostShots, partial.mostShots);
+        }
+    }
+
+    // Strategies that win in the fewest shots first, and those that never won last
+    vector<int> order;
+    for(int i = 0; i < numNames; i++) {
+        if(totals.at(i).games > 0) {
+            order.push_back(i);
+        }
+    }
+
+    auto averageShots = [&](int name) {
+        return totals.at(name).wins > 0 ? (double) totals.at(name).winningShots / totals.at(name).wins : 1e9;
+    };
+    stable_sort(order.begin(), order.end(), [&](int first, int second) {
+        return averageShots(first) < averageShots(second);
+    });
+
+    QueryTable table({"strategy", "games", "wins", "win %", "avg shots to win", "fewest", "most"});
+    for(int i = 0; i < order.size(); i++) {
+        const Totals &nameTotals = totals.at(order.at(i));
+        bool won = nameTotals.wins > 0;
+
+        table.addRow({_store.getNames().at(order.at(i)), to_string(nameTotals.games), to_string(nameTotals.wins),
+                      format(100.0 * nameTotals.wins / nameTotals.games, 1),
+                      won ? format(averageShots(order.at(i)), 2) : "-",
+                      won ? to_string(nameTotals.fewestShots) : "-", won ? to_string(nameTotals.mostShots) : "-"});
+    }
+
+    return table;
+}
+
+QueryTable GameQueries::firstMoves(int shots, int limit, string player) {
+    const int numCells = Board::GRID_SIZE * Board::GRID_SIZE;
+
+    int filter = _playerFilter(player);
+    vector<vector<long>> fired(_numJobs(), vector<long>(numCells));
+    vector<vector<long>> hits(_numJobs(), vector<long>(numCells));
+
+    const uint16_t *indices = _store.getMoveIndices();
+    const uint8_t *xPositions = _store.getMoveX();
+    const uint8_t *yPositions = _store.getMoveY();
+    const uint8_t *outcomes = _store.getMoveOutcomes();
+    const uint8_t *movePlayers = _store.getMovePlayers();
+    const uint32_t *moveGames = _store.getMoveGames();
+    const uint16_t *players[2] = {_store.getPlayers(0), _store.getPlayers(1)};
+
+    _scan([&](int job, size_t firstGame, size_t endGame) {
+        size_t firstMove = _store.getFirstMoves()[firstGame];
+        size_t endMove = _store.getFirstMoves()[endGame - 1] + _store.getMoveCounts()[endGame - 1];
+
+        long *jobFired = fired.at(job).data();
+        long *jobHits = hits.at(job).data();
+
+        // Adds up every move, counting the ones that don't match as zero, rather than branching on each of them
+        for(size_t i = firstMove; i < endMove; i++) {
+            int counted = indices[i] < shots;
+            if(filter != -1) {
+                counted &= players[movePlayers[i] & 1][moveGames[i]] == filter;
+            }
+
+            int cell = xPositions[i] * Board::GRID_SIZE + yPositions[i];
+            jobFired[cell] += counted;
+            jobHits[cell] += counted & (outcomes[i] != GameColumns::MISS);
+        }
+    });
+
+    vector<long> totalFired(numCells);
+    vector<long> totalHits(numCells);
+    for(int i = 0; i < fired.size(); i++) {
+        for(int cell = 0; cell < numCells; cell++) {
+            totalFired.at(cell) += fired.at(i).at(cell);
+            totalHits.at(cell) += hits.at(i).at(cell);
+        }
+    }
+
+    vector<int> cells;
+    for(int cell = 0; cell < numCells; cell++) {
+        if(totalFired.at(cell) > 0) {
+            cells.push_back(cell);
+        }
+    }
+
+    auto hitRate = [&](int cell) {
+        return (double) totalHits.at(cell) / totalFired.at(cell);
+    };
+    stable_sort(cells.begin(), cells.end(), [&](int first, int second) {
+        return hitRate(first) > hitRate(second);
+    });
+
+    if(limit > 0 && cells.size() > limit) {
+        cells.resize(limit);
+    }
+
+    QueryTable table({"cell", "x", "y", "shots", "hits", "hit %"});
+    for(int i = 0; i < cells.size(); i++) {
+        int cell = cells.at(i);
+        int xPos = cell / Board::GRID_SIZE;
+        int yPos = cell % Board::GRID_SIZE;
+
+        table.addRow({"(" + to_string(xPos) + ", " + to_string(yPos) + ")", to_string(xPos), to_string(yPos),
+                      to_string(totalFired.at(cell)), to_string(totalHits.at(cell)), format(100 * hitRate(cell), 2)});
+    }
+
+    return table;
+}
+
+QueryTable GameQueries::sinkOrder(string player) {
+    int filter = _playerFilter(player);
+
+    // How many times each ship was sunk in each position, as [ship * MAX_SINK_SHIPS + position]
+    vector<vector<long>> partials(_numJobs(), vector<long>(MAX_SINK_SHIPS * MAX_SINK_SHIPS));
+
+    const uint8_t *outcomes = _store.getMoveOutcomes();
+    const uint8_t *movePlayers = _store.getMovePlayers();
+    const uint16_t *players[2] = {_store.getPlayers(0), _store.getPlayers(1)};
+
+    _scan([&](int job, size_t firstGame, size_t endGame) {
+        long *counts = partials.at(job).data();
+
+        for(size_t game = firstGame; game < endGame; game++) {
+            size_t firstMove = _store.getFirstMoves()[game];
+            size_t endMove = firstMove + _store.getMoveCounts()[game];
+            int sunk[2] = {0, 0};
+
+            for(size_t i = firstMove; i < endMove; i++) {
+                if(outcomes[i] < GameColumns::SUNK) {
+                    continue;
+                }
+
+                int shooter = movePlayers[i] & 1;
+                int position = sunk[shooter]++;
+                int ship = outcomes[i] - GameColumns::SUNK;
+
+                if(outcomes[i] != GameColumns::SUNK_UNKNOWN && ship < MAX_SINK_SHIPS && position < MAX_SINK_SHIPS &&
+                   (filter == -1 || players[shooter][game] == filter)) {
+                    counts[ship * MAX_SINK_SHIPS + position]++;
+                }
+            }
+        }
+    });
+
+    vector<long> counts(MAX_SINK_SHIPS * MAX_SINK_SHIPS);
+    for(int i = 0; i < partials.size(); i++) {
+        for(int j = 0; j < counts.size(); j++) {
+            counts.at(j) += partials.at(i).at(j);
+        }
+    }
+
+    // Only as many positions as any ship was sunk in
+    int numPositions = 0;
+    for(int i = 0; i < counts.size(); i++) {
+        if(counts.at(i) > 0) {
+            numPositions = max(numPositions, i % MAX_SINK_SHIPS + 1);
+        }
+    }
+
+    vector<string> columns = {"ship", "sunk", "avg position"};
+    for(int position = 0; position < numPositions; position++) {
+        columns.push_back("#" + to_string(position + 1) + " %");
+    }
+
+    QueryTable table(columns);
+    for(int ship = 0; ship < MAX_SINK_SHIPS; ship++) {
+        long total = 0;
+        long positionTotal = 0;
+
+        for(int position = 0; position < numPositions; position++) {
+            total += counts.at(ship * MAX_SINK_SHIPS + position);
+            positionTotal += counts.at(ship * MAX_SINK_SHIPS + position) * (position + 1);
+        }
+
+        if(total == 0) {
+            continue;
+        }
+
+        vector<string> row = {to_string(ship), to_string(total), format((double) positionTotal / total, 2)};
+        for(int position = 0; position < numPositions; position++) {
+            row.push_back(format(100.0 * counts.at(ship * MAX_SINK_SHIPS + position) / total, 1));
+        }
+
+        table.addRow(row);
+    }
+
+    return table;
+}
+
+int GameQueries::_numJobs() {
+    return (_store.getNumGames() + GAMES_PER_JOB - 1) / GAMES_PER_JOB;
+}
+
+void GameQueries::_scan(const function<void(int, size_t, size_t)> &scan) {
+    runJobs(_numJobs(), _numThreads, [&](int job) {
+        size_t firstGame = (size_t) job * GAMES_PER_JOB;
+        scan(job, firstGame, min(firstGame + GAMES_PER_JOB, _store.getNumGames()));
+    });
+}
+
+int GameQueries::_playerFilter(string player) {
+    if(player.empty()) {
+        return -1;
+    }
+
+    const vector<string> &names = _store.getNames();
+    auto found = find(names.begin(), names.end(), player);
+    return found == names.end() ? -2 : found - names.begin();
+}
@@ -0,0 +1,73 @@
+/* GameQueries.h
+ *
+ * Author: Colin Siles
+ *
+ * The GameQueries class answers questions about a store of archived games (see GameColumns.h). Each query scans
+ * only the columns it needs, straight through the mapped arrays, in blocks of games split between threads, and then
+ * adds up what each block found. The answers come back as QueryTables, which can be printed as text or CSV
+*/
+
+#ifndef SFML_TEMPLATE_GAMEQUERIES_H
+#define SFML_TEMPLATE_GAMEQUERIES_H
+
+#include <functional>
+#include <ostream>
+#include <string>
+#include <vector>
+
+#include "GameColumns.h"
+
+using namespace std;
+
+class QueryTable {
+public:
+    QueryTable(vector<string> columns);
+
+    void addRow(vector<string> row);
+    int getNumRows() const;
+
+    // Prints the table with its columns lined up, or as CSV (with a header row)
+    void print(ostream &out) const;
+    void printCsv(ostream &out) const;
+
+private:
+    vector<string> _columns;
+    vector<vector<string>> _rows;
+};
+
+class GameQueries {
+public:
+    GameQueries(const GameColumns &store, int numThreads);
+
+    // For each strategy (player name): games played, games won, and the shots it took to win them
+    QueryTable shotsToWin();
+
+    // For each cell, how often it was one of a player's first few shots, and how often that hit. Sorted by hit rate,
+    // and cut down to the given number of rows (0 for all of them). Only counts the given player's shots, unless the
+    // name is empty
+    QueryTable firstMoves(int shots, int limit, string player = "");
+
+    // For each ship, how often it was the first, second... of its fleet to be sunk (as a percentage of the times it
+    // was sunk). Only counts the ships the given player sank, unless the name is empty. Ships sunk in records that
+    // didn't say which ship it was (like text battlelogs) still count towards the order of the ones after them
+    QueryTable sinkOrder(string player = "");
+
+    // The blocks of games the scans are split into
+    static const int GAMES_PER_JOB = 1 << 14;
+
+    // Ships with this index or higher are left out of sinkOrder
+    static const int MAX_SINK_SHIPS = 32;
+
+private:
+    const GameColumns &_store;
+    int _numThreads;
+
+    // Runs scan(job, firstGame, endGame) over every block of games, where job counts up from 0 to _numJobs() - 1
+    int _numJobs();
+    void _scan(const function<void(int, size_t, size_t)> &scan);
+
+    // The id of the named player in the store, -1 for any player, or -2 if the store doesn't have them
+    int _playerFilter(string player);
+};
+
+#endif //SFML_TEMPLATE_GAMEQUERIES_H
@@ -0,0 +1,35 @@
+/* GameRecord.h
+ *
+ * Author: Colin Siles
+ *
+ * Plain data types describing a game that has already been played, as read back from a battlelog
+*/
+
+#ifndef SFML_TEMPLATE_GAMERECORD_H
+#define SFML_TEMPLATE_GAMERECORD_H
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+using namespace std;
+
+// A single shot made during the game
+struct RecordedMove {
+    int player; // 0 for the first player, 1 for the second player
+    int xPos;
+    int yPos;
+    bool hit;
+    bool sunk;  // Whether the shot sank a ship
+    int sunkenIndex; // Which ship it sank, or -1 (if it didn't, or the text battlelog didn't say)
+};
+
+struct GameRecord {
+    vector<string> playerNames;
+    vector<int> shipLengths; // Empty if the battlelog didn't say (the text battlelog doesn't)
+    uint64_t seed;           // The seed the game was played with, or 0 if it isn't known
+    vector<RecordedMove> moves;
+    int winner; // Index of the player that won, or -1 if the game didn't finish
+};
+
+#endif //SFML_TEMPLATE_GAMERECORD_H
@@ -0,0 +1,94 @@
+/* GameReplay.cpp
+ *
+ * Author: Colin Siles
+ *
+ * The GameReplay class steps back and forth through a recorded game, keeping keyframes so any move can be reached
+ * without replaying the game from the start
+*/
+
+#include <algorithm>
+
+#include "Board.h"
+#include "GameReplay.h"
+
+GameReplay::GameReplay() {
+    load(GameRecord{{}, {}, 0, {}, -1});
+}
+
+void GameReplay::load(const GameRecord &record) {
+    _record = record;
+
+    // Drops anything that can't be drawn, so the frames never have to check
+    vector<RecordedMove> &moves = _record.moves;
+    for(int i = moves.size() - 1; i >= 0; i--) {
+        const RecordedMove &move = moves.at(i);
+
+        if(move.player < 0 || move.player > 1 || move.xPos < 0 || move.xPos >= Board::GRID_SIZE || move.yPos < 0 ||
+           move.yPos >= Board::GRID_SIZE) {
+            moves.erase(moves.begin() + i);
+        }
+    }
+
+    ReplayFrame frame = {};
+    _keyframes.clear();
+    _keyframes.push_back(frame);
+
+    while(frame.moves < getNumMoves()) {
+        _step(frame);
+
+        if(frame.moves % KEYFRAME_INTERVAL == 0) {
+            _keyframes.push_back(frame);
+        }
+    }
+
+    _frame = _keyframes.at(0);
+}
+
+const GameRecord &GameReplay::getRecord() const {
+    return _record;
+}
+
+int GameReplay::getNumMoves() const {
+    return _record.moves.size();
+}
+
+const RecordedMove &GameReplay::getMove(int moves) const {
+    return _record.moves.at(moves - 1);
+}
+
+const ReplayFrame &GameReplay::seek(int moves) {
+    moves = max(0, min(moves, getNumMoves()));
+
+    // Stepping forward from where the replay already is is cheaper, unless it's a keyframe or more behind
+    if(moves < _frame.moves || moves - _frame.moves >= KEYFRAME_INTERVAL) {
+        _frame = _keyframes.at(moves / KEYFRAME_INTERVAL);
+    }
+
+    while(_frame.moves < moves) {
+        _step(_frame);
+    }
+
+    return _frame;
+}
+
+const ReplayFrame &GameReplay::getFrame() const {
+    return _frame;
+}
+
+void GameReplay::_step(ReplayFrame &frame) const {
+    const RecordedMove &move = _record.moves.at(frame.moves);
+    int cell = cellIndex(move.xPos, move.yPos);
+
+    frame.shots[move.player].set(cell);
+    frame.hits[move.player][cell] = move.hit;
+
+    if(move.sunk) {
+        frame.numSunk[move.player]++;
+
+        if(move.sunkenIndex >= 0 && move.sunkenIndex < MAX_SHIPS) {
+            frame.sunkShips[move.player] |= 1u << move.sunkenIndex;
+        }
+    }
+
+    frame.moves++;
+}
@@ -0,0 +1,62 @@
+/* GameReplay.h
+ *
+ * Author: Colin Siles
+ *
+ * The GameReplay class steps back and forth through a recorded game, giving what both players' tracking boards looked
+ * like after any move. A snapshot of the boards (a keyframe) is kept every KEYFRAME_INTERVAL moves, so going to any
+ * move only takes copying the keyframe before it and replaying the few moves since, however long the game is. It
+ * doesn't draw anything itself (see ReplayViewer)
+*/
+
+#ifndef SFML_TEMPLATE_GAMEREPLAY_H
+#define SFML_TEMPLATE_GAMEREPLAY_H
+
+#include <cstdint>
+#include <vector>
+
+#include "GameRecord.h"
+#include "PlacementTable.h"
+
+using namespace std;
+
+// The state of the game after some number of moves
+struct ReplayFrame {
+    int moves;            // How many moves have been made
+    CellMask shots[2];    // The cells each player has fired at
+    CellMask hits[2];     // The cells each player has hit
+    uint32_t sunkShips[2]; // One bit for each of the opponent's ships the player has sunk, by index
+    int numSunk[2];       // Ships each player has sunk, including ones the record didn't say the index of
+};
+
+class GameReplay {
+public:
+    GameReplay();
+
+    // Starts replaying a game, building its keyframes. Moves off the board are left out
+    void load(const GameRecord &record);
+
+    const GameRecord &getRecord() const;
+    int getNumMoves() const;
+
+    // The move made to get to the given frame (the number of moves made, from 1 to getNumMoves())
+    const RecordedMove &getMove(int moves) const;
+
+    // Goes to the frame after the given number of moves (clamped to the length of the game), and returns it
+    const ReplayFrame &seek(int moves);
+    const ReplayFrame &getFrame() const;
+
+    static const int KEYFRAME_INTERVAL = 32;
+
+    // Ships with higher indices can't be told apart in the sunkShips masks
+    static const int MAX_SHIPS = 32;
+
+private:
+    GameRecord _record;
+    vector<ReplayFrame> _keyframes; // _keyframes.at(i) is the frame after i * KEYFRAME_INTERVAL moves
+    ReplayFrame _frame;
+
+    // Applies the next move to the frame
+    void _step(ReplayFrame &frame) const;
+};
+
+#endif //SFML_TEMPLATE_GAMEREPLAY_H
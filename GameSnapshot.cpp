@@ -0,0 +1,330 @@
+/* GameSnapshot.cpp
+ *
+ * Author: Colin Siles
+ *
+ * Saves and restores games in progress (see GameSnapshot.h for the layout)
+*/
+
+#include <cerrno>
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+#include <iostream>
+#include <iterator>
+
+#include "Board.h"
+#include "GameSnapshot.h"
+#include "PlacementTable.h"
+#include "RandomComputerPlayer.h"
+
+const string GameSnapshot::DEFAULT_FILE = "savedgame.snapshot";
+
+// Placement written for a ship that hasn't been placed
+static const uint16_t NOT_PLACED = 0xFFFF;
+
+// Helper functions for writing little-endian numbers
+static void put16(string &bytes, uint16_t value) {
+    bytes += (char) (value & 0xFF);
+    bytes += (char) (value >> 8);
+}
+
+static void put32(string &bytes, uint32_t value) {
+    for(int i = 0; i < 4; i++) {
+        bytes += (char) ((value >> (8 * i)) & 0xFF);
+    }
+}
+
+static void put64(string &bytes, uint64_t value) {
+    for(int i = 0; i < 8; i++) {
+        bytes += (char) ((value >> (8 * i)) & 0xFF);
+    }
+}
+
+// Reads little-endian numbers from the bytes, failing (and reading zeros) once it runs off the end
+class SnapshotReader {
+public:
+    SnapshotReader(const string &bytes) : _bytes(bytes) {
+        _position = 0;
+        _failed = false;
+    }
+
+    uint64_t get(int size) {
+        if(_failed || _bytes.size() - _position < size) {
+            _failed = true;
+            return 0;
+        }
+
+        uint64_t value = 0;
+        for(int i = 0; i < size; i++) {
+            value |= (uint64_t) (uint8_t) _bytes.at(_position + i) << (8 * i);
+        }
+
+        _position += size;
+        return value;
+    }
+
+    string getString(int length) {
+        if(_failed || _bytes.size() - _position < length) {
+            _failed = true;
+            return "";
+        }
+
+        _position += length;
+        return _bytes.substr(_position - length, length);
+    }
+
+    bool failed() {
+        return _failed;
+    }
+
+private:
+    const string &_bytes;
+    size_t _position;
+    bool _failed;
+};
+
+GameSnapshot GameSnapshot::capture(Player &first, Player &second, const vector<RecordedMove> &moves, int turn) {
+    GameSnapshot snapshot;
+    Player *players[2] = {&first, &second};
+
+    snapshot.record.playerNames = {first.getName(), second.getName()};
+    snapshot.record.shipLengths = first.getShipLengths();
+    snapshot.record.seed = 0;
+    snapshot.record.moves = moves;
+    snapshot.record.winner = -1;
+    snapshot.turn = turn;
+
+    for(int i = 0; i < 2; i++) {
+        snapshot.placements[i] = players[i]->getShipPlacements();
+        snapshot.timeUsed[i] = 0;
+        players[i]->saveState(snapshot.playerState[i]);
+    }
+
+    return snapshot;
+}
+
+// Places the ships and replays the moves of the snapshot. Returns false if they don't fit the players
+static bool replay(const GameSnapshot &snapshot, Player *players[2]) {
+    for(int i = 0; i < 2; i++) {
+        const vector<int> &placements = snapshot.placements[i];
+
+        if(players[i]->getShipLengths() != snapshot.record.shipLengths ||
+           placements.size() != snapshot.record.shipLengths.size()) {
+            cerr << "The saved game was played with a different fleet" << endl;
+            return false;
+        }
+
+        CellMask covered;
+
+        for(int j = 0; j < placements.size(); j++) {
+            const vector<Placement> &tablePlacements =
+                    PlacementTable::forLength(snapshot.record.shipLengths.at(j)).placements();
+
+            if(placements.at(j) < 0 || placements.at(j) >= tablePlacements.size()) {
+                cerr << "The saved game has a ship that wasn't placed" << endl;
+                return false;
+            }
+
+            if((covered & tablePlacements.at(placements.at(j)).mask).any()) {
+                cerr << "The saved game has ships on top of each other" << endl;
+                return false;
+            }
+
+            covered |= tablePlacements.at(placements.at(j)).mask;
+        }
+
+        players[i]->placeShipsAt(placements);
+    }
+
+    for(int i = 0; i < snapshot.record.moves.size(); i++) {
+        const RecordedMove &move = snapshot.record.moves.at(i);
+        Player &shooter = *players[move.player];
+        Player &target = *players[!move.player];
+
+        ShotOutcome outcome = target.fireShotAt(move.xPos, move.yPos);
+        if(outcome.hit != move.hit || outcome.sunkenIndex != (move.sunk ? move.sunkenIndex : -1)) {
+            cerr << "The saved game's moves don't match its ships" << endl;
+            return false;
+        }
+
+        shooter.markShot(move.xPos, move.yPos, outcome);
+    }
+
+    return true;
+}
+
+bool GameSnapshot::restore(Player &first, Player &second) const {
+    // Checked on plain players first, so that the real ones are only touched by a snapshot that fits
+    RandomComputerPlayer checkFirst("", record.shipLengths);
+    RandomComputerPlayer checkSecond("", record.shipLengths);
+    Player *checkPlayers[2] = {&checkFirst, &checkSecond};
+
+    if(!replay(*this, checkPlayers)) {
+        return false;
+    }
+
+    // Replaying the moves brings back everything the players worked out from them
+    Player *players[2] = {&first, &second};
+    if(!replay(*this, players)) {
+        return false;
+    }
+
+    for(int i = 0; i < 2; i++) {
+        size_t position = 0;
+
+        if(!players[i]->restoreState(playerState[i], position) || position != playerState[i].size()) {
+            cerr << "Failed to restore " << players[i]->getName() << " from the saved game" << endl;
+            return false;
+        }
+    }
+
+    return true;
+}
+
+bool GameSnapshot::save(string filename) const {
+    string bytes = "BSSN";
+    put16(bytes, VERSION);
+    put16(bytes, record.shipLengths.size());
+    bytes += (char) turn;
+    put64(bytes, record.seed);
+
+    for(int i = 0; i < 2; i++) {
+        uint64_t bits;
+        memcpy(&bits, &timeUsed[i], 8);
+        put64(bytes, bits);
+    }
+
+    // Names are cut off at 255 bytes, to fit their lengths in a byte
+    for(int i = 0; i < 2; i++) {
+        string name = record.playerNames.at(i).substr(0, 255);
+        bytes += (char) name.size();
+        bytes += name;
+    }
+
+    for(int i = 0; i < record.shipLengths.size(); i++) {
+        bytes += (char) record.shipLengths.at(i);
+    }
+
+    for(int i = 0; i < 2; i++) {
+        for(int j = 0; j < placements[i].size(); j++) {
+            put16(bytes, placements[i].at(j) < 0 ? NOT_PLACED : placements[i].at(j));
+        }
+    }
+
+    put16(bytes, record.moves.size());
+    for(int i = 0; i < record.moves.size(); i++) {
+        const RecordedMove &move = record.moves.at(i);
+
+        bytes += (char) (move.player << 7 | cellIndex(move.xPos, move.yPos));
+        bytes += (char) (move.sunk ? 2 + move.sunkenIndex : move.hit);
+    }
+
+    for(int i = 0; i < 2; i++) {
+        put32(bytes, playerState[i].size());
+
+        for(int j = 0; j < playerState[i].size(); j++) {
+            put32(bytes, playerState[i].at(j));
+        }
+    }
+
+    // Written next to the old snapshot, then moved over it
+    string temporaryName = filename + ".tmp";
+    ofstream snapshotFile(temporaryName, ios::binary | ios::trunc);
+    snapshotFile.write(bytes.data(), bytes.size());
+    snapshotFile.close();
+
+    if(snapshotFile.fail() || rename(temporaryName.c_str(), filename.c_str()) != 0) {
+        cerr << "Failed to save the game to " << filename << endl;
+        remove(temporaryName.c_str());
+        return false;
+    }
+
+    return true;
+}
+
+bool GameSnapshot::load(string filename) {
+    ifstream snapshotFile(filename, ios::binary);
+    if(!snapshotFile) {
+        if(errno != ENOENT) {
+            cerr << "Failed to open " << filename << endl;
+        }
+
+        return false;
+    }
+
+    string bytes((istreambuf_iterator<char>(snapshotFile)), istreambuf_iterator<char>());
+    SnapshotReader reader(bytes);
+
+    if(reader.getString(4) != "BSSN" || reader.get(2) != VERSION) {
+        cerr << filename << " isn't a saved game" << endl;
+        return false;
+    }
+
+    int numShips = reader.get(2);
+    turn = reader.get(1);
+    record.seed = reader.get(8);
+
+    for(int i = 0; i < 2; i++) {
+        uint64_t bits = reader.get(8);
+        memcpy(&timeUsed[i], &bits, 8);
+    }
+
+    record.playerNames.clear();
+    for(int i = 0; i < 2; i++) {
+        record.playerNames.push_back(reader.getString(reader.get(1)));
+    }
+
+    record.shipLengths.clear();
+    for(int i = 0; i < numShips; i++) {
+        record.shipLengths.push_back(reader.get(1));
+    }
+
+    for(int i = 0; i < 2; i++) {
+        placements[i].clear();
+
+        for(int j = 0; j < numShips; j++) {
+            uint16_t placement = reader.get(2);
+            placements[i].push_back(placement == NOT_PLACED ? -1 : placement);
+        }
+    }
+
+    int numMoves = reader.get(2);
+    record.moves.clear();
+
+    for(int i = 0; i < numMoves && !reader.failed(); i++) {
+        uint8_t shot = reader.get(1);
+        uint8_t outcome = reader.get(1);
+        pair<int, int> coords = cellCoords(shot & 0x7F);
+
+        if((shot & 0x7F) >= NUM_CELLS) {
+            cerr << filename << " has a move off the board" << endl;
+            return false;
+        }
+
+        record.moves.push_back({shot >> 7, coords.first, coords.second, outcome >= 1, outcome >= 2,
+                                outcome >= 2 ? outcome - 2 : -1});
+    }
+
+    record.winner = -1;
+
+    for(int i = 0; i < 2; i++) {
+        uint32_t numWords = reader.get(4);
+        playerState[i].clear();
+
+        for(uint32_t j = 0; j < numWords && !reader.failed(); j++) {
+            playerState[i].push_back(reader.get(4));
+        }
+    }
+
+    if(reader.failed()) {
+        cerr << filename << " is cut short" << endl;
+        return false;
+    }
+
+    if(turn > 1) {
+        cerr << filename << " isn't a saved game" << endl;
+        return false;
+    }
+
+    return true;
+}
@@ -0,0 +1,56 @@
+/* GameSnapshot.h
+ *
+ * Author: Colin Siles
+ *
+ * The GameSnapshot struct holds everything needed to pick a game back up where it was left: where both players placed
+ * their ships, the moves made so far, whose turn it is, and whatever state the players keep that the moves don't
+ * bring back (like their random number generators). It's restored by placing the ships and replaying the moves into
+ * newly created players, so everything the players work out from the shots (the computer's hit list, placement counts
+ * and so on) comes back exactly as it was, without the snapshot having to know about it
+ *
+ * Snapshots are saved as small binary files (numbers little-endian):
+ *   "BSSN", version (u16), number of ships (u16), turn (u8), seed (u64), time used by each player (2 x f64, ms)
+ *   Both names (u8 length, then the bytes), then each ship's length (u8)
+ *   Each player's placements (u16 per ship, an index into the PlacementTable for its length, 0xFFFF if not placed)
+ *   Number of moves (u16), then two bytes per move: player << 7 | cellIndex(x, y), and the outcome (0 for a miss,
+ *   1 for a hit, 2 + the index of the ship sunk)
+ *   Each player's state (u32 number of words, then the words)
+*/
+
+#ifndef SFML_TEMPLATE_GAMESNAPSHOT_H
+#define SFML_TEMPLATE_GAMESNAPSHOT_H
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#include "GameRecord.h"
+#include "Player.h"
+
+using namespace std;
+
+struct GameSnapshot {
+    GameRecord record;               // Names, ship lengths, seed and the moves so far (the winner is always -1)
+    vector<int> placements[2];       // Each player's ship placements (see Player::getShipPlacements)
+    int turn;                        // The player to move next
+    double timeUsed[2];              // Time each player has spent thinking, in milliseconds
+    vector<uint32_t> playerState[2]; // See Player::saveState
+
+    // Takes a snapshot of two players part way through a game, given the moves made so far
+    static GameSnapshot capture(Player &first, Player &second, const vector<RecordedMove> &moves, int turn);
+
+    // Puts two newly created players, who haven't placed their ships yet, in the state of the snapshot. Returns false
+    // if the snapshot doesn't fit them (a different fleet, or moves that don't turn out the way they were recorded)
+    bool restore(Player &first, Player &second) const;
+
+    // Saves the snapshot, replacing the file all at once so that a crash never leaves half a snapshot behind
+    bool save(string filename) const;
+
+    // Loads a snapshot. Returns false if there isn't one (quietly, if the file doesn't exist)
+    bool load(string filename);
+
+    static const string DEFAULT_FILE;
+    static const uint16_t VERSION = 2;
+};
+
+#endif //SFML_TEMPLATE_GAMESNAPSHOT_H
@@ -0,0 +1,75 @@
+/* GameStats.cpp
+ *
+ * Author: Colin Siles
+ *
+ * The GameStats class is a GameEventSubscriber that keeps running totals over every game on a bus: games finished,
+ * shots, hits, ships sunk, and how long the players took to move
+*/
+
+#include "GameStats.h"
+
+GameStats::GameStats() {
+    _games = 0;
+    _shots = 0;
+    _hits = 0;
+    _sinks = 0;
+    _timedMoves = 0;
+    _thinkTime = 0;
+}
+
+void GameStats::onEvent(const GameEvent &event) {
+    // Only one thread writes, so there's no need for anything stronger than a load and a store
+    switch(event.type) {
+        case SHOT_OUTCOME:
+            _shots.store(_shots.load(memory_order_relaxed) + 1, memory_order_relaxed);
+
+            if(event.hit) {
+                _hits.store(_hits.load(memory_order_relaxed) + 1, memory_order_relaxed);
+            }
+            break;
+
+        case SHIP_SUNK:
+            _sinks.store(_sinks.load(memory_order_relaxed) + 1, memory_order_relaxed);
+            break;
+
+        case MOVE_TIMED:
+            _thinkTime.store(_thinkTime.load(memory_order_relaxed) + event.milliseconds, memory_order_relaxed);
+            _timedMoves.store(_timedMoves.load(memory_order_relaxed) + 1, memory_order_relaxed);
+            break;
+
+        case GAME_OVER:
+            _games.store(_games.load(memory_order_relaxed) + 1, memory_order_relaxed);
+            break;
+
+        default:
+            break;
+    }
+}
+
+long GameStats::getGames() const {
+    return _games;
+}
+
+long GameStats::getShots() const {
+    return _shots;
+}
+
+long GameStats::getHits() const {
+    return _hits;
+}
+
+long GameStats::getSinks() const {
+    return _sinks;
+}
+
+double GameStats::getAverageShotsPerGame() const {
+    long games = _games;
+
+    return games > 0 ? (double) _shots / games : 0;
+}
+
+double GameStats::getAverageThinkTime() const {
+    long moves = _timedMoves;
+
+    return moves > 0 ? _thinkTime / moves : 0;
+}
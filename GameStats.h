@@ -0,0 +1,42 @@
+/* GameStats.h
+ *
+ * Author: Colin Siles
+ *
+ * The GameStats class is a GameEventSubscriber that keeps running totals over every game on a bus: games finished,
+ * shots, hits, ships sunk, and how long the players took to move
+*/
+
+#ifndef SFML_TEMPLATE_GAMESTATS_H
+#define SFML_TEMPLATE_GAMESTATS_H
+
+#include <atomic>
+
+#include "GameEventSubscriber.h"
+
+using namespace std;
+
+class GameStats : public GameEventSubscriber {
+public:
+    GameStats();
+
+    void onEvent(const GameEvent &event) override;
+
+    // The totals so far. Safe to read from any thread while the games are running
+    long getGames() const;
+    long getShots() const;
+    long getHits() const;
+    long getSinks() const;
+    double getAverageShotsPerGame() const;
+    double getAverageThinkTime() const; // In milliseconds per move
+
+private:
+    // Only the subscriber's thread writes these, but anything can read them
+    atomic<long> _games;
+    atomic<long> _shots;
+    atomic<long> _hits;
+    atomic<long> _sinks;
+    atomic<long> _timedMoves;
+    atomic<double> _thinkTime;
+};
+
+#endif //SFML_TEMPLATE_GAMESTATS_H
@@ -0,0 +1,107 @@
+/* HitClusters.cpp
+ *
+ * Author: Colin Siles
+ *
+ * The HitClusters class groups the unresolved hits on a tracking board into connected clusters (squares that touch
+ * horizontally or vertically). Hits from different ships usually end up in different clusters, so destroy mode can
+ * work on one ship at a time. Clusters are merged as each hit arrives, and only split again when squares are removed
+ * because they turned out to belong to a sunken ship
+*/
+
+#include "HitClusters.h"
+
+void HitClusters::addHit(int cell) {
+    CellMask merged;
+    merged.set(cell);
+
+    CellMask neighbors = _neighbors(cell);
+
+    // Pull every cluster touching the new hit into one, and keep the rest as they are
+    vector<CellMask> remaining;
+    for(int i = 0; i < _clusters.size(); i++) {
+        if((_clusters.at(i) & neighbors).any()) {
+            merged |= _clusters.at(i);
+        } else {
+            remaining.push_back(_clusters.at(i));
+        }
+    }
+
+    remaining.push_back(merged);
+    _clusters = remaining;
+}
+
+void HitClusters::removeHits(const CellMask &cells) {
+    vector<CellMask> remaining;
+
+    for(int i = 0; i < _clusters.size(); i++) {
+        // Clusters that don't lose any squares are unchanged
+        if((_clusters.at(i) & cells).none()) {
+            remaining.push_back(_clusters.at(i));
+            continue;
+        }
+
+        CellMask left = _clusters.at(i) & ~cells;
+
+        // Flood fill what's left of the cluster, since it may have come apart into several pieces
+        while(left.any()) {
+            int start = 0;
+            while(!left.test(start)) {
+                start++;
+            }
+
+            CellMask piece;
+            vector<int> frontier(1, start);
+            piece.set(start);
+
+            while(!frontier.empty()) {
+                int current = frontier.back();
+                frontier.pop_back();
+
+                CellMask next = _neighbors(current) & left & ~piece;
+
+                for(int j = 0; j < NUM_CELLS; j++) {
+                    if(next.test(j)) {
+                        piece.set(j);
+                        frontier.push_back(j);
+                    }
+                }
+            }
+
+            remaining.push_back(piece);
+            left &= ~piece;
+        }
+    }
+
+    _clusters = remaining;
+}
+
+int HitClusters::numClusters() const {
+    return _clusters.size();
+}
+
+const CellMask &HitClusters::cluster(int index) const {
+    return _clusters.at(index);
+}
+
+CellMask HitClusters::_neighbors(int cell) {
+    pair<int, int> coords = cellCoords(cell);
+    CellMask output;
+
+    if(coords.first > 0) {
+        output.set(cellIndex(coords.first - 1, coords.second));
+    }
+
+    if(coords.first < Board::GRID_SIZE - 1) {
+        output.set(cellIndex(coords.first + 1, coords.second));
+    }
+
+    if(coords.second > 0) {
+        output.set(cellIndex(coords.first, coords.second - 1));
+    }
+
+    if(coords.second < Board::GRID_SIZE - 1) {
+        output.set(cellIndex(coords.first, coords.second + 1));
+    }
+
+    return output;
+}
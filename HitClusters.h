@@ -0,0 +1,40 @@
+/* HitClusters.h
+ *
+ * Author: Colin Siles
+ *
+ * The HitClusters class groups the unresolved hits on a tracking board into connected clusters (squares that touch
+ * horizontally or vertically). Hits from different ships usually end up in different clusters, so destroy mode can
+ * work on one ship at a time. Clusters are merged as each hit arrives, and only split again when squares are removed
+ * because they turned out to belong to a sunken ship
+*/
+
+#ifndef SFML_TEMPLATE_HITCLUSTERS_H
+#define SFML_TEMPLATE_HITCLUSTERS_H
+
+#include <vector>
+
+#include "PlacementTable.h"
+
+using namespace std;
+
+class HitClusters {
+public:
+    // Adds a hit, joining it to every cluster it touches
+    void addHit(int cell);
+
+    // Removes the given squares from the clusters (they were sunk), splitting up any clusters they were holding together
+    void removeHits(const CellMask &cells);
+
+    int numClusters() const;
+
+    // Returns the squares that make up the cluster at the index
+    const CellMask &cluster(int index) const;
+
+private:
+    vector<CellMask> _clusters;
+
+    // Returns the squares directly above, below, left and right of the given square
+    static CellMask _neighbors(int cell);
+};
+
+#endif //SFML_TEMPLATE_HITCLUSTERS_H
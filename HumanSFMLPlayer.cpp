@@ -83,7 +83,11 @@ void HumanSFMLPlayer::placeShips() {
 
 // Allows the player to make a guess against their opponent
 pair<int, int> HumanSFMLPlayer::getMove() {
-    while(_window.isOpen()) {
+    return getMove(Deadline());
+}
+
+pair<int, int> HumanSFMLPlayer::getMove(const Deadline &deadline) {
+    while(_window.isOpen() && !deadline.expired()) {
         // Draw the black background
         _window.clear( Color::Black );
 
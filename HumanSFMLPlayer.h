@@ -28,6 +28,9 @@ public:
 
     // Override the three primary functions for a Player subclass
     pair<int, int> getMove() override;
+
+    // Also the deadline version, which gives up (returning an invalid move) if the player doesn't click in time
+    pair<int, int> getMove(const Deadline &deadline) override;
     void placeShips() override;
     void reportGameover(bool winner) override;
 
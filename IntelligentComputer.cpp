@@ -6,142 +6,229 @@
  * This player is really good, and can win a game in an average of about 40 shots
 */
 
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+
 #include "IntelligentComputer.h"
 
-// Overrode function to track what happens when a ship is sunk
-void IntelligentComputer::markShot(int xPos, int yPos, ShotOutcome outcome) {
-    // Call the superclass markShot function, to mark the gird
-    Player::markShot(xPos, yPos, outcome);
+AIParameters IntelligentComputer::_defaultParameters;
 
-    // Add the move to the hit list if it was a hit
-    if(outcome.hit) {
-        _hitList.push_back(make_pair(xPos, yPos));
-    }
+// The targeting settings start out as the default parameters
+IntelligentComputer::IntelligentComputer(string name, vector<int> shipLengths) : Player(name, shipLengths),
+        _sunkShipTracker(shipLengths), _placementCounts(shipLengths) {
+    setParameters(_defaultParameters);
 
-    // If the shot resulted in a hit, mark the correct squares as sunk, so they aren't considered anymore
-    if(outcome.sunkenIndex >= 0) {
-        _markAsSunk(xPos, yPos, _trackingFleet.ship(outcome.sunkenIndex).getLength());
+    // The parity lattice gets built on the first move
+    _latticeSpacing = 0;
 
-    // Otherwise, just reset the lastHit variable
-    } else if(outcome.hit){
-        _lastHit = make_pair(xPos, yPos);
-    }
+    // Learning about opponents writes files to the working directory, so it's only done when asked for
+    _placementLearning = false;
+
+    _firingProfiling = false;
+    _opponentShotNumbers.assign(NUM_CELLS, 0);
+    _opponentShots = 0;
+    _placementBudget = 3.0;
+
+    _adversarialBudget = 0;
+    _placementSearchResult = {vector<int>(), 0.0, 0.0, 0, 0};
+
+    _lastDensity = _newProbabilityGrid();
+    _clusterGrid = _newProbabilityGrid();
 }
 
-void IntelligentComputer::_markAsSunk(int xPos, int yPos, int length) {
-    // "Start spots" for guesses where a ship begins in each direction
-    pair<int, int> horizontalStart = make_pair(-1, -1);
-    pair<int, int> verticalStart = make_pair(-1, -1);
+void IntelligentComputer::setDefaultParameters(const AIParameters &parameters) {
+    _defaultParameters = parameters;
+}
 
-    // Number of consecutive hits in each direction from this spot
-    int horizontalConsecutiveHits = 0;
-    int verticalConsecutiveHits = 0;
+void IntelligentComputer::setParameters(const AIParameters &parameters) {
+    _endgameSolver.setMaxConfigurations(parameters.endgameThreshold);
+    _endgameSolver.setMaxSteps(parameters.endgameSteps);
+    _latticePruning = parameters.latticePruning;
+    setTargetingMode(parameters.informationGain ? INFORMATION_GAIN : DENSITY, parameters.entropyCandidates);
+}
 
-    // Find the number of consecutive shots in each direction
-    _findConsecutiveShots(xPos, yPos, length, true, horizontalStart, horizontalConsecutiveHits);
-    _findConsecutiveShots(xPos, yPos, length, false, verticalStart, verticalConsecutiveHits);
+void IntelligentComputer::setPlacementLearning(bool enabled) {
+    _placementLearning = enabled;
+}
 
-    // If sufficient hits in both directions were found to mark a ship as sunk, we don't know what to mark
-    // So just mark the last shot as sunk, and we'll let it work itself out
-    if(horizontalConsecutiveHits >= length && verticalConsecutiveHits >=length) {
-        _trackingBoard._grid.at(xPos).at(yPos) = Board::SHIP;
+void IntelligentComputer::setFiringProfiling(bool enabled) {
+    _firingProfiling = enabled;
+}
+
+void IntelligentComputer::setPlacementBudget(double milliseconds) {
+    _placementBudget = milliseconds;
+}
+
+void IntelligentComputer::setAdversarialPlacement(double milliseconds) {
+    _adversarialBudget = milliseconds;
+}
 
-    // We found enough hits in the horizontal direction to mark a ship as sunk, so do so
-    } else if(horizontalConsecutiveHits >= length) {
-        pair<int, int> direction = make_pair(1, 0);
+PlacementSearchResult IntelligentComputer::getPlacementSearchResult() {
+    return _placementSearchResult;
+}
 
-        _markSquaresAsSunk(horizontalStart, direction, length, horizontalConsecutiveHits);
+const vector<vector<int>> &IntelligentComputer::getLastDensity() const {
+    return _lastDensity;
+}
 
-    // We found enough hits in the vertical direction to mark a ship as sunk, so do so
-    } else if(verticalConsecutiveHits >=length) {
-        pair<int, int> direction = make_pair(0, 1);
+// The lattice is stored as its spacing, then its cells, 32 to a word
+void IntelligentComputer::saveState(vector<uint32_t> &state) {
+    Player::saveState(state);
 
-        _markSquaresAsSunk(verticalStart, direction, length, verticalConsecutiveHits);
+    state.push_back(_latticeSpacing);
+    for(int word = 0; word < (NUM_CELLS + 31) / 32; word++) {
+        uint32_t bits = 0;
 
-    // We didn't find enough consecutive hits in any direction to mark a ship as sunk
-    // This probably means somethign went wrong above, so just mark that spot as sunk
-    } else {
-        _trackingBoard._grid.at(xPos).at(yPos) = Board::SHIP;
+        for(int bit = 0; bit < 32 && word * 32 + bit < NUM_CELLS; bit++) {
+            bits |= (uint32_t) _lattice.test(word * 32 + bit) << bit;
+        }
+
+        state.push_back(bits);
     }
 }
 
-// Finds the maximum number of consecutive shots
-void IntelligentComputer::_findConsecutiveShots(int xPos, int yPos, int length, bool horizontal, pair<int, int> &start, int &consecutiveHits) {
-    // Determine the direction to search in based on if finding shots in the horizontal direction or not
-    pair<int, int> direction = horizontal ? make_pair(1, 0) : make_pair(0, 1);
+bool IntelligentComputer::restoreState(const vector<uint32_t> &state, size_t &position) {
+    const int numWords = (NUM_CELLS + 31) / 32;
 
-    // Track the maximum number of consecutive hits, and the start of that ship
-    // We need to track maximums, in case their are pockets of consecutive hits
-    int maxConsecutiveHits = 0;
-    pair<int, int> maxStart = make_pair(-1, -1);
+    if(!Player::restoreState(state, position) || state.size() - position < 1 + numWords) {
+        return false;
+    }
 
-    // Iterate over each possiblesquare in either direction
-    for(int i = -length + 1; i < length; i++) {
-        // Determine the square to search based on the direction
-        int xMark = xPos + direction.first * i;
-        int yMark = yPos + direction.second * i;
+    _latticeSpacing = state.at(position);
+    _lattice.reset();
 
-        // If the guess is inside the grid, and a hit, we found a hit
-        if(_trackingBoard._posInsideGrid(xMark, yMark) && _trackingBoard._grid.at(xMark).at(yMark) == Board::HIT_MARKER) {
-            // If the start variable has negatives, it hasn't been set yet, so set this square as a the start
-            if(start.first < 0) {
-                start = make_pair(xMark, yMark);
-            }
+    for(int cell = 0; cell < NUM_CELLS; cell++) {
+        if(state.at(position + 1 + cell / 32) >> (cell % 32) & 1) {
+            _lattice.set(cell);
+        }
+    }
+
+    position += 1 + numWords;
+    return true;
+}
 
-            // Increment the number of consecutive hits found
-            consecutiveHits++;
+// Maps the opponent's firing profile and placement model, and weights all the placements by the model from here on
+void IntelligentComputer::reportOpponent(string name) {
+    Player::reportOpponent(name);
 
-            // If the current number of consecutive hits is at a max, store that number, and the start
-            if(consecutiveHits > maxConsecutiveHits) {
-                maxConsecutiveHits = consecutiveHits;
-                maxStart = start;
-            }
+    if(_firingProfiling) {
+        _firingProfile.open(FiringProfile::filenameFor(name));
+    }
 
-        // If we didn't find a hit, but found hits before, reset all the variables
-        } else if(consecutiveHits > 0) {
-            consecutiveHits = 0;
-            start = make_pair(-1, -1);
-        }
+    if(!_placementLearning || !_placementPrior.open(PlacementPrior::filenameFor(name))) {
+        return;
     }
 
-    // Set the variables to the maximum that were found, which is most likely what we're looking for
-    start = maxStart;
-    consecutiveHits = maxConsecutiveHits;
+    vector<int> shipLengths;
+    for(int i = 0; i < _trackingFleet.size(); i++) {
+        shipLengths.push_back(_trackingFleet.ship(i).getLength());
+    }
+
+    _placementPrior.computeWeights(shipLengths);
+    _placementCounts.setPrior(&_placementPrior);
 }
 
-// Marks a series of squares from a starting point, in a given direction as sunk.
-void IntelligentComputer::_markSquaresAsSunk(pair<int, int> start, pair<int, int> direction, int length, int consecutiveHits) {
-    // If more consecutive hits were found than ships, we can't mark them all as sunk, just a subset
-    if(consecutiveHits > length) {
-        int diff = consecutiveHits - length;
+void IntelligentComputer::resetState() {
+    Player::resetState();
+
+    vector<int> shipLengths = getShipLengths();
 
-        // modify the length that we mark as hit
-        // (e.g. if we found found conseutive hits for length 3, we can only mark two squares as sunk)
-        length -= diff;
+    _hitList.clear();
+    _hitClusters = HitClusters();
+    _hitCells.reset();
+    _blockedCells.reset();
+    _sunkShipTracker = SunkShipTracker(shipLengths);
+
+    _latticeSpacing = 0;
+    _lattice.reset();
+
+    // Starting the counts over with the same prior (or none)
+    _placementCounts.setPrior(_placementPrior.isOpen() ? &_placementPrior : nullptr);
+
+    fill(_opponentShotNumbers.begin(), _opponentShotNumbers.end(), 0);
+    _opponentShots = 0;
+
+    _placementSearchResult = {vector<int>(), 0.0, 0.0, 0, 0};
+
+    _clearProbabilityGrid(_lastDensity);
+}
+
+int IntelligentComputer::_placementWeight(int length, int placement) {
+    return _placementPrior.isOpen() ? _placementPrior.weight(length, placement) : 1;
+}
 
-        // Change the start position as well to account for this difference
-        // "We'll mark the middle, where we can be sure the ships were indeed sunk
-        start.first += direction.first * diff;
-        start.second += direction.second * diff;
+void IntelligentComputer::setEndgameThreshold(int maxConfigurations) {
+    _endgameSolver.setMaxConfigurations(maxConfigurations);
+}
+
+void IntelligentComputer::setLatticePruning(bool enabled) {
+    _latticePruning = enabled;
+}
+
+void IntelligentComputer::setTargetingMode(TargetingMode mode, int candidates) {
+    _targetingMode = mode;
+    _entropyCandidates = max(1, candidates);
+}
+
+// Overrode function to track what happens when a ship is sunk
+void IntelligentComputer::markShot(int xPos, int yPos, ShotOutcome outcome) {
+    // Call the superclass markShot function, to mark the gird
+    Player::markShot(xPos, yPos, outcome);
+
+    // Add the move to the hit list (and the clusters) if it was a hit
+    if(outcome.hit) {
+        _hitList.push_back(make_pair(xPos, yPos));
+        _hitClusters.addHit(cellIndex(xPos, yPos));
+        _hitCells.set(cellIndex(xPos, yPos));
+    } else {
+        _blockedCells.set(cellIndex(xPos, yPos));
     }
 
-    // Iterate over every square to be marked as sunk
-    for(int i = 0; i < length; i++) {
-        int xMark = start.first + direction.first * i;
-        int yMark = start.second + direction.second * i;
+    // Keep the placement counts up to date
+    if(outcome.hit) {
+        _placementCounts.markHit(cellIndex(xPos, yPos));
+    } else {
+        _placementCounts.markMiss(cellIndex(xPos, yPos));
+    }
+
+    if(outcome.sunkenIndex >= 0) {
+        _placementCounts.markShipSunk(outcome.sunkenIndex);
+    }
 
-        // Mark the position as a ship. This is an easy way to mark as sunk, that leverages existing functionality
-        // (i.e. don't need to create a sunk marker or an entirely new board class to handle this)
-        _trackingBoard._grid.at(xMark).at(yMark) = Board::SHIP;
+    // Let the sunk ship tracker work out which hits belong to sunken ships
+    _sunkShipTracker.markShot(cellIndex(xPos, yPos), outcome);
 
-        // Remove the coordinate in the hit list; that coordinate was sunk
-        for (int j = 0; j < _hitList.size(); j++) {
-            if (_hitList.at(j).first == xMark && _hitList.at(j).second == yMark) {
-                _hitList.erase(_hitList.begin() + j);
-                break;
-            }
+    // Then mark any squares it has resolved as sunk, so they aren't considered anymore
+    _markResolvedSquares();
+}
+
+// Marks every square the sunk ship tracker knows to belong to a sunken ship, and removes it from the hit list
+void IntelligentComputer::_markResolvedSquares() {
+    CellMask sunkCells = _sunkShipTracker.sunkCells();
+
+    for(int i = 0; i < _hitList.size(); i++) {
+        int xMark = _hitList.at(i).first;
+        int yMark = _hitList.at(i).second;
+
+        if(sunkCells.test(cellIndex(xMark, yMark))) {
+            // Mark the position as a ship. This is an easy way to mark as sunk, that leverages existing functionality
+            // (i.e. don't need to create a sunk marker or an entirely new board class to handle this)
+            _markCellSunk(xMark, yMark);
+
+            _hitList.erase(_hitList.begin() + i);
+            i--;
         }
     }
+
+    _hitClusters.removeHits(sunkCells);
+}
+
+// Marks a square as part of a sunken ship, so no other ship is considered there
+void IntelligentComputer::_markCellSunk(int xPos, int yPos) {
+    _trackingBoard._grid.at(xPos).at(yPos) = Board::SHIP;
+    _placementCounts.markSunkCell(cellIndex(xPos, yPos));
+    _blockedCells.set(cellIndex(xPos, yPos));
 }
 
 // Returns a blank grid in which its possible to store the probability of a ship being in each location
@@ -157,97 +244,154 @@ vector<vector<int>> IntelligentComputer::_newProbabilityGrid() {
     return output;
 }
 
-// Similar to "placeShip", but adds to the probabiltiy density grid
-void IntelligentComputer::_addToDensity(Ship ship, vector<vector<int>> &probabilityGrid) {
-    // Iterate over each square in the ship
-    for(auto &square : ship.getSquares()) {
-        pair<int, int> squarePos = square.first;
-
-        // Add one to the corresponding position, since there's a new way for a ship to be there
-        probabilityGrid.at(squarePos.first).at(squarePos.second) += 1;
+void IntelligentComputer::_clearProbabilityGrid(vector<vector<int>> &probabilityGrid) {
+    for(int i = 0; i < probabilityGrid.size(); i++) {
+        fill(probabilityGrid.at(i).begin(), probabilityGrid.at(i).end(), 0);
     }
 }
 
-// Returns a probability grid in "search" mode, when no hits have been identified
-vector<vector<int>> IntelligentComputer::_findSearchProbability() {
-    vector<vector<int>> probabilityGrid = _newProbabilityGrid();
+// Fills in a probability grid in "search" mode, when no hits have been identified
+// The number of ways each ship could cover each square is kept up to date by the placement counts, so this just adds
+// them up. With lattice pruning on, only the squares on the current lattice are scored
+void IntelligentComputer::_findSearchProbability(vector<vector<int>> &probabilityGrid) {
+    _clearProbabilityGrid(probabilityGrid);
 
-    // Iterate over every possible ship
-    for(int i = 0; i < _trackingFleet.size(); i++) {
-        Ship currentShip = _trackingFleet.ship(i);
+    if(_latticePruning) {
+        _updateLattice();
+    }
 
-        // Exit if the ship has been sunk; it cannot be located anywhere now
-        if(currentShip.isSunk()) {
+    for(int cell = 0; cell < NUM_CELLS; cell++) {
+        // Skip squares that aren't on the lattice
+        if(_latticePruning && !_lattice.test(cell)) {
             continue;
         }
 
-        // Iterate through the entire board, every possible place to fit the ship
-        for(int j = 0; j < 10; j++) {
-            for(int k = 0; k < 10; k++) {
-                // Make the ship horizontal at the position
-                currentShip.setHorizontal();
-                currentShip.setGridPos(j, k);
+        pair<int, int> coords = cellCoords(cell);
 
-                // If the ship fits there, add it to the density
-                if(_trackingBoard.shipFits(currentShip)) {
-                    _addToDensity(currentShip, probabilityGrid);
-                }
+        // Add up the ways every ship that's still afloat could cover the square
+        for(int i = 0; i < _placementCounts.numShips(); i++) {
+            if(!_placementCounts.isSunk(i)) {
+                probabilityGrid.at(coords.first).at(coords.second) += _placementCounts.count(i, cell);
+            }
+        }
+    }
+}
 
-                // Now make the ship vertical, at the position, add to density if it fits again
-                currentShip.rotate();
-                currentShip.setGridPos(j, k);
-                if(_trackingBoard.shipFits(currentShip)) {
-                    _addToDensity(currentShip, probabilityGrid);
-                }
+// Every ship is at least as long as the shortest ship still afloat, m, so every ship covers a square where
+// (x + y) % m is any given value. Searching only the squares of one of those lattices is enough to find them all.
+// The lattice is only rebuilt when m changes, picking the offset whose squares have the most total density
+void IntelligentComputer::_updateLattice() {
+    int spacing = Board::GRID_SIZE;
+    for(int i = 0; i < _trackingFleet.size(); i++) {
+        if(!_trackingFleet.ship(i).isSunk()) {
+            spacing = min(spacing, _trackingFleet.ship(i).getLength());
+        }
+    }
+
+    if(spacing == _latticeSpacing) {
+        return;
+    }
+
+    _latticeSpacing = spacing;
+
+    // Total density of the squares at each offset
+    vector<long> offsetDensity(spacing, 0);
+
+    for(int cell = 0; cell < NUM_CELLS; cell++) {
+        pair<int, int> coords = cellCoords(cell);
+
+        for(int i = 0; i < _placementCounts.numShips(); i++) {
+            if(!_placementCounts.isSunk(i)) {
+                offsetDensity.at((coords.first + coords.second) % spacing) += _placementCounts.count(i, cell);
             }
         }
     }
 
-    // Return the resulting grid
-    return probabilityGrid;
+    int offset = max_element(offsetDensity.begin(), offsetDensity.end()) - offsetDensity.begin();
+
+    _lattice.reset();
+    for(int cell = 0; cell < NUM_CELLS; cell++) {
+        pair<int, int> coords = cellCoords(cell);
+
+        if((coords.first + coords.second) % spacing == offset) {
+            _lattice.set(cell);
+        }
+    }
 }
 
-// Returns a probability grid in "destory" mode, when a hit has been found
-vector<vector<int>> IntelligentComputer::_findDestroyProbability() {
-    vector<vector<int>> probabilityGrid = _newProbabilityGrid();
+// Fills in a probability grid in "destory" mode, when a hit has been found
+// Only the most constrained cluster of hits is considered (the one the fewest placements could explain), and each
+// placement covering it is weighted by how many of the cluster's hits it explains
+void IntelligentComputer::_findDestroyProbability(vector<vector<int>> &probabilityGrid) {
+    _clearProbabilityGrid(probabilityGrid);
+
+    int bestPlacements = -1;
+
+    for(int i = 0; i < _hitClusters.numClusters(); i++) {
+        const CellMask &cluster = _hitClusters.cluster(i);
+
+        _clearProbabilityGrid(_clusterGrid);
+        int numPlacements = 0;
 
-    // Iterate over each hit in the hit list
-    for(int i = 0; i < _hitList.size(); i++) {
         // Iterate over each ship
         for(int j = 0; j < _trackingFleet.size(); j++) {
-            Ship currentShip = _trackingFleet.ship(j);
-
             // Continue to the next ship if this ship was already sunk
-            if(currentShip.isSunk()) {
+            if(_trackingFleet.ship(j).isSunk()) {
                 continue;
             }
 
-            // Iterate over each possible position the ship could be placed intersecting with this hit
-            for(int k = 0; k < currentShip.getLength(); k++) {
-                // As with search mode, place the ship in the given locations, check if they fit
-                // and add to the probability density if it does fit
+            const PlacementTable &table = PlacementTable::forLength(_trackingFleet.ship(j).getLength());
 
-                currentShip.setHorizontal();
-                currentShip.setGridPos(_hitList.at(i).first - k, _hitList.at(i).second);
-                if(_trackingBoard.shipFits(currentShip)) {
-                    _addToDensity(currentShip, probabilityGrid);
+            // Iterate over each placement of the ship covering one of the cluster's hits
+            for(int cell = 0; cell < NUM_CELLS; cell++) {
+                if(!cluster.test(cell)) {
+                    continue;
                 }
 
-                currentShip.rotate();
-                currentShip.setGridPos(_hitList.at(i).first, _hitList.at(i).second - k);
-                if(_trackingBoard.shipFits(currentShip)) {
-                    _addToDensity(currentShip, probabilityGrid);
+                const vector<int> &covering = table.covering(cell);
+
+                for(int k = 0; k < covering.size(); k++) {
+                    const Placement &placement = table.placements().at(covering.at(k));
+
+                    // Count each placement once, from the first of the cluster's hits that it covers
+                    // (a placement's cells are in increasing order, as are the cells we iterate over)
+                    int firstExplained = 0;
+                    while(!cluster.test(placement.cells.at(firstExplained))) {
+                        firstExplained++;
+                    }
+
+                    if(placement.cells.at(firstExplained) != cell) {
+                        continue;
+                    }
+
+                    // The placement has to fit, and has to have somewhere left to shoot
+                    if((placement.mask & _blockedCells).any() || (placement.mask & ~_hitCells).none()) {
+                        continue;
+                    }
+
+                    numPlacements++;
+
+                    // Weighted by the number of hits it explains, and by the opponent's placement prior
+                    int weight = (placement.mask & cluster).count() * _placementWeight(table.getLength(), covering.at(k));
+
+                    for(int m = 0; m < placement.cells.size(); m++) {
+                        pair<int, int> coords = cellCoords(placement.cells.at(m));
+                        _clusterGrid.at(coords.first).at(coords.second) += weight;
+                    }
                 }
             }
         }
-    }
 
-    // Return the resulting probability distribution
-    return probabilityGrid;
+        // Keep the cluster with the fewest ways to explain it (ignoring clusters nothing can explain)
+        if(numPlacements > 0 && (bestPlacements < 0 || numPlacements < bestPlacements)) {
+            bestPlacements = numPlacements;
+            probabilityGrid = _clusterGrid;
+        }
+    }
 }
 
 // Selects a move from a probaility grid (random move with maximum probability)
-pair<int, int> IntelligentComputer::_chooseFromProbability(vector<vector<int>> probabilityGrid) {
+pair<int, int> IntelligentComputer::_chooseFromProbability(const vector<vector<int>> &probabilityGrid) {
     int maxVal = 0; // Tracks the maximum value in the grid
     vector<pair<int, int>> maxCoords; // Tracks the location of those maximums
 
@@ -273,7 +417,7 @@ pair<int, int> IntelligentComputer::_chooseFromProbability(vector<vector<int>> p
     // This section is necessary in case all of the probabilities were 0, and then modulus doesn't work
     // because something mod 0 is undefined
     if(maxCoords.size() > 0) {
-        int randIndex = rand() % maxCoords.size();
+        int randIndex = _random() % maxCoords.size();
         return maxCoords.at(randIndex);
     }
 
@@ -281,39 +425,393 @@ pair<int, int> IntelligentComputer::_chooseFromProbability(vector<vector<int>> p
     return make_pair(0, 0);
 }
 
+// In destroy mode, a certain hit is worth this many nats of information (the best of 1, 3 and 100 in the benchmark)
+static const float DESTROY_HIT_WEIGHT = 3.0f;
+
+// Scores the most likely squares by the entropy of the outcome of a shot there (a miss, a hit, or sinking one of the
+// ships). Since the outcome is determined by where the ships are, that entropy is exactly how much the shot is expected
+// to narrow down the possible fleets. The outcome probabilities come from whole fleets sampled to fit everything known
+// so far, so they account for ships not overlapping, and in destroy mode for the hits the fleet has to cover
+pair<int, int> IntelligentComputer::_chooseByInformation(const vector<vector<int>> &probabilityGrid) {
+    // Collect the valid squares, most likely first
+    vector<pair<int, int>> ranked;
+    for(int i = 0; i < Board::GRID_SIZE; i++) {
+        for(int j = 0; j < Board::GRID_SIZE; j++) {
+            if(probabilityGrid.at(i).at(j) > 0 && _trackingBoard.validGuess(i, j)) {
+                ranked.push_back(make_pair(-probabilityGrid.at(i).at(j), cellIndex(i, j)));
+            }
+        }
+    }
+
+    // Nothing to score, so just fall back to the normal choice
+    if(ranked.empty()) {
+        return _chooseFromProbability(probabilityGrid);
+    }
+
+    // Only the top candidates are scored, since a square that rarely hits rarely tells us much
+    int numCandidates = min((int) ranked.size(), _entropyCandidates);
+    partial_sort(ranked.begin(), ranked.begin() + numCandidates, ranked.end());
+
+    // The ships afloat have to stay off misses and sunken ships, and cover the hits that can't be from sunken ones
+    vector<int> shipLengths;
+    for(int i = 0; i < _trackingFleet.size(); i++) {
+        if(!_trackingFleet.ship(i).isSunk()) {
+            shipLengths.push_back(_trackingFleet.ship(i).getLength());
+        }
+    }
+
+    CellMask required = _hitCells & ~_blockedCells & ~_sunkShipTracker.ambiguousCells();
+    int numSamples = _fleetSampler.sample(_blockedCells, _hitCells, required, shipLengths, _random);
+
+    if(numSamples == 0) {
+        return _chooseFromProbability(probabilityGrid);
+    }
+
+    // Tally each candidate's outcomes over the samples, then sum up -p log p over them
+    int numOutcomes = _fleetSampler.numOutcomes();
+    vector<int> tallies(numOutcomes);
+    vector<float> entropy(numCandidates, 0.0f);
+
+    for(int c = 0; c < numCandidates; c++) {
+        const unsigned char *outcomes = _fleetSampler.outcomes(ranked[c].second);
+        int *tally = tallies.data();
+
+        fill(tallies.begin(), tallies.end(), 0);
+
+        for(int sample = 0; sample < numSamples; sample++) {
+            tally[outcomes[sample]]++;
+        }
+
+        for(int outcome = 0; outcome < numOutcomes; outcome++) {
+            if(tally[outcome] > 0) {
+                float p = (float) tally[outcome] / numSamples;
+                entropy[c] -= p * log(p);
+            }
+        }
+
+        // While finishing off a ship, hitting it matters more than what the shot tells us, so the chance of a hit
+        // counts too (entropy alone would rather shoot a square that's as likely to miss as to hit)
+        if(!_hitList.empty()) {
+            entropy[c] += DESTROY_HIT_WEIGHT * (numSamples - tally[0]) / numSamples;
+        }
+    }
+
+    // Keep the candidate with the most information. Candidates are sorted by density, so ties go to the likelier
+    // square, and are only broken randomly between squares with the same density as well
+    vector<int> bestCells;
+    float bestScore = -1;
+    int bestDensity = 0;
+
+    for(int c = 0; c < numCandidates; c++) {
+        if(entropy.at(c) > bestScore + 1e-6f) {
+            bestScore = entropy.at(c);
+            bestDensity = ranked.at(c).first;
+
+            bestCells.clear();
+            bestCells.push_back(ranked.at(c).second);
+        } else if(entropy.at(c) > bestScore - 1e-6f && ranked.at(c).first == bestDensity) {
+            bestCells.push_back(ranked.at(c).second);
+        }
+    }
+
+    return cellCoords(bestCells.at(_random() % bestCells.size()));
+}
+
+// Tries to solve the rest of the game exactly, using the tracking board to narrow down where the ships could be
+bool IntelligentComputer::_solveEndgame(pair<int, int> &move) {
+    // Only try once the placements left for the ships afloat can't make up more configurations than the solver takes,
+    // so it doesn't spend every move finding out there are still too many
+    long maxConfigurations = _endgameSolver.getMaxConfigurations();
+
+    if(maxConfigurations == 0 || _placementCounts.fleetBound(maxConfigurations) > maxConfigurations) {
+        return false;
+    }
+
+    CellMask blocked;
+    CellMask hits;
+
+    // Misses and sunken ships (marked as SHIP) can't hold a ship that's still afloat, unresolved hits must. Squares
+    // already aimed at in a salvo are treated as misses, so they aren't chosen twice
+    for(int i = 0; i < Board::GRID_SIZE; i++) {
+        for(int j = 0; j < Board::GRID_SIZE; j++) {
+            Board::SquareState value = _trackingBoard._grid.at(i).at(j);
+
+            if(value == Board::MISS_MARKER || value == Board::SHIP || value == Board::AIMED_MARKER) {
+                blocked.set(cellIndex(i, j));
+            } else if(value == Board::HIT_MARKER) {
+                hits.set(cellIndex(i, j));
+            }
+        }
+    }
+
+    // Gather the lengths of all the ships that are still afloat
+    vector<int> shipLengths;
+    for(int i = 0; i < _trackingFleet.size(); i++) {
+        if(!_trackingFleet.ship(i).isSunk()) {
+            shipLengths.push_back(_trackingFleet.ship(i).getLength());
+        }
+    }
+
+    // Hits that might still belong to a sunken ship don't have to be covered by the ships afloat
+    CellMask required = hits & ~_sunkShipTracker.ambiguousCells();
+
+    // Too many possibilities (or none at all), so play normally
+    if(!_endgameSolver.enumerate(blocked, hits, required, shipLengths) || _endgameSolver.numConfigurations() == 0) {
+        return false;
+    }
+
+    double expectedShots;
+    int cell = _endgameSolver.solve(expectedShots);
+
+    if(cell < 0) {
+        return false;
+    }
+
+    move = cellCoords(cell);
+    return true;
+}
+
 // Allows the computer player to intelligent return a move
 pair<int, int> IntelligentComputer::getMove() {
-    vector<vector<int>> probabilityGrid;
+    return getMove(Deadline());
+}
+
+// Only the endgame solver can take long, so it's the part that watches the deadline. If the deadline expires, it
+// gives up, and the move falls back on the density, which is always quick to work out
+// The grid is worked out straight into the last density, which is kept for anyone studying the computer's choices
+pair<int, int> IntelligentComputer::getMove(const Deadline &deadline) {
+    vector<vector<int>> &probabilityGrid = _lastDensity;
+
+    // Late in the game, try solving the rest of the game exactly
+    pair<int, int> endgameMove;
+
+    _endgameSolver.setDeadline(&deadline);
+    bool solved = _solveEndgame(endgameMove);
+    _endgameSolver.setDeadline(nullptr);
+
+    if(solved) {
+        _clearProbabilityGrid(_lastDensity);
+        return endgameMove;
+    }
 
     // If the hit list is empty, we're in "search mode"
     if(_hitList.empty()) {
-        probabilityGrid = _findSearchProbability();
+        _findSearchProbability(probabilityGrid);
 
     // Otherwise, we're in destory mode
     } else {
-        probabilityGrid = _findDestroyProbability();
+        _findDestroyProbability(probabilityGrid);
         pair<int, int> maxPos = _chooseFromProbability(probabilityGrid);
 
-        // If it turns out the max value was 0, then something went wrong. Probably an ambiguous case when trying
-        // to determine which ship was sunk, which left some hits in the hit list which chould have been marked as sunk
+        // If it turns out the max value was 0, then something went wrong, since the sunk ship tracker only leaves hits
+        // in the hit list that a ship still afloat could cover. Use search mode for this move rather than guessing
+        // randomly, but keep the hit list, since later shots may still settle those hits
         if(probabilityGrid.at(maxPos.first).at(maxPos.second) == 0) {
-            // To accomodate, reset the hit list, and return to search mode
-            // If this isn't done, the computer starts guessing randomly
-            _hitList.clear();
-            probabilityGrid = _findSearchProbability();
+            _findSearchProbability(probabilityGrid);
         }
     }
 
+    // Pick between the most likely squares by how much their outcome would tell us
+    if(_targetingMode == INFORMATION_GAIN) {
+        return _chooseByInformation(probabilityGrid);
+    }
+
     // Return a move with one of the maximum mprobabilities for a hit
     return _chooseFromProbability(probabilityGrid);
 }
 
-// Intellignet player places them randomly, there doesn't seem to be a better strategy
+// Ships are placed by the adversarial search if it's turned on, otherwise randomly, unless there's a profile of where
+// the opponent likes to fire
 void IntelligentComputer::placeShips() {
-    placeShipsRandomly();
+    if(_adversarialBudget > 0) {
+        vector<int> shipLengths;
+        for(int i = 0; i < _primaryFleet.size(); i++) {
+            shipLengths.push_back(_primaryFleet.ship(i).getLength());
+        }
+
+        PlacementSearch search(shipLengths);
+        _placementSearchResult = search.search(_adversarialBudget, _random());
+
+        placeShipsAt(_placementSearchResult.placements);
+    } else if(_firingProfile.numGames() > 0) {
+        _placeShipsByProfile();
+    } else {
+        placeShipsRandomly();
+    }
+}
+
+ShotOutcome IntelligentComputer::fireShotAt(int xPos, int yPos) {
+    _opponentShots++;
+
+    int cell = cellIndex(xPos, yPos);
+    if(_opponentShotNumbers.at(cell) == 0) {
+        _opponentShotNumbers.at(cell) = _opponentShots;
+    }
+
+    return Player::fireShotAt(xPos, yPos);
 }
 
-// Intellignet player curently doesn't do anything upon game over
+void IntelligentComputer::fireShotsAt(const vector<pair<int, int>> &shots, vector<ShotOutcome> &outcomes) {
+    for(int i = 0; i < shots.size(); i++) {
+        _opponentShots++;
+
+        int cell = cellIndex(shots.at(i).first, shots.at(i).second);
+        if(_opponentShotNumbers.at(cell) == 0) {
+            _opponentShotNumbers.at(cell) = _opponentShots;
+        }
+    }
+
+    Player::fireShotsAt(shots, outcomes);
+}
+
+// The pretend misses are marked just like real ones (aimed on the tracking board, so they aren't chosen again), then
+// the state they touched is put back once the salvo is chosen. While finishing off hits, the squares around them are
+// the likeliest hits whatever else is in the salvo, so the salvo just takes them one after another (pretending the
+// first of them missed took longer to sink the fleet)
+vector<pair<int, int>> IntelligentComputer::getMoves(int count, const Deadline &deadline) {
+    if(count == 1 || !_hitList.empty()) {
+        return Player::getMoves(count, deadline);
+    }
+
+    PlacementCounts placementCounts = _placementCounts;
+    CellMask blockedCells = _blockedCells;
+    vector<pair<int, int>> moves;
+
+    for(int i = 0; i < count; i++) {
+        pair<int, int> move = getMove(deadline);
+
+        if(!_trackingBoard.validGuess(move.first, move.second)) {
+            break;
+        }
+
+        moves.push_back(move);
+
+        int cell = cellIndex(move.first, move.second);
+        _trackingBoard.setAimed(move.first, move.second, true);
+        _placementCounts.markMiss(cell);
+        _blockedCells.set(cell);
+    }
+
+    for(int i = 0; i < moves.size(); i++) {
+        _trackingBoard.setAimed(moves.at(i).first, moves.at(i).second, false);
+    }
+
+    _placementCounts = placementCounts;
+    _blockedCells = blockedCells;
+
+    return moves;
+}
+
+// Upon winning, every square the opponent's ships were on has been hit, so add the fleet to their placement model
+// (unless the opponent forfeited, and only part of it was found). Win or lose, add where they fired to their firing
+// profile
 void IntelligentComputer::reportGameover(bool winner) {
-    return;
+    int fleetSquares = 0;
+    for(int i = 0; i < _trackingFleet.size(); i++) {
+        fleetSquares += _trackingFleet.ship(i).getLength();
+    }
+
+    if(winner && _placementPrior.isOpen() && _hitCells.count() == fleetSquares) {
+        _placementPrior.recordFleet(_hitCells);
+    }
+
+    _firingProfile.recordGame(_opponentShotNumbers);
+}
+
+// Each ship is drawn from the placements that fit, weighted by how late the opponent reaches the earliest square of
+// the placement (the ship is found as soon as any square is). Whole fleets are scored by adding up those squares'
+// scores, and the best fleet sampled before the time runs out is placed. Only taking the best of a few samples keeps
+// the placement from being predictable
+void IntelligentComputer::_placeShipsByProfile() {
+    // How strongly the sampler prefers late squares, and the most fleets it samples
+    const double SHARPNESS = 4.0;
+    const int MAX_SAMPLES = 16;
+
+    chrono::steady_clock::time_point deadline = chrono::steady_clock::now() +
+            chrono::microseconds((long) (_placementBudget * 1000));
+
+    vector<double> cellScores = _firingProfile.cellScores();
+
+    // Score and sampling weight of every placement of each ship
+    vector<vector<double>> placementScores(_primaryFleet.size());
+    vector<vector<double>> placementWeights(_primaryFleet.size());
+
+    for(int i = 0; i < _primaryFleet.size(); i++) {
+        const vector<Placement> &placements = PlacementTable::forLength(_primaryFleet.ship(i).getLength()).placements();
+
+        for(int j = 0; j < placements.size(); j++) {
+            double earliest = cellScores.at(placements.at(j).cells.at(0));
+
+            for(int k = 1; k < placements.at(j).cells.size(); k++) {
+                earliest = min(earliest, cellScores.at(placements.at(j).cells.at(k)));
+            }
+
+            placementScores.at(i).push_back(earliest);
+            placementWeights.at(i).push_back(pow(earliest, SHARPNESS));
+        }
+    }
+
+    vector<int> bestFleet;
+    double bestScore = -1;
+
+    // Always finish at least one sample, even if the budget has run out
+    for(int sample = 0; sample < MAX_SAMPLES; sample++) {
+        if(!bestFleet.empty() && chrono::steady_clock::now() >= deadline) {
+            break;
+        }
+
+        vector<int> fleet;
+        CellMask occupied;
+        double score = 0;
+
+        for(int i = 0; i < _primaryFleet.size(); i++) {
+            const vector<Placement> &placements =
+                    PlacementTable::forLength(_primaryFleet.ship(i).getLength()).placements();
+
+            // Total weight of the placements that don't overlap the ships placed so far
+            double total = 0;
+            for(int j = 0; j < placements.size(); j++) {
+                if((placements.at(j).mask & occupied).none()) {
+                    total += placementWeights.at(i).at(j);
+                }
+            }
+
+            // Then pick one of them with probability proportional to its weight
+            double target = uniform_real_distribution<double>(0, total)(_random);
+            int chosen = -1;
+
+            for(int j = 0; j < placements.size(); j++) {
+                if((placements.at(j).mask & occupied).none()) {
+                    chosen = j;
+                    target -= placementWeights.at(i).at(j);
+
+                    if(target < 0) {
+                        break;
+                    }
+                }
+            }
+
+            // Boxed in (which can only happen with an unusually large fleet), so this sample is no good
+            if(chosen < 0) {
+                break;
+            }
+
+            fleet.push_back(chosen);
+            occupied |= placements.at(chosen).mask;
+            score += placementScores.at(i).at(chosen);
+        }
+
+        if(fleet.size() == _primaryFleet.size() && score > bestScore) {
+            bestFleet = fleet;
+            bestScore = score;
+        }
+    }
+
+    // If no complete fleet could be sampled, fall back on placing the ships randomly
+    if(bestFleet.empty()) {
+        placeShipsRandomly();
+        return;
+    }
+
+    placeShipsAt(bestFleet);
 }
\ No newline at end of file
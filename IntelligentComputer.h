@@ -12,53 +12,190 @@
 #include <vector>
 #include <utility>
 
+#include "AIParameters.h"
 #include "Board.h"
+#include "EndgameSolver.h"
+#include "FiringProfile.h"
+#include "FleetSampler.h"
+#include "HitClusters.h"
+#include "PlacementCounts.h"
+#include "PlacementSearch.h"
 #include "Player.h"
 #include "Ship.h"
+#include "SunkShipTracker.h"
 
 using namespace std;
 
 class IntelligentComputer : public Player {
 public:
-    using Player::Player;  // Just use the Player constructor, there are no extra data members to initialize
+    IntelligentComputer(string name, vector<int> shipLengths);
 
     // Overrid the three main methods of the player class
     pair<int, int> getMove() override;
+
+    // And the deadline version of getMove, which stops thinking and plays its best move so far once time runs out
+    pair<int, int> getMove(const Deadline &deadline) override;
     void placeShips() override;
     void reportGameover(bool winner) override;
 
     // Also override the mark shot function to perform extra analysis on which ships were sunken
     void markShot(int xPos, int yPos, ShotOutcome outcome) override;
 
+    // And the fire shot functions, to remember when the opponent fired at each square
+    ShotOutcome fireShotAt(int xPos, int yPos) override;
+    void fireShotsAt(const vector<pair<int, int>> &shots, vector<ShotOutcome> &outcomes) override;
+
+    // Chooses a salvo so that its shots tell the computer as much as possible together: in search mode, each shot is
+    // chosen as if the ones before it missed, so the salvo covers as many different placements as it can, rather than
+    // taking the top few squares of one density (which are usually next to each other, and cover the same placements)
+    vector<pair<int, int>> getMoves(int count, const Deadline &deadline = Deadline()) override;
+
+    // Loads what's been learned about where the opponent places their ships
+    void reportOpponent(string name) override;
+
+    // Forgets the shots of the last game, but keeps what's been loaded about the opponent
+    void resetState() override;
+
+    // Whether to learn (and use) a placement prior for each opponent the game reports (off by default). The prior is
+    // kept in prior_<opponent>.bin in the working directory
+    void setPlacementLearning(bool enabled);
+
+    // Whether to learn where each opponent fires, and place ships where they look last (off by default). The profile
+    // is kept in profile_<opponent>.bin in the working directory
+    void setFiringProfiling(bool enabled);
+
+    // How long placing ships from the firing profile may take, in milliseconds
+    void setPlacementBudget(double milliseconds);
+
+    // Spend the given number of milliseconds searching for the placement that survives longest against simulated
+    // IntelligentComputer hunters (see PlacementSearch), instead of placing from the firing profile (0 turns it off)
+    void setAdversarialPlacement(double milliseconds);
+
+    // What the adversarial placement search expects of the fleet it placed (empty placements if it wasn't used)
+    PlacementSearchResult getPlacementSearchResult();
+
+    // Sets the parameters computers are created with (e.g. loaded from AIParameters::DEFAULT_FILE at startup)
+    // Not thread safe, so call it before creating any computers
+    static void setDefaultParameters(const AIParameters &parameters);
+
+    // Applies a whole set of parameters at once
+    void setParameters(const AIParameters &parameters);
+
+    // Once this few fleet configurations remain possible, the computer plays the rest of the game exactly
+    // (0 turns the endgame solver off)
+    void setEndgameThreshold(int maxConfigurations);
+
+    // In search mode, only consider squares on a lattice spaced by the length of the shortest ship still afloat
+    // (off by default)
+    void setLatticePruning(bool enabled);
+
+    // How the computer picks between the squares most likely to hold a ship. DENSITY just takes the most likely one,
+    // INFORMATION_GAIN looks at the top few and takes the one whose outcome (a miss, a hit, or sinking a ship) tells it
+    // the most about where the ships are, judged over fleets sampled to fit what it knows
+    enum TargetingMode {DENSITY, INFORMATION_GAIN};
+
+    // Sets the targeting mode, and how many of the most likely squares INFORMATION_GAIN scores
+    void setTargetingMode(TargetingMode mode, int candidates = 4);
+
+    // The probability grid the last move was chosen from, indexed [xPos][yPos]. All zeros if the endgame solver
+    // chose the move, since the grid isn't worked out then
+    const vector<vector<int>> &getLastDensity() const;
+
+    // Adds the parity lattice to the state a GameSnapshot saves, since it depends on when it was built rather than
+    // just on the shots (everything else the computer knows comes back from replaying them)
+    void saveState(vector<uint32_t> &state) override;
+    bool restoreState(const vector<uint32_t> &state, size_t &position) override;
+
 private:
+    static AIParameters _defaultParameters;
+
     // Vector of hits that haven't led to sunken ships yet
     vector<pair<int, int>> _hitList;
 
-    // The vector to store the last hit (to determine the direction of a sunken ship is likely in)
-    pair<int, int> _lastHit;
+    // The hits in the hit list, grouped into connected clusters
+    HitClusters _hitClusters;
+
+    // Every square that has been hit, and every square no ship still afloat can cover (misses and sunken ships)
+    CellMask _hitCells;
+    CellMask _blockedCells;
 
-    // Marks a series of hits a ship, once its confirmed the ship was sunk
-    void _markAsSunk(int xPos, int yPos, int getLength);
+    // Works out which hits belong to sunken ships, from the index of each ship sunk and its length
+    SunkShipTracker _sunkShipTracker;
 
-    // Helper function for marking a ships positino as sunk
-    // Determines the number of consecutive hits in a direction
-    void _findConsecutiveShots(int xPos, int yPos, int length, bool horizontal, pair<int, int> &start, int &consecutiveHits);
-    void _markSquaresAsSunk(pair<int, int> start, pair<int, int> direction, int length, int consecutiveHits);
+    // Marks the squares the sunk ship tracker has resolved as sunk
+    void _markResolvedSquares();
 
     // Returns a blank grid in which its possible to store the probability of a ship being in each location
     vector<vector<int>> _newProbabilityGrid();
 
-    // Similar to "placeShip", but adds to the probabiltiy density grid
-    void _addToDensity(Ship ship, vector<vector<int>> &probabilityGrid);
+    // Zeroes a probability grid, so it can be filled in again
+    void _clearProbabilityGrid(vector<vector<int>> &probabilityGrid);
+
+    // Fills in a probability grid in "search" mode, when no hits have been identified
+    void _findSearchProbability(vector<vector<int>> &probabilityGrid);
+
+    // Parity lattice for search mode: the squares to search, and the spacing it was built for
+    bool _latticePruning;
+    int _latticeSpacing;
+    CellMask _lattice;
+
+    // Rebuilds the lattice if the shortest ship still afloat has changed
+    void _updateLattice();
 
-    // Returns a probability grid in "search" mode, when no hits have been identified
-    vector<vector<int>> _findSearchProbability();
+    // Fills in a probability grid in "destory" mode, when a hit has been found, from the most constrained cluster of
+    // hits
+    void _findDestroyProbability(vector<vector<int>> &probabilityGrid);
 
-    // Returns a probability grid in "destory" mode, when a hit has been found
-    vector<vector<int>> _findDestroyProbability();
+    // The probability grid behind the last move, and the grid each cluster is scored in (both reused from move to
+    // move, so working out the density doesn't allocate)
+    vector<vector<int>> _lastDensity;
+    vector<vector<int>> _clusterGrid;
 
     // Selects a move from a probaility grid (random move with maximum probability)
-    pair<int, int> _chooseFromProbability(vector<vector<int>> probabilityGrid);
+    pair<int, int> _chooseFromProbability(const vector<vector<int>> &probabilityGrid);
+
+    // Selects a move from the most likely squares in the probability grid, by the information its outcome would give
+    pair<int, int> _chooseByInformation(const vector<vector<int>> &probabilityGrid);
+
+    // Marks a square of the tracking board as belonging to a sunken ship
+    void _markCellSunk(int xPos, int yPos);
+
+    // Targeting mode and number of candidate squares for INFORMATION_GAIN, and the fleets it scores them over
+    TargetingMode _targetingMode;
+    int _entropyCandidates;
+    FleetSampler _fleetSampler;
+
+    // Number of ways each ship could be placed over each square, kept up to date as shots are marked
+    PlacementCounts _placementCounts;
+
+    // Where the current opponent tends to place their ships, if the game told us who they are
+    bool _placementLearning;
+    PlacementPrior _placementPrior;
+
+    // Weight of a placement of a ship of the given length under the prior (1 with no prior)
+    int _placementWeight(int length, int placement);
+
+    // Where the current opponent tends to fire, and the shot number they fired at each square this game
+    bool _firingProfiling;
+    FiringProfile _firingProfile;
+    vector<int> _opponentShotNumbers;
+    int _opponentShots;
+
+    // Time allowed for _placeShipsByProfile, in milliseconds
+    double _placementBudget;
+
+    // Samples fleets favoring the squares the opponent gets to late, and places the best one found in the time budget
+    void _placeShipsByProfile();
+
+    // Time given to the adversarial placement search, and what it found
+    double _adversarialBudget;
+    PlacementSearchResult _placementSearchResult;
+
+    // Solver for the end of the game, when few enough configurations remain to search them all
+    EndgameSolver _endgameSolver;
+
+    // Returns true, and sets the move, if the endgame solver was able to solve the current position
+    bool _solveEndgame(pair<int, int> &move);
 };
 
 
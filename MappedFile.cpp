@@ -0,0 +1,158 @@
+/* MappedFile.cpp
+ *
+ * Author: Colin Siles
+ *
+ * The MappedFile class maps a small fixed size file into memory for reading and writing. The learned models (see
+ * PlacementPrior and FiringProfile) are stored this way, so that loading them costs next to nothing, and so that
+ * updating them only touches a few integers in place. Files of any size can also be mapped just for reading, which is
+ * how binary battlelogs are read
+*/
+
+#include <cctype>
+#include <cerrno>
+#include <iostream>
+
+#include <fcntl.h>
+#include <sys/file.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include "MappedFile.h"
+
+MappedFile::MappedFile() {
+    _data = nullptr;
+    _size = 0;
+    _fileDescriptor = -1;
+}
+
+MappedFile::~MappedFile() {
+    close();
+}
+
+bool MappedFile::open(string filename, size_t size, bool &created) {
+    close();
+
+    _fileDescriptor = ::open(filename.c_str(), O_RDWR | O_CREAT, 0644);
+    if(_fileDescriptor < 0) {
+        cerr << "Failed to open " << filename << endl;
+        return false;
+    }
+
+    // A new (empty) file has to be grown to the right size before it can be mapped. Locked, so that two programs
+    // opening the file at once can't both recreate it
+    lock(true);
+
+    struct stat info;
+    created = fstat(_fileDescriptor, &info) != 0 || info.st_size != size;
+
+    if(created && (ftruncate(_fileDescriptor, 0) != 0 || ftruncate(_fileDescriptor, size) != 0)) {
+        cerr << "Failed to create " << filename << endl;
+        close();
+        return false;
+    }
+
+    unlock();
+
+    void *mapped = mmap(nullptr, size, PROT_READ | PROT_WRITE, MAP_SHARED, _fileDescriptor, 0);
+    if(mapped == MAP_FAILED) {
+        cerr << "Failed to map " << filename << endl;
+        close();
+        return false;
+    }
+
+    _data = mapped;
+    _size = size;
+
+    return true;
+}
+
+bool MappedFile::openReadOnly(string filename) {
+    close();
+
+    _fileDescriptor = ::open(filename.c_str(), O_RDONLY);
+    if(_fileDescriptor < 0) {
+        cerr << "Failed to open " << filename << endl;
+        return false;
+    }
+
+    // Empty files can't be mapped
+    struct stat info;
+    if(fstat(_fileDescriptor, &info) != 0 || info.st_size == 0) {
+        cerr << filename << " is empty" << endl;
+        close();
+        return false;
+    }
+
+    void *mapped = mmap(nullptr, info.st_size, PROT_READ, MAP_SHARED, _fileDescriptor, 0);
+    if(mapped == MAP_FAILED) {
+        cerr << "Failed to map " << filename << endl;
+        close();
+        return false;
+    }
+
+    // Read-only files are read from start to end, so the kernel can read ahead
+    madvise(mapped, info.st_size, MADV_SEQUENTIAL);
+
+    _data = mapped;
+    _size = info.st_size;
+
+    return true;
+}
+
+void MappedFile::close() {
+    if(_data) {
+        munmap(_data, _size);
+        _data = nullptr;
+    }
+
+    if(_fileDescriptor >= 0) {
+        ::close(_fileDescriptor);
+        _fileDescriptor = -1;
+    }
+}
+
+bool MappedFile::isOpen() const {
+    return _data != nullptr;
+}
+
+void *MappedFile::data() const {
+    return _data;
+}
+
+size_t MappedFile::size() const {
+    return _size;
+}
+
+void MappedFile::sync() {
+    if(_data) {
+        msync(_data, _size, MS_ASYNC);
+    }
+}
+
+void MappedFile::lock(bool exclusive) const {
+    if(_fileDescriptor < 0) {
+        return;
+    }
+
+    while(flock(_fileDescriptor, exclusive ? LOCK_EX : LOCK_SH) != 0 && errno == EINTR) {
+    }
+}
+
+void MappedFile::unlock() const {
+    if(_fileDescriptor >= 0) {
+        flock(_fileDescriptor, LOCK_UN);
+    }
+}
+
+string MappedFile::filenameFor(string prefix, string name) {
+    string safeName;
+
+    // Only keep characters that are safe in a filename
+    for(int i = 0; i < name.size(); i++) {
+        char current = name.at(i);
+        safeName += isalnum(current) ? current : '_';
+    }
+
+    return prefix + "_" + safeName + ".bin";
+}
@@ -0,0 +1,55 @@
+/* MappedFile.h
+ *
+ * Author: Colin Siles
+ *
+ * The MappedFile class maps a small fixed size file into memory for reading and writing. The learned models (see
+ * PlacementPrior and FiringProfile) are stored this way, so that loading them costs next to nothing, and so that
+ * updating them only touches a few integers in place. Files of any size can also be mapped just for reading, which is
+ * how binary battlelogs are read
+*/
+
+#ifndef SFML_TEMPLATE_MAPPEDFILE_H
+#define SFML_TEMPLATE_MAPPEDFILE_H
+
+#include <cstddef>
+#include <string>
+
+using namespace std;
+
+class MappedFile {
+public:
+    MappedFile();
+    ~MappedFile(); // Destructor, for unmapping the file
+
+    // Maps the file, creating it if it doesn't exist yet. A file of any other size is recreated, since it can't hold
+    // the expected data. Sets created if the file is new (and so filled with zeros). Returns false if that fails
+    bool open(string filename, size_t size, bool &created);
+
+    // Maps an existing file, whatever its size, for reading only (writing to data() would crash). Returns false if the
+    // file doesn't exist or is empty
+    bool openReadOnly(string filename);
+    void close();
+    bool isOpen() const;
+
+    // The mapped memory (nullptr if the file isn't open)
+    void *data() const;
+    size_t size() const;
+
+    // Asks for changes to be written back to the disk, so they aren't lost if the program doesn't exit cleanly
+    void sync();
+
+    // Locks the file until unlock is called, against every other MappedFile of it (in this process or another).
+    // Updates need an exclusive lock; a shared lock only keeps out updates, so several readers can hold one at once
+    void lock(bool exclusive) const;
+    void unlock() const;
+
+    // Returns "<prefix>_<name>.bin", with any characters in the name that aren't safe in a filename replaced
+    static string filenameFor(string prefix, string name);
+
+private:
+    void *_data;
+    size_t _size;
+    int _fileDescriptor;
+};
+
+#endif //SFML_TEMPLATE_MAPPEDFILE_H
@@ -0,0 +1,61 @@
+/* MatchProtocol.h
+ *
+ * Author: Colin Siles
+ *
+ * The binary protocol spoken between the MatchServer and its clients. Every message is four bytes: a type, then three
+ * arguments (unused ones are 0), so messages never need to be split or length-prefixed
+ *
+ * Client to server:
+ *   MATCH_START <opponent>           Starts a game against the server's random (0) or intelligent (1) computer. The
+ *                                    client's ships are placed randomly by the server
+ *   MATCH_MOVE <x> <y>               The client's shot, in answer to a MATCH_MOVE_REQUEST. A shot off the board
+ *                                    forfeits the game
+ *
+ * Server to client:
+ *   MATCH_MOVE_REQUEST               The client's turn (sent again if the last move wasn't valid)
+ *   MATCH_OUTCOME <x> <y> <outcome>  How the client's shot went
+ *   MATCH_INCOMING <x> <y> <outcome> Where the server's computer shot, and how it went
+ *   MATCH_GAME_OVER <won>            1 if the client won. The client can start another game on the same connection
+*/
+
+#ifndef SFML_TEMPLATE_MATCHPROTOCOL_H
+#define SFML_TEMPLATE_MATCHPROTOCOL_H
+
+#include <cstdint>
+
+#include "Board.h"
+
+enum MatchMessageType : uint8_t {MATCH_START = 1, MATCH_MOVE, MATCH_MOVE_REQUEST, MATCH_OUTCOME, MATCH_INCOMING,
+                                 MATCH_GAME_OVER};
+
+struct MatchMessage {
+    uint8_t type;
+    uint8_t args[3];
+};
+
+// Opponents a client can ask for
+static const uint8_t MATCH_RANDOM_OPPONENT = 0;
+static const uint8_t MATCH_INTELLIGENT_OPPONENT = 1;
+
+// Outcomes are sent as MATCH_MISS, MATCH_HIT, or MATCH_SUNK plus the index of the ship that was sunk
+static const uint8_t MATCH_MISS = 0;
+static const uint8_t MATCH_HIT = 1;
+static const uint8_t MATCH_SUNK = 2;
+
+inline uint8_t encodeOutcome(ShotOutcome outcome) {
+    if(outcome.sunkenIndex >= 0) {
+        return MATCH_SUNK + outcome.sunkenIndex;
+    }
+
+    return outcome.hit ? MATCH_HIT : MATCH_MISS;
+}
+
+inline ShotOutcome decodeOutcome(uint8_t outcome) {
+    if(outcome >= MATCH_SUNK) {
+        return {true, outcome - MATCH_SUNK};
+    }
+
+    return {outcome == MATCH_HIT, -1};
+}
+
+#endif //SFML_TEMPLATE_MATCHPROTOCOL_H
@@ -0,0 +1,396 @@
+/* MatchServer.cpp
+ *
+ * Author: Colin Siles
+ *
+ * The MatchServer class hosts games for clients connecting over TCP or a Unix domain socket, using the binary protocol
+ * in MatchProtocol.h. One thread runs an epoll loop that accepts connections and reads the clients' moves; the games
+ * themselves run on a small Scheduler pool, and only hold a thread while a computer is choosing its move
+*/
+
+#include <cerrno>
+#include <cstring>
+#include <iostream>
+
+#include <fcntl.h>
+#include <netinet/in.h>
+#include <netinet/tcp.h>
+#include <sys/epoll.h>
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <unistd.h>
+
+#include "MatchServer.h"
+
+// Events handled per call to epoll_wait, and how often the loop checks whether it's been stopped
+static const int MAX_EVENTS = 256;
+static const int STOP_CHECK_MILLISECONDS = 100;
+
+// Every game is played with the standard fleet
+static const vector<int> SHIP_LENGTHS = {5, 4, 4, 3, 2};
+
+MatchServer::MatchServer(int numThreads) : _scheduler(numThreads) {
+    _epoll = epoll_create1(EPOLL_CLOEXEC);
+    _listener = -1;
+    _stopping = false;
+    _activeGames = 0;
+    _finishedGames = 0;
+}
+
+MatchServer::~MatchServer() {
+    // Closing the connections forfeits their games, so the pool can finish them off
+    while(!_connections.empty()) {
+        _close(_connections.begin()->second);
+    }
+
+    _scheduler.waitIdle();
+
+    if(_listener >= 0) {
+        close(_listener);
+    }
+
+    if(!_unixPath.empty()) {
+        unlink(_unixPath.c_str());
+    }
+
+    close(_epoll);
+}
+
+bool MatchServer::listenTcp(int port) {
+    int listener = socket(AF_INET, SOCK_STREAM | SOCK_NONBLOCK | SOCK_CLOEXEC, 0);
+
+    int reuse = 1;
+    setsockopt(listener, SOL_SOCKET, SO_REUSEADDR, &reuse, sizeof(reuse));
+
+    struct sockaddr_in address = {};
+    address.sin_family = AF_INET;
+    address.sin_addr.s_addr = htonl(INADDR_ANY);
+    address.sin_port = htons(port);
+
+    if(bind(listener, (struct sockaddr *) &address, sizeof(address)) != 0) {
+        cerr << "Failed to listen on port " << port << ": " << strerror(errno) << endl;
+        close(listener);
+        return false;
+    }
+
+    return _listen(listener);
+}
+
+bool MatchServer::listenUnix(string path) {
+    struct sockaddr_un address = {};
+    address.sun_family = AF_UNIX;
+
+    if(path.size() >= sizeof(address.sun_path)) {
+        cerr << "The socket path " << path << " is too long" << endl;
+        return false;
+    }
+
+    strcpy(address.sun_path, path.c_str());
+    unlink(path.c_str());
+
+    int listener = socket(AF_UNIX, SOCK_STREAM | SOCK_NONBLOCK | SOCK_CLOEXEC, 0);
+
+    if(bind(listener, (struct sockaddr *) &address, sizeof(address)) != 0) {
+        cerr << "Failed to listen on " << path << ": " << strerror(errno) << endl;
+        close(listener);
+        return false;
+    }
+
+    _unixPath = path;
+    return _listen(listener);
+}
+
+void MatchServer::run() {
+    epoll_event events[MAX_EVENTS];
+
+    while(!_stopping) {
+        int numEvents = epoll_wait(_epoll, events, MAX_EVENTS, STOP_CHECK_MILLISECONDS);
+
+        for(int i = 0; i < numEvents; i++) {
+            int socket = events[i].data.fd;
+
+            if(socket == _listener) {
+                _accept();
+                continue;
+            }
+
+            // The connection may have been closed by an earlier event in this batch
+            auto found = _connections.find(socket);
+            if(found == _connections.end()) {
+                continue;
+            }
+
+            shared_ptr<Connection> connection = found->second;
+
+            if(events[i].events & EPOLLOUT) {
+                _flush(connection.get());
+            }
+
+            if(events[i].events & (EPOLLIN | EPOLLHUP | EPOLLERR)) {
+                _read(connection);
+            }
+        }
+    }
+}
+
+void MatchServer::stop() {
+    _stopping = true;
+}
+
+int MatchServer::getActiveGames() {
+    return _activeGames;
+}
+
+long MatchServer::getFinishedGames() {
+    return _finishedGames;
+}
+
+bool MatchServer::_listen(int listener) {
+    if(listen(listener, SOMAXCONN) != 0) {
+        cerr << "Failed to listen: " << strerror(errno) << endl;
+        close(listener);
+        return false;
+    }
+
+    epoll_event event = {};
+    event.events = EPOLLIN;
+    event.data.fd = listener;
+    epoll_ctl(_epoll, EPOLL_CTL_ADD, listener, &event);
+
+    _listener = listener;
+    return true;
+}
+
+void MatchServer::_accept() {
+    while(true) {
+        int socket = accept4(_listener, nullptr, nullptr, SOCK_NONBLOCK | SOCK_CLOEXEC);
+
+        if(socket < 0) {
+            return;
+        }
+
+        // Messages are tiny, so they shouldn't wait to be batched up (this fails harmlessly on Unix sockets)
+        int noDelay = 1;
+        setsockopt(socket, IPPROTO_TCP, TCP_NODELAY, &noDelay, sizeof(noDelay));
+
+        shared_ptr<Connection> connection = make_shared<Connection>();
+        connection->socket = socket;
+        connection->partialSize = 0;
+        connection->queuedStart = -1;
+        connection->waitingForRoom = false;
+        connection->closed = false;
+
+        _connections[socket] = connection;
+
+        epoll_event event = {};
+        event.events = EPOLLIN;
+        event.data.fd = socket;
+        epoll_ctl(_epoll, EPOLL_CTL_ADD, socket, &event);
+    }
+}
+
+void MatchServer::_read(const shared_ptr<Connection> &connection) {
+    uint8_t buffer[4096];
+
+    while(true) {
+        ssize_t result = recv(connection->socket, buffer, sizeof(buffer), 0);
+
+        if(result < 0 && errno == EINTR) {
+            continue;
+        }
+
+        if(result < 0 && (errno == EAGAIN || errno == EWOULDBLOCK)) {
+            return;
+        }
+
+        // The client hung up (or something went wrong with the connection)
+        if(result <= 0) {
+            _close(connection);
+            return;
+        }
+
+        for(int i = 0; i < result; i++) {
+            connection->partial[connection->partialSize++] = buffer[i];
+
+            if(connection->partialSize == sizeof(MatchMessage)) {
+                MatchMessage message;
+                memcpy(&message, connection->partial, sizeof(message));
+                connection->partialSize = 0;
+
+                _handle(connection, message);
+            }
+        }
+    }
+}
+
+void MatchServer::_handle(const shared_ptr<Connection> &connection, const MatchMessage &message) {
+    lock_guard<mutex> lock(connection->gameMutex);
+
+    NetworkPlayer *client = nullptr;
+    if(connection->randomGame) {
+        client = &connection->randomGame->getPlayerOne();
+    } else if(connection->intelligentGame) {
+        client = &connection->intelligentGame->getPlayerOne();
+    }
+
+    if(message.type == MATCH_MOVE) {
+        // Moves outside a game are ignored
+        if(client) {
+            client->submitMove(message.args[0], message.args[1]);
+        }
+
+        return;
+    }
+
+    if(message.type != MATCH_START) {
+        return;
+    }
+
+    // The client may ask for the next game as soon as it hears the last one is over, before the game has finished
+    // cleaning up, so the request waits for it
+    if(client) {
+        connection->queuedStart = message.args[0];
+        return;
+    }
+
+    _startGame(connection, message.args[0]);
+}
+
+void MatchServer::_startGame(const shared_ptr<Connection> &connection, int opponent) {
+    NetworkPlayer *client;
+
+    // No battlelog, since there could be thousands of games at once
+    if(opponent == MATCH_INTELLIGENT_OPPONENT) {
+        connection->intelligentGame = make_unique<Game<NetworkPlayer, IntelligentComputer>>("Client", "Computer",
+                                                                                           SHIP_LENGTHS, "");
+
+        // The computer would otherwise learn from (and write files for) every client, all under the same name
+        IntelligentComputer &computer = connection->intelligentGame->getPlayerTwo();
+        computer.setPlacementLearning(false);
+        computer.setFiringProfiling(false);
+
+        client = &connection->intelligentGame->getPlayerOne();
+    } else {
+        connection->randomGame = make_unique<Game<NetworkPlayer, RandomComputerPlayer>>("Client", "Computer",
+                                                                                        SHIP_LENGTHS, "");
+
+        client = &connection->randomGame->getPlayerOne();
+    }
+
+    // The connection outlives the game (see _play), so the callback can hold on to it directly
+    Connection *raw = connection.get();
+    client->setScheduler(&_scheduler);
+    client->setMessageCallback([this, raw](const MatchMessage &message) {
+        _send(raw, message);
+    });
+
+    _activeGames++;
+    _scheduler.spawn(_play(connection));
+}
+
+void MatchServer::_close(shared_ptr<Connection> connection) {
+    epoll_ctl(_epoll, EPOLL_CTL_DEL, connection->socket, nullptr);
+    _connections.erase(connection->socket);
+
+    // Closed while holding the lock, so a game's thread can't write to the socket number after it's reused
+    {
+        lock_guard<mutex> lock(connection->outMutex);
+        close(connection->socket);
+        connection->socket = -1;
+    }
+
+    // A game still waiting on the client is forfeited
+    lock_guard<mutex> lock(connection->gameMutex);
+    connection->closed = true;
+
+    if(connection->randomGame) {
+        connection->randomGame->getPlayerOne().submitMove(-1, -1);
+    } else if(connection->intelligentGame) {
+        connection->intelligentGame->getPlayerOne().submitMove(-1, -1);
+    }
+}
+
+// Messages are only written once the client has to answer (or the game is over), so a whole turn goes out in one write
+void MatchServer::_send(Connection *connection, const MatchMessage &message) {
+    lock_guard<mutex> lock(connection->outMutex);
+
+    if(connection->socket < 0) {
+        return;
+    }
+
+    bool waiting = connection->waitingForRoom;
+    connection->outBuffer.append((const char *) &message, sizeof(message));
+
+    if(waiting || (message.type != MATCH_MOVE_REQUEST && message.type != MATCH_GAME_OVER)) {
+        return;
+    }
+
+    while(!connection->outBuffer.empty()) {
+        ssize_t result = send(connection->socket, connection->outBuffer.data(), connection->outBuffer.size(),
+                              MSG_NOSIGNAL | MSG_DONTWAIT);
+
+        if(result <= 0) {
+            break;
+        }
+
+        connection->outBuffer.erase(0, result);
+    }
+
+    // Have the event loop finish the job once there's room
+    if(!connection->outBuffer.empty()) {
+        connection->waitingForRoom = true;
+
+        epoll_event event = {};
+        event.events = EPOLLIN | EPOLLOUT;
+        event.data.fd = connection->socket;
+        epoll_ctl(_epoll, EPOLL_CTL_MOD, connection->socket, &event);
+    }
+}
+
+void MatchServer::_flush(Connection *connection) {
+    lock_guard<mutex> lock(connection->outMutex);
+
+    if(connection->socket < 0) {
+        return;
+    }
+
+    while(!connection->outBuffer.empty()) {
+        ssize_t result = send(connection->socket, connection->outBuffer.data(), connection->outBuffer.size(),
+                              MSG_NOSIGNAL | MSG_DONTWAIT);
+
+        // Still full (if the connection is broken, reading will find out)
+        if(result <= 0) {
+            return;
+        }
+
+        connection->outBuffer.erase(0, result);
+    }
+
+    connection->waitingForRoom = false;
+
+    epoll_event event = {};
+    event.events = EPOLLIN;
+    event.data.fd = connection->socket;
+    epoll_ctl(_epoll, EPOLL_CTL_MOD, connection->socket, &event);
+}
+
+Task<void> MatchServer::_play(shared_ptr<Connection> connection) {
+    if(connection->randomGame) {
+        co_await connection->randomGame->runGameAsync();
+    } else {
+        co_await connection->intelligentGame->runGameAsync();
+    }
+
+    _activeGames--;
+    _finishedGames++;
+
+    // Free the game, and start the next one if the client has already asked for it
+    lock_guard<mutex> lock(connection->gameMutex);
+    connection->randomGame.reset();
+    connection->intelligentGame.reset();
+
+    if(connection->queuedStart >= 0 && !connection->closed) {
+        _startGame(connection, connection->queuedStart);
+    }
+
+    connection->queuedStart = -1;
+}
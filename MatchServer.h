@@ -0,0 +1,102 @@
+/* MatchServer.h
+ *
+ * Author: Colin Siles
+ *
+ * The MatchServer class hosts games for clients connecting over TCP or a Unix domain socket, using the binary protocol
+ * in MatchProtocol.h. One thread runs an epoll loop that accepts connections and reads the clients' moves; the games
+ * themselves run on a small Scheduler pool, and only hold a thread while a computer is choosing its move. Each
+ * connection plays one game at a time, against a computer on the server
+*/
+
+#ifndef SFML_TEMPLATE_MATCHSERVER_H
+#define SFML_TEMPLATE_MATCHSERVER_H
+
+#include <atomic>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <string>
+
+#include "Game.h"
+#include "IntelligentComputer.h"
+#include "NetworkPlayer.h"
+#include "RandomComputerPlayer.h"
+#include "Scheduler.h"
+
+using namespace std;
+
+class MatchServer {
+public:
+    // Runs the games on the given number of threads
+    MatchServer(int numThreads);
+    ~MatchServer(); // Destructor, which closes every connection and waits for their games to end
+
+    // Listens for clients on a TCP port (on every address), or on a Unix domain socket at the given path (any file
+    // already there is removed). Returns false, after printing why, if the socket couldn't be set up
+    bool listenTcp(int port);
+    bool listenUnix(string path);
+
+    // Serves clients until stop is called (from another thread, or a signal handler)
+    void run();
+    void stop();
+
+    // Number of games being played, and finished, so far
+    int getActiveGames();
+    long getFinishedGames();
+
+private:
+    // A connected client, and the game it's playing (if any)
+    struct Connection {
+        int socket;
+
+        // Bytes read that don't make up a whole message yet
+        uint8_t partial[sizeof(MatchMessage)];
+        int partialSize;
+
+        // Messages that haven't been written yet, and whether that's because the socket was full
+        mutex outMutex;
+        string outBuffer;
+        bool waitingForRoom;
+
+        // Only one of these is set while a game is on
+        mutex gameMutex;
+        unique_ptr<Game<NetworkPlayer, RandomComputerPlayer>> randomGame;
+        unique_ptr<Game<NetworkPlayer, IntelligentComputer>> intelligentGame;
+        int queuedStart; // The opponent for a game asked for before the last one finished, or -1
+        bool closed;
+    };
+
+    Scheduler _scheduler;
+
+    int _epoll;
+    int _listener;
+    string _unixPath;
+
+    atomic<bool> _stopping;
+    atomic<int> _activeGames;
+    atomic<long> _finishedGames;
+
+    // Connections by socket. Only the event loop's thread touches the map; games hold on to their connection with
+    // their own shared_ptr, so it lives until the game has finished
+    map<int, shared_ptr<Connection>> _connections;
+
+    // Helper functions for the event loop
+    bool _listen(int listener);
+    void _accept();
+    void _read(const shared_ptr<Connection> &connection);
+    void _handle(const shared_ptr<Connection> &connection, const MatchMessage &message);
+    // Takes its own reference, since erasing the connection may drop the last one
+    void _close(shared_ptr<Connection> connection);
+
+    // Creates a game against the given opponent, and spawns it on the pool. Called with the game mutex held
+    void _startGame(const shared_ptr<Connection> &connection, int opponent);
+
+    // Queues the message for the client, and writes the queue if the client has to answer. Safe to call from any thread
+    void _send(Connection *connection, const MatchMessage &message);
+    void _flush(Connection *connection);
+
+    // Coroutine that plays a game to the end, then lets the connection start another
+    Task<void> _play(shared_ptr<Connection> connection);
+};
+
+#endif //SFML_TEMPLATE_MATCHSERVER_H
@@ -0,0 +1,55 @@
+/* NetworkPlayer.cpp
+ *
+ * Author: Colin Siles
+ *
+ * The NetworkPlayer class is a RemotePlayer playing through a MatchServer connection. Everything the client needs to
+ * know (its turn, the outcomes of the shots, the end of the game) is passed to the message callback as a MatchMessage,
+ * which the server writes to the client's socket
+*/
+
+#include "NetworkPlayer.h"
+
+NetworkPlayer::NetworkPlayer(string name, vector<int> shipLengths) : RemotePlayer(name, shipLengths) {
+}
+
+// Move requests go out as messages too
+void NetworkPlayer::setMessageCallback(function<void(const MatchMessage &message)> callback) {
+    _sendMessage = callback;
+
+    setMoveRequestCallback([this](RemotePlayer &) {
+        _sendMessage({MATCH_MOVE_REQUEST, {0, 0, 0}});
+    });
+}
+
+ShotOutcome NetworkPlayer::fireShotAt(int xPos, int yPos) {
+    ShotOutcome outcome = RemotePlayer::fireShotAt(xPos, yPos);
+
+    if(_sendMessage) {
+        _sendMessage({MATCH_INCOMING, {(uint8_t) xPos, (uint8_t) yPos, encodeOutcome(outcome)}});
+    }
+
+    return outcome;
+}
+
+void NetworkPlayer::fireShotsAt(const vector<pair<int, int>> &shots, vector<ShotOutcome> &outcomes) {
+    RemotePlayer::fireShotsAt(shots, outcomes);
+
+    for(int i = 0; i < shots.size() && _sendMessage; i++) {
+        _sendMessage({MATCH_INCOMING, {(uint8_t) shots.at(i).first, (uint8_t) shots.at(i).second,
+                                       encodeOutcome(outcomes.at(i))}});
+    }
+}
+
+void NetworkPlayer::markShot(int xPos, int yPos, ShotOutcome outcome) {
+    RemotePlayer::markShot(xPos, yPos, outcome);
+
+    if(_sendMessage) {
+        _sendMessage({MATCH_OUTCOME, {(uint8_t) xPos, (uint8_t) yPos, encodeOutcome(outcome)}});
+    }
+}
+
+void NetworkPlayer::reportGameover(bool winner) {
+    if(_sendMessage) {
+        _sendMessage({MATCH_GAME_OVER, {(uint8_t) winner, 0, 0}});
+    }
+}
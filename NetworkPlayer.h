@@ -0,0 +1,34 @@
+/* NetworkPlayer.h
+ *
+ * Author: Colin Siles
+ *
+ * The NetworkPlayer class is a RemotePlayer playing through a MatchServer connection. Everything the client needs to
+ * know (its turn, the outcomes of the shots, the end of the game) is passed to the message callback as a MatchMessage,
+ * which the server writes to the client's socket
+*/
+
+#ifndef SFML_TEMPLATE_NETWORKPLAYER_H
+#define SFML_TEMPLATE_NETWORKPLAYER_H
+
+#include <functional>
+
+#include "MatchProtocol.h"
+#include "RemotePlayer.h"
+
+class NetworkPlayer : public RemotePlayer {
+public:
+    NetworkPlayer(string name, vector<int> shipLengths);
+
+    // Called (on whichever thread the game is running on) with each message for the client
+    void setMessageCallback(function<void(const MatchMessage &message)> callback);
+
+    ShotOutcome fireShotAt(int xPos, int yPos) override;
+    void fireShotsAt(const vector<pair<int, int>> &shots, vector<ShotOutcome> &outcomes) override;
+    void markShot(int xPos, int yPos, ShotOutcome outcome) override;
+    void reportGameover(bool winner) override;
+
+private:
+    function<void(const MatchMessage &message)> _sendMessage;
+};
+
+#endif //SFML_TEMPLATE_NETWORKPLAYER_H
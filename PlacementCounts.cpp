@@ -0,0 +1,180 @@
+/* PlacementCounts.cpp
+ *
+ * Author: Colin Siles
+ *
+ * The PlacementCounts class keeps track of how many ways each of the opponent's ships could still be placed over
+ * every cell of the tracking board. Rather than recounting every placement before each move, the counts are updated
+ * incrementally as shots are marked: a miss only touches the placements covering that cell, and so does a hit
+*/
+
+#include "PlacementCounts.h"
+
+// Start with an empty board, where every placement is possible (and equally likely)
+PlacementCounts::PlacementCounts(vector<int> shipLengths) {
+    _lengths = shipLengths;
+    _prior = nullptr;
+
+    _reset();
+}
+
+void PlacementCounts::setPrior(const PlacementPrior *prior) {
+    _prior = prior;
+
+    _reset();
+}
+
+void PlacementCounts::_reset() {
+    _sunk.assign(_lengths.size(), false);
+    _hits.reset();
+
+    _valid.clear();
+    _unhit.clear();
+    _totals.assign(_lengths.size(), 0);
+    _numValid.assign(_lengths.size(), 0);
+    _counts.assign(_lengths.size() * NUM_CELLS, 0);
+    _sinkCounts.assign(_lengths.size() * NUM_CELLS, 0);
+
+    for(int i = 0; i < _lengths.size(); i++) {
+        const vector<Placement> &placements = PlacementTable::forLength(_lengths.at(i)).placements();
+
+        _valid.push_back(vector<bool>(placements.size(), true));
+        _unhit.push_back(vector<int>(placements.size(), _lengths.at(i)));
+        _numValid.at(i) = placements.size();
+
+        for(int j = 0; j < placements.size(); j++) {
+            _addCells(_counts, i, placements.at(j), _weight(i, j));
+            _totals.at(i) += _weight(i, j);
+
+            // A ship with only one square is sunk by the first hit on it
+            if(_lengths.at(i) == 1) {
+                _addCells(_sinkCounts, i, placements.at(j), _weight(i, j));
+            }
+        }
+    }
+}
+
+int PlacementCounts::_weight(int ship, int placement) const {
+    return _prior ? _prior->weight(_lengths.at(ship), placement) : 1;
+}
+
+void PlacementCounts::markMiss(int cell) {
+    // Every placement covering a miss is ruled out, for every ship
+    for(int i = 0; i < _lengths.size(); i++) {
+        const vector<int> &covering = PlacementTable::forLength(_lengths.at(i)).covering(cell);
+
+        for(int j = 0; j < covering.size(); j++) {
+            if(_valid.at(i).at(covering.at(j))) {
+                _invalidate(i, covering.at(j));
+            }
+        }
+    }
+}
+
+void PlacementCounts::markSunkCell(int cell) {
+    // Same as a miss: no other ship can be there
+    markMiss(cell);
+}
+
+void PlacementCounts::markHit(int cell) {
+    for(int i = 0; i < _lengths.size(); i++) {
+        const PlacementTable &table = PlacementTable::forLength(_lengths.at(i));
+        const vector<int> &covering = table.covering(cell);
+
+        for(int j = 0; j < covering.size(); j++) {
+            int index = covering.at(j);
+
+            if(!_valid.at(i).at(index)) {
+                continue;
+            }
+
+            const Placement &placement = table.placements().at(index);
+            int &unhit = _unhit.at(i).at(index);
+
+            // If this was the last square, the ship would have been sunk, so a ship that's still afloat can't be here
+            // (the ship that actually sank is marked separately)
+            if(unhit == 1) {
+                _invalidate(i, index);
+                continue;
+            }
+
+            unhit--;
+
+            // One cell left: shooting it would sink the ship
+            if(unhit == 1) {
+                _sinkCounts.at(i * NUM_CELLS + _lastUnhitCell(placement, cell)) += _weight(i, index);
+            }
+        }
+    }
+
+    // Only mark the hit now, so that placements ruled out above still know which of their cells was unhit
+    _hits.set(cell);
+}
+
+void PlacementCounts::markShipSunk(int ship) {
+    _sunk.at(ship) = true;
+}
+
+int PlacementCounts::numShips() const {
+    return _lengths.size();
+}
+
+bool PlacementCounts::isSunk(int ship) const {
+    return _sunk.at(ship);
+}
+
+// Getters for the counts
+int PlacementCounts::total(int ship) const {
+    return _totals.at(ship);
+}
+
+int PlacementCounts::count(int ship, int cell) const {
+    return _counts.at(ship * NUM_CELLS + cell);
+}
+
+int PlacementCounts::sinkCount(int ship, int cell) const {
+    return _sinkCounts.at(ship * NUM_CELLS + cell);
+}
+
+long PlacementCounts::fleetBound(long limit) const {
+    long product = 1;
+
+    for(int i = 0; i < _lengths.size() && product <= limit; i++) {
+        if(!_sunk.at(i)) {
+            product *= _numValid.at(i);
+        }
+    }
+
+    return product;
+}
+
+void PlacementCounts::_invalidate(int ship, int placement) {
+    const Placement &current = PlacementTable::forLength(_lengths.at(ship)).placements().at(placement);
+    int unhit = _unhit.at(ship).at(placement);
+
+    // Undo everything the placement was contributing to
+    _addCells(_counts, ship, current, -_weight(ship, placement));
+    _totals.at(ship) -= _weight(ship, placement);
+
+    if(unhit == 1) {
+        _sinkCounts.at(ship * NUM_CELLS + _lastUnhitCell(current)) -= _weight(ship, placement);
+    }
+
+    _valid.at(ship).at(placement) = false;
+    _numValid.at(ship)--;
+}
+
+void PlacementCounts::_addCells(vector<int> &counts, int ship, const Placement &placement, int amount) {
+    for(int i = 0; i < placement.cells.size(); i++) {
+        counts.at(ship * NUM_CELLS + placement.cells.at(i)) += amount;
+    }
+}
+
+int PlacementCounts::_lastUnhitCell(const Placement &placement, int ignore) {
+    for(int i = 0; i < placement.cells.size(); i++) {
+        if(!_hits.test(placement.cells.at(i)) && placement.cells.at(i) != ignore) {
+            return placement.cells.at(i);
+        }
+    }
+
+    return -1;
+}
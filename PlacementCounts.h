@@ -0,0 +1,85 @@
+/* PlacementCounts.h
+ *
+ * Author: Colin Siles
+ *
+ * The PlacementCounts class keeps track of how many ways each of the opponent's ships could still be placed over
+ * every cell of the tracking board. Rather than recounting every placement before each move, the counts are updated
+ * incrementally as shots are marked: a miss only touches the placements covering that cell, and so does a hit
+*/
+
+#ifndef SFML_TEMPLATE_PLACEMENTCOUNTS_H
+#define SFML_TEMPLATE_PLACEMENTCOUNTS_H
+
+#include <vector>
+
+#include "PlacementPrior.h"
+#include "PlacementTable.h"
+
+using namespace std;
+
+class PlacementCounts {
+public:
+    PlacementCounts(vector<int> shipLengths);
+
+    // Weights every placement by a learned prior (or uniformly, if the prior is null), and starts the counts over
+    // Only meant to be used before any shots are marked, since it forgets them
+    void setPrior(const PlacementPrior *prior);
+
+    // Updates for each kind of shot outcome. A miss, or a cell known to belong to a sunken ship, rules out every
+    // placement covering it; a hit just changes which placements would sink a ship
+    void markMiss(int cell);
+    void markHit(int cell);
+    void markSunkCell(int cell);
+    void markShipSunk(int ship);
+
+    int numShips() const;
+    bool isSunk(int ship) const;
+
+    // Number of placements of the ship that are still possible, and how many of those cover the given cell
+    // (with a prior, each placement counts as its weight instead of once)
+    int total(int ship) const;
+    int count(int ship, int cell) const;
+
+    // Number of possible placements of the ship where the given cell is the last one that hasn't been hit yet
+    // (so a shot there would sink the ship)
+    int sinkCount(int ship, int cell) const;
+
+    // Product of the number of placements still possible for each ship afloat (each counted once, whatever the prior),
+    // which is an upper bound on the number of fleets that fit. Stops counting once the product passes the limit
+    long fleetBound(long limit) const;
+
+private:
+    vector<int> _lengths;
+    const PlacementPrior *_prior;
+    vector<bool> _sunk;
+
+    // Per ship, per placement: whether it is still possible, and how many of its cells haven't been hit
+    vector<vector<bool>> _valid;
+    vector<vector<int>> _unhit;
+
+    // Per ship counts, with NUM_CELLS entries for each ship
+    vector<int> _counts;
+    vector<int> _sinkCounts;
+
+    vector<int> _totals;
+    vector<int> _numValid; // Per ship, unweighted
+
+    // Clears all the counts, and adds every placement back in
+    void _reset();
+
+    // The amount a placement adds to the counts
+    int _weight(int ship, int placement) const;
+
+    // Rules out a placement, removing it from all the counts it contributed to
+    void _invalidate(int ship, int placement);
+
+    // Adds (or removes) a placement's cells to one of the count arrays
+    void _addCells(vector<int> &counts, int ship, const Placement &placement, int amount);
+
+    // Finds the one cell of a placement that hasn't been hit yet (other than the ignored cell, which was just hit)
+    int _lastUnhitCell(const Placement &placement, int ignore = -1);
+
+    CellMask _hits;
+};
+
+#endif //SFML_TEMPLATE_PLACEMENTCOUNTS_H
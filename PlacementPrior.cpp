@@ -0,0 +1,196 @@
+/* PlacementPrior.cpp
+ *
+ * Author: Colin Siles
+ *
+ * The PlacementPrior class learns where a particular opponent likes to put their ships. It counts how often each
+ * square held a ship, and how often ships were placed along the edge of the board, over every game where the
+ * opponent's whole fleet was found. From those counts it weights every placement, so the IntelligentComputer's
+ * density engines favor the squares that opponent actually uses, rather than assuming ships are placed at random
+ *
+ * The counts are stored in a small binary file, which is memory mapped so that loading it costs next to nothing,
+ * and so that each finished game only has to update a few integers in place. The file is locked while it's updated
+ * or read, so games in several threads or programs can learn about the same opponent at once
+*/
+
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+
+#include "PlacementPrior.h"
+
+// How many games' worth of "random placement" the learned counts are blended with, so that a couple of games can't
+// swing the weights too far
+static const double PSEUDO_GAMES = 5.0;
+
+// Returns true if the square is along the edge of the board
+static bool onEdge(int cell) {
+    pair<int, int> coords = cellCoords(cell);
+
+    return coords.first == 0 || coords.second == 0 || coords.first == Board::GRID_SIZE - 1 ||
+           coords.second == Board::GRID_SIZE - 1;
+}
+
+PlacementPrior::PlacementPrior() {
+    _data = nullptr;
+}
+
+bool PlacementPrior::open(string filename) {
+    close();
+
+    bool created;
+    if(!_file.open(filename, sizeof(PlacementPriorData), created)) {
+        return false;
+    }
+
+    _data = (PlacementPriorData *) _file.data();
+
+    // Start over if the file is new, or isn't a model this version understands
+    _file.lock(true);
+    if(created || memcmp(_data->magic, "BSPP", 4) != 0 || _data->version != VERSION) {
+        _initialize();
+    }
+    _file.unlock();
+
+    return true;
+}
+
+void PlacementPrior::close() {
+    _file.close();
+    _data = nullptr;
+}
+
+bool PlacementPrior::isOpen() const {
+    return _data != nullptr;
+}
+
+void PlacementPrior::recordFleet(const CellMask &shipCells) {
+    if(!_data) {
+        return;
+    }
+
+    // Other games (in this program or another) may be recording against the same opponent
+    _file.lock(true);
+
+    for(int i = 0; i < NUM_CELLS; i++) {
+        if(shipCells.test(i)) {
+            _data->cellCounts[i]++;
+            _data->shipCells++;
+
+            if(onEdge(i)) {
+                _data->edgeCells++;
+            }
+        }
+    }
+
+    _data->games++;
+    _file.unlock();
+
+    // Make sure the update reaches the disk even if the program doesn't exit cleanly
+    _file.sync();
+}
+
+int PlacementPrior::numGames() const {
+    return _data ? _data->games : 0;
+}
+
+void PlacementPrior::computeWeights(const vector<int> &shipLengths) {
+    _weights.assign(Board::GRID_SIZE + 1, vector<int>());
+
+    // Expected number of ship squares on each square per game if ships were placed at random, from the placement tables
+    vector<double> expected(NUM_CELLS, 0.0);
+    double fleetCells = 0;
+
+    for(int i = 0; i < shipLengths.size(); i++) {
+        const PlacementTable &table = PlacementTable::forLength(shipLengths.at(i));
+
+        for(int cell = 0; cell < NUM_CELLS; cell++) {
+            expected.at(cell) += (double) table.covering(cell).size() / table.placements().size();
+        }
+
+        fleetCells += shipLengths.at(i);
+    }
+
+    double expectedEdge = 0;
+    for(int cell = 0; cell < NUM_CELLS; cell++) {
+        if(onEdge(cell)) {
+            expectedEdge += expected.at(cell) / fleetCells;
+        }
+    }
+
+    // Copied while locked, so a game being recorded at the same time isn't seen half way through
+    PlacementPriorData counts = {};
+    if(_data) {
+        _file.lock(false);
+        counts = *_data;
+        _file.unlock();
+    }
+
+    double games = counts.games;
+    double shipCells = counts.shipCells;
+    double edgeCells = counts.edgeCells;
+
+    // How much more (or less) often the opponent uses the edge than random placement would, blended with the
+    // random placement so that it starts out at one
+    double pseudoCells = PSEUDO_GAMES * fleetCells;
+    double edgeRatio = (edgeCells + pseudoCells * expectedEdge) / ((shipCells + pseudoCells) * expectedEdge);
+    double innerRatio = (shipCells - edgeCells + pseudoCells * (1 - expectedEdge)) /
+                        ((shipCells + pseudoCells) * (1 - expectedEdge));
+
+    // The same for each square individually, kept as a log so placements can average over their squares. A square's
+    // own count already shows the edge preference, so rather than multiplying the two, each square is blended with
+    // what the edge preference alone predicts for it: with few games the pooled edge counts decide, and with many the
+    // square's own count does
+    vector<double> logFactor(NUM_CELLS, 0.0);
+
+    for(int cell = 0; cell < NUM_CELLS; cell++) {
+        if(expected.at(cell) <= 0) {
+            continue;
+        }
+
+        double count = counts.cellCounts[cell];
+        double predicted = expected.at(cell) * (onEdge(cell) ? edgeRatio : innerRatio);
+
+        logFactor.at(cell) = log((count + PSEUDO_GAMES * predicted) / ((games + PSEUDO_GAMES) * expected.at(cell)));
+    }
+
+    // A placement's weight is the geometric mean of the factors of its squares
+    for(int i = 0; i < shipLengths.size(); i++) {
+        int length = shipLengths.at(i);
+
+        if(!_weights.at(length).empty()) {
+            continue;
+        }
+
+        const vector<Placement> &placements = PlacementTable::forLength(length).placements();
+
+        for(int j = 0; j < placements.size(); j++) {
+            double total = 0;
+
+            for(int k = 0; k < placements.at(j).cells.size(); k++) {
+                total += logFactor.at(placements.at(j).cells.at(k));
+            }
+
+            int scaled = round(WEIGHT_SCALE * exp(total / length));
+            _weights.at(length).push_back(max(1, min(scaled, 64 * WEIGHT_SCALE)));
+        }
+    }
+}
+
+int PlacementPrior::weight(int length, int placement) const {
+    // Lengths that weights weren't computed for are treated as random placement
+    if(length >= _weights.size() || _weights.at(length).empty()) {
+        return WEIGHT_SCALE;
+    }
+
+    return _weights.at(length).at(placement);
+}
+
+string PlacementPrior::filenameFor(string opponentName) {
+    return MappedFile::filenameFor("prior", opponentName);
+}
+
+void PlacementPrior::_initialize() {
+    memset(_data, 0, sizeof(PlacementPriorData));
+    memcpy(_data->magic, "BSPP", 4);
+    _data->version = VERSION;
+}
@@ -0,0 +1,76 @@
+/* PlacementPrior.h
+ *
+ * Author: Colin Siles
+ *
+ * The PlacementPrior class learns where a particular opponent likes to put their ships. It counts how often each
+ * square held a ship, and how often ships were placed along the edge of the board, over every game where the
+ * opponent's whole fleet was found. From those counts it weights every placement, so the IntelligentComputer's
+ * density engines favor the squares that opponent actually uses, rather than assuming ships are placed at random
+ *
+ * The counts are stored in a small binary file, which is memory mapped so that loading it costs next to nothing,
+ * and so that each finished game only has to update a few integers in place. The file is locked while it's updated
+ * or read, so games in several threads or programs can learn about the same opponent at once
+*/
+
+#ifndef SFML_TEMPLATE_PLACEMENTPRIOR_H
+#define SFML_TEMPLATE_PLACEMENTPRIOR_H
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#include "MappedFile.h"
+#include "PlacementTable.h"
+
+using namespace std;
+
+// Layout of the model file. All fields are stored in the machine's native byte order
+struct PlacementPriorData {
+    char magic[4];                  // "BSPP"
+    uint32_t version;               // PlacementPrior::VERSION
+    uint32_t games;                 // Number of fleets recorded
+    uint32_t shipCells;             // Total number of ship squares recorded
+    uint32_t edgeCells;             // How many of those were along the edge of the board
+    uint32_t cellCounts[NUM_CELLS]; // How many times each square held a ship
+};
+
+class PlacementPrior {
+public:
+    PlacementPrior();
+
+    // Maps the model file, creating an empty model if the file doesn't exist yet. Returns false if that fails
+    bool open(string filename);
+    void close();
+    bool isOpen() const;
+
+    // Adds a fleet where every ship square is known (e.g. a game where all the opponent's ships were sunk)
+    void recordFleet(const CellMask &shipCells);
+
+    int numGames() const;
+
+    // Works out the weight of every placement for a fleet with the given ship lengths
+    // Has to be called again after recording a fleet for the new fleet to affect the weights
+    void computeWeights(const vector<int> &shipLengths);
+
+    // Weight of a placement from the PlacementTable for the given length. WEIGHT_SCALE is a weight of one (the weight
+    // every placement has with no data), weights are kept as integers so placement counts stay integers
+    int weight(int length, int placement) const;
+
+    static const int WEIGHT_SCALE = 256;
+    static const uint32_t VERSION = 1;
+
+    // Returns the model file to use for the opponent with the given name
+    static string filenameFor(string opponentName);
+
+private:
+    MappedFile _file;
+    PlacementPriorData *_data;
+
+    // Weights per ship length, then per placement
+    vector<vector<int>> _weights;
+
+    // Creates (or clears) the model stored at _data
+    void _initialize();
+};
+
+#endif //SFML_TEMPLATE_PLACEMENTPRIOR_H
@@ -0,0 +1,199 @@
+/* PlacementSearch.cpp
+ *
+ * Author: Colin Siles
+ *
+ * The PlacementSearch class looks for a fleet placement that survives as long as possible against the
+ * IntelligentComputer's hunting. It draws a set of random candidate fleets, and plays simulated hunts against each of
+ * them on every core, using successive halving: after each round the worse half of the candidates is dropped, and the
+ * survivors get twice as many hunts in the next round. Every candidate faces the same hunter seeds in the same order,
+ * so differences between them come from the placements and not from luck
+*/
+
+#include <algorithm>
+#include <cmath>
+#include <random>
+#include <thread>
+
+#include "IntelligentComputer.h"
+#include "PlacementSearch.h"
+#include "RandomComputerPlayer.h"
+#include "Simulation.h"
+
+// Hunts each candidate gets in the first round
+static const int FIRST_ROUND_HUNTS = 8;
+
+// Share of the time budget kept back to measure the chosen fleet against hunters it wasn't picked with. The averages
+// from the rounds favor whichever candidate happened to get lucky, so they overestimate how well it does
+static const double VALIDATION_SHARE = 0.2;
+
+PlacementSearch::PlacementSearch(vector<int> shipLengths) {
+    _shipLengths = shipLengths;
+    _candidates = 64;
+    _threads = max(1, (int) thread::hardware_concurrency());
+    _hunterEndgameThreshold = 32;
+}
+
+void PlacementSearch::setCandidates(int candidates) {
+    _candidates = max(1, candidates);
+}
+
+void PlacementSearch::setThreads(int threads) {
+    _threads = max(1, threads);
+}
+
+void PlacementSearch::setHunterEndgameThreshold(int maxConfigurations) {
+    _hunterEndgameThreshold = maxConfigurations;
+}
+
+PlacementSearchResult PlacementSearch::search(double milliseconds, unsigned seed) {
+    chrono::steady_clock::time_point start = chrono::steady_clock::now();
+    chrono::steady_clock::time_point deadline = start + chrono::microseconds((long) (milliseconds * 1000));
+    chrono::steady_clock::time_point roundsDeadline =
+            start + chrono::microseconds((long) (milliseconds * (1 - VALIDATION_SHARE) * 1000));
+
+    mt19937 random(seed);
+
+    vector<vector<int>> fleets;
+    for(int i = 0; i < _candidates; i++) {
+        fleets.push_back(randomFleet(_shipLengths, random));
+    }
+
+    // The shots each hunt took, per candidate, in the order of the hunter seeds
+    vector<vector<int>> shots(_candidates);
+    vector<unsigned> hunterSeeds;
+
+    vector<int> alive;
+    for(int i = 0; i < _candidates; i++) {
+        alive.push_back(i);
+    }
+
+    PlacementSearchResult result = {vector<int>(), 0.0, 0.0, 0, 0};
+
+    // Successive halving, until one candidate is left or the time runs out
+    for(int huntsPerCandidate = FIRST_ROUND_HUNTS; alive.size() > 1; huntsPerCandidate *= 2) {
+        while(hunterSeeds.size() < huntsPerCandidate) {
+            hunterSeeds.push_back(random());
+        }
+
+        // Top up each surviving candidate to the round's number of hunts. The hunts go seed by seed across all the
+        // candidates, so if the time runs out partway through, they've all had about the same number
+        vector<pair<int, unsigned>> hunts;
+        for(int j = 0; j < huntsPerCandidate; j++) {
+            for(int i = 0; i < alive.size(); i++) {
+                if(j >= shots.at(alive.at(i)).size()) {
+                    hunts.push_back(make_pair(alive.at(i), hunterSeeds.at(j)));
+                }
+            }
+        }
+
+        vector<int> results(hunts.size(), 0);
+        _runHunts(fleets, hunts, results, roundsDeadline);
+
+        // Only keep a candidate's hunts up to the first one that didn't finish, so they still line up with the seeds
+        vector<bool> complete(_candidates, true);
+        for(int i = 0; i < hunts.size(); i++) {
+            int candidate = hunts.at(i).first;
+
+            if(results.at(i) == 0) {
+                complete.at(candidate) = false;
+            } else if(complete.at(candidate)) {
+                shots.at(candidate).push_back(results.at(i));
+            }
+
+            result.totalHunts += results.at(i) > 0;
+        }
+
+        // Rank the candidates by their average over the hunts they all have in common
+        int commonHunts = huntsPerCandidate;
+        for(int i = 0; i < alive.size(); i++) {
+            commonHunts = min(commonHunts, (int) shots.at(alive.at(i)).size());
+        }
+
+        // If the time ran out before every candidate got a single hunt, there's nothing fair to rank them on
+        if(commonHunts == 0) {
+            break;
+        }
+
+        vector<pair<double, int>> ranked;
+        for(int i = 0; i < alive.size(); i++) {
+            const vector<int> &candidateShots = shots.at(alive.at(i));
+            double total = 0;
+
+            for(int j = 0; j < commonHunts; j++) {
+                total += candidateShots.at(j);
+            }
+
+            ranked.push_back(make_pair(total / commonHunts, alive.at(i)));
+        }
+
+        sort(ranked.rbegin(), ranked.rend());
+
+        // Keep the better half, or just the best if this round was cut short
+        int keep = chrono::steady_clock::now() < roundsDeadline ? max(1, (int) (ranked.size() + 1) / 2) : 1;
+
+        alive.clear();
+        for(int i = 0; i < keep; i++) {
+            alive.push_back(ranked.at(i).second);
+        }
+    }
+
+    result.placements = fleets.at(alive.front());
+
+    // Measure the winner against fresh hunters with whatever time is left
+    vector<pair<int, unsigned>> validation;
+    for(int i = 0; i < 1024; i++) {
+        validation.push_back(make_pair(alive.front(), random()));
+    }
+
+    vector<int> validationShots(validation.size(), 0);
+    _runHunts(fleets, validation, validationShots, deadline);
+
+    vector<int> measured;
+    for(int i = 0; i < validationShots.size(); i++) {
+        if(validationShots.at(i) > 0) {
+            measured.push_back(validationShots.at(i));
+        }
+    }
+
+    // Fall back on the winner's hunts from the rounds if there was no time left at all
+    if(measured.empty()) {
+        measured = shots.at(alive.front());
+    }
+
+    result.totalHunts += measured.size();
+    result.hunts = measured.size();
+
+    if(!measured.empty()) {
+        double total = 0;
+        double totalSquares = 0;
+
+        for(int i = 0; i < measured.size(); i++) {
+            total += measured.at(i);
+            totalSquares += (double) measured.at(i) * measured.at(i);
+        }
+
+        result.expectedShots = total / measured.size();
+
+        if(measured.size() > 1) {
+            double variance = (totalSquares - total * result.expectedShots) / (measured.size() - 1);
+            result.standardError = sqrt(max(0.0, variance) / measured.size());
+        }
+    }
+
+    return result;
+}
+
+void PlacementSearch::_runHunts(const vector<vector<int>> &fleets, const vector<pair<int, unsigned>> &hunts,
+                                vector<int> &results, chrono::steady_clock::time_point deadline) {
+    runJobs(hunts.size(), _threads, [&](int hunt) {
+        RandomComputerPlayer target("Target", _shipLengths);
+        target.placeShipsAt(fleets.at(hunts.at(hunt).first));
+
+        IntelligentComputer hunter("Hunter", _shipLengths);
+        hunter.setSeed(hunts.at(hunt).second);
+        hunter.setEndgameThreshold(_hunterEndgameThreshold);
+
+        HuntStats stats = {0, 0.0};
+        results.at(hunt) = huntToSink(hunter, target, stats);
+    }, deadline);
+}
@@ -0,0 +1,58 @@
+/* PlacementSearch.h
+ *
+ * Author: Colin Siles
+ *
+ * The PlacementSearch class looks for a fleet placement that survives as long as possible against the
+ * IntelligentComputer's hunting. It draws a set of random candidate fleets, and plays simulated hunts against each of
+ * them on every core, using successive halving: after each round the worse half of the candidates is dropped, and the
+ * survivors get twice as many hunts in the next round. Every candidate faces the same hunter seeds in the same order,
+ * so differences between them come from the placements and not from luck
+*/
+
+#ifndef SFML_TEMPLATE_PLACEMENTSEARCH_H
+#define SFML_TEMPLATE_PLACEMENTSEARCH_H
+
+#include <chrono>
+#include <vector>
+
+using namespace std;
+
+// The placement the search settled on, and how well it's expected to do
+struct PlacementSearchResult {
+    vector<int> placements; // Index into the PlacementTable for each ship's length (see Player::placeShipsAt)
+    double expectedShots;   // Average number of shots the hunter needed to sink the fleet
+    double standardError;   // Standard error of that average
+    int hunts;              // Number of hunts the average is over
+    int totalHunts;         // Number of hunts simulated by the whole search
+};
+
+class PlacementSearch {
+public:
+    PlacementSearch(vector<int> shipLengths);
+
+    // Number of random fleets to start from (64 by default)
+    void setCandidates(int candidates);
+
+    // Number of threads to simulate on (every core by default)
+    void setThreads(int threads);
+
+    // The hunter's endgame threshold (see IntelligentComputer::setEndgameThreshold). Lower is faster, but strays
+    // further from how the real hunter plays
+    void setHunterEndgameThreshold(int maxConfigurations);
+
+    // Runs the search for the given number of milliseconds. The seed picks the candidates and the hunters' seeds
+    PlacementSearchResult search(double milliseconds, unsigned seed);
+
+private:
+    vector<int> _shipLengths;
+    int _candidates;
+    int _threads;
+    int _hunterEndgameThreshold;
+
+    // Simulates the given hunts across all threads until they're done or the deadline passes. Each hunt is a pair of
+    // a fleet and a hunter seed, and its number of shots is stored in the results (left at 0 if it didn't finish)
+    void _runHunts(const vector<vector<int>> &fleets, const vector<pair<int, unsigned>> &hunts, vector<int> &results,
+                   chrono::steady_clock::time_point deadline);
+};
+
+#endif //SFML_TEMPLATE_PLACEMENTSEARCH_H
@@ -0,0 +1,83 @@
+/* PlacementTable.cpp
+ *
+ * Author: Colin Siles
+ *
+ * The PlacementTable class precomputes every position a ship of a given length could occupy on an empty board.
+ * Each placement is stored as a bitmask of the cells it covers, so that the solvers in the IntelligentComputer can
+ * test for overlaps with a couple of bitwise operations instead of building Ship objects over and over again
+*/
+
+#include "PlacementTable.h"
+
+// Builds the table by sliding the ship over every position, in both orientations
+PlacementTable::PlacementTable(int length) : _covering(NUM_CELLS) {
+    _length = length;
+
+    // A ship without any squares can't be placed anywhere
+    if(length < 1) {
+        return;
+    }
+
+    for(int i = 0; i < Board::GRID_SIZE; i++) {
+        for(int j = 0; j < Board::GRID_SIZE; j++) {
+            for(int orientation = HORIZONTAL; orientation <= VERTICAL; orientation++) {
+                // Same stepping as Ship::setGridPos
+                int xStep = orientation == HORIZONTAL;
+                int yStep = orientation == VERTICAL;
+
+                // Skip positions where the ship would hang off the edge of the board
+                if(i + xStep * (length - 1) >= Board::GRID_SIZE || j + yStep * (length - 1) >= Board::GRID_SIZE) {
+                    continue;
+                }
+
+                // A ship of length one would otherwise be counted twice
+                if(length == 1 && orientation == VERTICAL) {
+                    continue;
+                }
+
+                Placement placement;
+                placement.xPos = i;
+                placement.yPos = j;
+                placement.orientation = (Orientation) orientation;
+
+                for(int k = 0; k < length; k++) {
+                    int cell = cellIndex(i + xStep * k, j + yStep * k);
+
+                    placement.mask.set(cell);
+                    placement.cells.push_back(cell);
+                    _covering.at(cell).push_back(_placements.size());
+                }
+
+                _placements.push_back(placement);
+            }
+        }
+    }
+}
+
+// Every length that can fit on the board gets a table, built once the first time any table is requested
+const PlacementTable &PlacementTable::forLength(int length) {
+    static const vector<PlacementTable> tables = [] {
+        vector<PlacementTable> output;
+
+        for(int i = 0; i <= Board::GRID_SIZE; i++) {
+            output.push_back(PlacementTable(i));
+        }
+
+        return output;
+    }();
+
+    return tables.at(length);
+}
+
+// Simple getters for the table
+const vector<Placement> &PlacementTable::placements() const {
+    return _placements;
+}
+
+const vector<int> &PlacementTable::covering(int cell) const {
+    return _covering.at(cell);
+}
+
+int PlacementTable::getLength() const {
+    return _length;
+}
@@ -0,0 +1,65 @@
+/* PlacementTable.h
+ *
+ * Author: Colin Siles
+ *
+ * The PlacementTable class precomputes every position a ship of a given length could occupy on an empty board.
+ * Each placement is stored as a bitmask of the cells it covers, so that the solvers in the IntelligentComputer can
+ * test for overlaps with a couple of bitwise operations instead of building Ship objects over and over again
+*/
+
+#ifndef SFML_TEMPLATE_PLACEMENTTABLE_H
+#define SFML_TEMPLATE_PLACEMENTTABLE_H
+
+#include <bitset>
+#include <vector>
+
+#include "Board.h"
+#include "Ship.h"
+
+using namespace std;
+
+// Number of cells on the board, and the bitmask type used to represent a set of cells
+// A cell at (xPos, yPos) is stored at index xPos * Board::GRID_SIZE + yPos, matching the layout of Board's _grid
+const int NUM_CELLS = Board::GRID_SIZE * Board::GRID_SIZE;
+typedef bitset<NUM_CELLS> CellMask;
+
+// Converts between a coordinate and its index in a CellMask
+inline int cellIndex(int xPos, int yPos) {
+    return xPos * Board::GRID_SIZE + yPos;
+}
+
+inline pair<int, int> cellCoords(int index) {
+    return make_pair(index / Board::GRID_SIZE, index % Board::GRID_SIZE);
+}
+
+// A single position that a ship could be placed in
+struct Placement {
+    int xPos;                // The coordinates of the upper left most square (same as Ship's _boardX and _boardY)
+    int yPos;
+    Orientation orientation;
+    CellMask mask;           // The cells covered by the placement
+    vector<int> cells;       // The same cells, as a list of indices
+};
+
+class PlacementTable {
+public:
+    // Returns the (shared) table for ships of the given length. Tables are built the first time they are requested
+    static const PlacementTable &forLength(int length);
+
+    // Returns all of the placements for this length
+    const vector<Placement> &placements() const;
+
+    // Returns the indices of the placements which cover the given cell
+    const vector<int> &covering(int cell) const;
+
+    int getLength() const;
+
+private:
+    PlacementTable(int length);
+
+    int _length;
+    vector<Placement> _placements;
+    vector<vector<int>> _covering; // One list of placement indices per cell
+};
+
+#endif //SFML_TEMPLATE_PLACEMENTTABLE_H
@@ -14,6 +14,60 @@
 Player::Player(string name, vector<int> shipLengths) : _primaryFleet(shipLengths), _trackingFleet(shipLengths),
         _primaryBoard(_primaryFleet), _trackingBoard(_trackingFleet) {
     _name = name;
+
+    // Seeded from rand(), so that srand still controls the whole game
+    _random.seed(rand());
+}
+
+void Player::setSeed(unsigned seed) {
+    _random.seed(seed);
+}
+
+vector<int> Player::getShipPlacements() {
+    vector<int> placements;
+
+    for(int i = 0; i < _primaryFleet.size(); i++) {
+        Ship &ship = _primaryFleet.ship(i);
+
+        CellMask cells;
+        map<pair<int, int>, bool> squares = ship.getSquares();
+        for(auto &square : squares) {
+            cells.set(cellIndex(square.first.first, square.first.second));
+        }
+
+        // Look for the placement covering the same squares
+        int index = -1;
+        const vector<Placement> &tablePlacements = PlacementTable::forLength(ship.getLength()).placements();
+
+        for(int j = 0; ship.isPlaced() && index < 0 && j < tablePlacements.size(); j++) {
+            if(tablePlacements.at(j).mask == cells) {
+                index = j;
+            }
+        }
+
+        placements.push_back(index);
+    }
+
+    return placements;
+}
+
+// The generator is stored as its seed, then the number of draws from it (low word first)
+void Player::saveState(vector<uint32_t> &state) {
+    state.push_back(_random.getSeed());
+    state.push_back((uint32_t) _random.getDraws());
+    state.push_back((uint32_t) (_random.getDraws() >> 32));
+}
+
+bool Player::restoreState(const vector<uint32_t> &state, size_t &position) {
+    if(position > state.size() || state.size() - position < 3) {
+        return false;
+    }
+
+    uint64_t draws = state.at(position + 1) | (uint64_t) state.at(position + 2) << 32;
+    _random.restore(state.at(position), draws);
+    position += 3;
+
+    return true;
 }
 
 // Function that sub classes can use to place their ships randomly on the board
@@ -23,11 +77,11 @@ void Player::placeShipsRandomly() {
         // As long as the ship hasn't been placed succesfully
         while(true) {
             // Pick a random palce for the ship
-            int randomX = rand() % 10;
-            int randomY = rand() % 10;
+            int randomX = _random() % 10;
+            int randomY = _random() % 10;
 
             // Randomly rotate it
-            if(rand() % 2) {
+            if(_random() % 2) {
                 _primaryFleet.ship(i).rotate();
             }
 
@@ -43,15 +97,106 @@ void Player::placeShipsRandomly() {
     }
 }
 
+pair<int, int> Player::getMove(const Deadline &) {
+    return getMove();
+}
+
+Task<pair<int, int>> Player::getMoveAsync(Deadline deadline) {
+    co_return getMove(deadline);
+}
+
+Task<void> Player::placeShipsAsync() {
+    placeShips();
+    co_return;
+}
+
+Task<void> Player::reportGameoverAsync(bool winner) {
+    reportGameover(winner);
+    co_return;
+}
+
+vector<pair<int, int>> Player::getMoves(int count, const Deadline &deadline) {
+    vector<pair<int, int>> moves;
+    moves.reserve(count);
+
+    for(int i = 0; i < count; i++) {
+        pair<int, int> move = getMove(deadline);
+
+        if(!_trackingBoard.validGuess(move.first, move.second)) {
+            break;
+        }
+
+        moves.push_back(move);
+        _trackingBoard.setAimed(move.first, move.second, true);
+    }
+
+    for(int i = 0; i < moves.size(); i++) {
+        _trackingBoard.setAimed(moves.at(i).first, moves.at(i).second, false);
+    }
+
+    return moves;
+}
+
+Task<vector<pair<int, int>>> Player::getMovesAsync(int count, Deadline deadline) {
+    co_return getMoves(count, deadline);
+}
+
+void Player::placeShipsAt(const vector<int> &placements) {
+    for(int i = 0; i < _primaryFleet.size(); i++) {
+        const Placement &placement =
+                PlacementTable::forLength(_primaryFleet.ship(i).getLength()).placements().at(placements.at(i));
+
+        // Ships start out horizontal, so only vertical placements need a rotation
+        _primaryFleet.ship(i).setHorizontal();
+        if(placement.orientation == VERTICAL) {
+            _primaryFleet.ship(i).rotate();
+        }
+
+        _primaryFleet.ship(i).setGridPos(placement.xPos, placement.yPos);
+        _primaryBoard.placeShip(_primaryFleet.ship(i));
+    }
+}
+
 // Wrappers for the Board and Fleet classes
 ShotOutcome Player::fireShotAt(int xPos, int yPos) {
     return _primaryBoard.fireShotAt(xPos, yPos);
 }
 
+void Player::fireShotsAt(const vector<pair<int, int>> &shots, vector<ShotOutcome> &outcomes) {
+    _primaryBoard.fireShotsAt(shots, outcomes);
+}
+
 void Player::markShot(int xPos, int yPos, ShotOutcome outcome) {
     _trackingBoard.markShot(xPos, yPos, outcome);
 }
 
+void Player::reportOpponent(string name) {
+    _opponentName = name;
+}
+
+int Player::chooseTarget(const vector<TargetInfo> &targets) {
+    int best = 0;
+
+    for(int i = 1; i < targets.size(); i++) {
+        const TargetInfo &target = targets.at(i);
+
+        if(target.openHits > targets.at(best).openHits ||
+           (target.openHits == targets.at(best).openHits && target.squaresLeft < targets.at(best).squaresLeft)) {
+            best = i;
+        }
+    }
+
+    return targets.empty() ? -1 : targets.at(best).seat;
+}
+
+void Player::resetState() {
+    _primaryFleet.reset();
+    _trackingFleet.reset();
+
+    _primaryBoard.clear();
+    _trackingBoard.clear();
+}
+
 bool Player::allShipsPlaced() {
     return _primaryFleet.allPlaced();
 }
@@ -60,7 +205,24 @@ bool Player::allShipsSunk() {
     return _primaryFleet.allSunk();
 }
 
+int Player::numShipsAfloat() {
+    return _primaryFleet.numAfloat();
+}
+
+bool Player::validGuess(int xPos, int yPos) {
+    return _trackingBoard.validGuess(xPos, yPos);
+}
+
 // Getter for the name property
 string Player::getName() {
     return _name;
+}
+
+vector<int> Player::getShipLengths() {
+    vector<int> shipLengths;
+    for(int i = 0; i < _primaryFleet.size(); i++) {
+        shipLengths.push_back(_primaryFleet.ship(i).getLength());
+    }
+
+    return shipLengths;
 }
\ No newline at end of file
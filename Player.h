@@ -10,40 +10,117 @@
 #ifndef SFML_TEMPLATE_PLAYER_H
 #define SFML_TEMPLATE_PLAYER_H
 
+#include <cstdint>
 #include <cstdlib>
+#include <random>
 #include <string>
 #include <vector>
 #include <utility>
 
 #include "Board.h"
+#include "Deadline.h"
+#include "PlacementTable.h"
+#include "SeededRandom.h"
+#include "Task.h"
 
 using namespace std;
 
+// What everyone knows of an opponent's board in a match between more than two players (see FreeForAll), which is what
+// a player chooses who to fire at from
+struct TargetInfo {
+    int seat;
+    int openHits;    // Hits on ships that haven't been sunk yet
+    int squaresLeft; // Squares of ship that haven't been hit yet
+};
+
 class Player {
 public:
     Player(string name, vector<int> shipLengths);
+    virtual ~Player() = default; // Virtual, so players created by the PlayerRegistry can be deleted as Players
 
     // Pure virtual functions that all subclasses must overrid
     virtual pair<int, int> getMove() = 0;
     virtual void placeShips() = 0;
     virtual void reportGameover(bool winner) = 0;
 
+    // Gets a move that has to be chosen before the deadline. Players that can stop thinking early (like the
+    // IntelligentComputer) override this to return the best move they have when the deadline expires; by default it
+    // just calls getMove and ignores the deadline
+    virtual pair<int, int> getMove(const Deadline &deadline);
+
+    // Coroutine versions of the three main functions, used by Game::runGameAsync. By default they just call the
+    // functions above, so every player works in either kind of game. Players that wait on something outside the
+    // program (like a RemotePlayer) override them to suspend while they wait, rather than holding up a thread
+    virtual Task<pair<int, int>> getMoveAsync(Deadline deadline);
+    virtual Task<void> placeShipsAsync();
+    virtual Task<void> reportGameoverAsync(bool winner);
+
+    // Gets a salvo of up to the given number of different moves, for the salvo variant (see Game::setSalvo). By default
+    // the moves come from getMove one at a time, each aimed on the tracking board so that players choosing by
+    // validGuess (like the random computer and the human) don't choose it twice. The salvo ends early if getMove gives
+    // an invalid or repeated move. Players that can choose moves together (like the IntelligentComputer) override it
+    virtual vector<pair<int, int>> getMoves(int count, const Deadline &deadline = Deadline());
+    virtual Task<vector<pair<int, int>>> getMovesAsync(int count, Deadline deadline);
+
     // A player can use this function to place their ships randomly
     void placeShipsRandomly();
 
-    // Wrapper for the primaryBoard's fireShotAt function
-    ShotOutcome fireShotAt(int xPos, int yPos);
+    // Or this one to place them in specific places: each ship goes in the placement with the given index in the
+    // PlacementTable for its length
+    void placeShipsAt(const vector<int> &placements);
+
+    // Reseeds the player's random number generator (used for random placement, and any random choices in getMove)
+    void setSeed(unsigned seed);
+
+    // Where each ship was placed, as the index of its placement in the PlacementTable for its length (-1 for ships
+    // that haven't been placed), as taken by placeShipsAt
+    vector<int> getShipPlacements();
+
+    // Saves and restores the parts of the player's state that replaying the game's shots doesn't bring back (see
+    // GameSnapshot). For most players that's just the random number generator (its seed, and how many numbers have been
+    // drawn from it); subclasses with more add to it
+    // restoreState reads from the given position in the state, and moves it past what it read
+    virtual void saveState(vector<uint32_t> &state);
+    virtual bool restoreState(const vector<uint32_t> &state, size_t &position);
+
+    // Wrapper for the primaryBoard's fireShotAt function. Virtual so that players can keep track of where they're shot
+    virtual ShotOutcome fireShotAt(int xPos, int yPos);
+
+    // Wrapper for the primaryBoard's fireShotsAt function, which resolves a whole salvo at once into the outcomes
+    // buffer. Virtual for the same reason as fireShotAt (players overriding one should override both)
+    virtual void fireShotsAt(const vector<pair<int, int>> &shots, vector<ShotOutcome> &outcomes);
 
     // Wrapper for board's markShot function. Virtual so that players can add functionality to track sunken ships
     virtual void markShot(int xPos, int yPos, ShotOutcome outcome);
 
+    // Called by the game before ships are placed, to let the player know who they're up against
+    // Virtual so that players can use it to look up what they've learned about that opponent
+    virtual void reportOpponent(string name);
+
+    // Chooses who to fire at in a match between more than two players, returning their seat. The targets are the
+    // players still in, starting from the one after this player. By default it goes for whoever has the most open hits
+    // (those are the easiest squares to hit), then whoever has the fewest squares of ship left, then the first of them
+    virtual int chooseTarget(const vector<TargetInfo> &targets);
+
+    // Forgets the game being played (the boards, the fleets, and anything a subclass keeps about them), so the same
+    // player can play another one. The name, the random number generator and any settings are kept. Subclasses with
+    // more to forget override it, calling this version too
+    virtual void resetState();
+
     // Wrapper for the primaryFleet's functions
     bool allShipsPlaced();
     bool allShipsSunk();
+    int numShipsAfloat();
+
+    // And for the trackingBoard's validGuess: true if the square is on the board, and hasn't been fired at yet
+    bool validGuess(int xPos, int yPos);
 
     // Getter for the name property
     string getName();
 
+    // The length of each ship in the fleet
+    vector<int> getShipLengths();
+
 protected:
     Board _primaryBoard; // The player's board where all their ships are
     Board _trackingBoard; // The tracking board, where a player marks hits and misses
@@ -53,6 +130,12 @@ protected:
 
     // Store a name for the battelog and/or printing to terminal
     string _name;
+
+    // The name of the opponent, if the game has reported it
+    string _opponentName;
+
+    // Each player has its own generator, so that games can be played on many threads at once
+    SeededRandom _random;
 };
 
 #endif //SFML_TEMPLATE_PLAYER_H
@@ -0,0 +1,117 @@
+/* PlayerRegistry.cpp
+ *
+ * Author: Colin Siles
+ *
+ * The PlayerRegistry class creates players by name, so that tools like the tournament can be told which players to
+ * use on the command line. A player is described as "type" or "type:option=value,option=value", e.g.
+ * "intelligent:endgameThreshold=0,latticePruning=0" for an IntelligentComputer with those AIParameters. The one
+ * exception is "engine:command", where everything after the colon is the command that starts an external engine
+*/
+
+#include <algorithm>
+#include <cstdlib>
+#include <iostream>
+#include <sstream>
+
+#include "ExternalEnginePlayer.h"
+#include "IntelligentComputer.h"
+#include "PlayerRegistry.h"
+#include "RandomComputerPlayer.h"
+
+void PlayerRegistry::add(string type, PlayerFactory factory) {
+    _factories()[type] = factory;
+}
+
+Player *PlayerRegistry::create(string description, string name, vector<int> shipLengths) {
+    int colon = description.find(':');
+    string type = description.substr(0, colon);
+
+    // The engine's command line isn't a list of options (and can have commas and equals signs of its own)
+    if(type == "engine") {
+        if(colon < 0) {
+            cerr << "The engine player needs a command, e.g. engine:./exampleengine" << endl;
+            return nullptr;
+        }
+
+        ExternalEnginePlayer *engine = new ExternalEnginePlayer(name, shipLengths, description.substr(colon + 1));
+
+        if(!engine->isRunning()) {
+            delete engine;
+            return nullptr;
+        }
+
+        return engine;
+    }
+
+    if(_factories().count(type) == 0) {
+        cerr << "Unknown player type " << type << endl;
+        return nullptr;
+    }
+
+    // Split the options into their names and values
+    map<string, int> options;
+
+    if(colon >= 0) {
+        stringstream optionList(description.substr(colon + 1));
+        string option;
+
+        while(getline(optionList, option, ',')) {
+            int equals = option.find('=');
+
+            if(equals < 0) {
+                cerr << "Option " << option << " for " << type << " has no value" << endl;
+                return nullptr;
+            }
+
+            options[option.substr(0, equals)] = atoi(option.substr(equals + 1).c_str());
+        }
+    }
+
+    return _factories().at(type)(name, shipLengths, options);
+}
+
+vector<string> PlayerRegistry::types() {
+    vector<string> names;
+
+    for(auto &entry : _factories()) {
+        names.push_back(entry.first);
+    }
+
+    // The engine isn't in the table, since it's created from a command rather than options
+    names.insert(lower_bound(names.begin(), names.end(), "engine"), "engine");
+
+    return names;
+}
+
+// The table is built on first use, with the built in players already in it
+map<string, PlayerFactory> &PlayerRegistry::_factories() {
+    static map<string, PlayerFactory> factories = {
+        {"random", [](string name, vector<int> shipLengths, const map<string, int> &options) -> Player * {
+            if(!options.empty()) {
+                cerr << "The random player has no options" << endl;
+                return nullptr;
+            }
+
+            return new RandomComputerPlayer(name, shipLengths);
+        }},
+
+        // Options are AIParameters, applied on top of the built in defaults
+        {"intelligent", [](string name, vector<int> shipLengths, const map<string, int> &options) -> Player * {
+            IntelligentComputer *computer = new IntelligentComputer(name, shipLengths);
+            AIParameters parameters;
+
+            for(auto &option : options) {
+                if(!parameters.set(option.first, option.second)) {
+                    cerr << "Unknown option " << option.first << " for the intelligent player" << endl;
+                    delete computer;
+                    return nullptr;
+                }
+            }
+
+            computer->setParameters(parameters);
+            return computer;
+        }},
+    };
+
+    return factories;
+}
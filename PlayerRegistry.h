@@ -0,0 +1,42 @@
+/* PlayerRegistry.h
+ *
+ * Author: Colin Siles
+ *
+ * The PlayerRegistry class creates players by name, so that tools like the tournament can be told which players to
+ * use on the command line. A player is described as "type" or "type:option=value,option=value", e.g.
+ * "intelligent:endgameThreshold=0,latticePruning=0" for an IntelligentComputer with those AIParameters. The one
+ * exception is "engine:command", where everything after the colon is the command that starts an external engine
+*/
+
+#ifndef SFML_TEMPLATE_PLAYERREGISTRY_H
+#define SFML_TEMPLATE_PLAYERREGISTRY_H
+
+#include <functional>
+#include <map>
+#include <string>
+#include <vector>
+
+#include "Player.h"
+
+using namespace std;
+
+// Creates a player of a registered type from its name, ship lengths and options. Returns nullptr if the options are bad
+typedef function<Player *(string name, vector<int> shipLengths, const map<string, int> &options)> PlayerFactory;
+
+class PlayerRegistry {
+public:
+    // Registers a type of player. The built in players ("random", "intelligent" and "engine") are always registered
+    static void add(string type, PlayerFactory factory);
+
+    // Creates a player from its description (see above). Returns nullptr, after printing why, if the type isn't
+    // registered or the options are bad. The caller owns the player
+    static Player *create(string description, string name, vector<int> shipLengths);
+
+    // The registered types, in alphabetical order
+    static vector<string> types();
+
+private:
+    static map<string, PlayerFactory> &_factories();
+};
+
+#endif //SFML_TEMPLATE_PLAYERREGISTRY_H
@@ -12,8 +12,8 @@ pair<int, int> RandomComputerPlayer::getMove() {
     // As long as a move hasn't been found
     while(true) {
         // Choose a random move
-        int randomRow = rand() % 10;
-        int randomCol = rand() % 10;
+        int randomRow = _random() % 10;
+        int randomCol = _random() % 10;
 
         // And return that move if it is valid
         if(_trackingBoard.validGuess(randomRow, randomCol)) {
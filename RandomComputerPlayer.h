@@ -15,7 +15,8 @@ class RandomComputerPlayer : public Player {
 public:
     using Player::Player; // Use the player constructor, no new fields to intialize
 
-    // Override the three necessary functions
+    // Override the three necessary functions (keeping the deadline version of getMove visible, too)
+    using Player::getMove;
     pair<int, int> getMove() override;
     void placeShips() override;
     void reportGameover(bool winner) override;
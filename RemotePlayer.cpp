@@ -0,0 +1,58 @@
+/* RemotePlayer.cpp
+ *
+ * Author: Colin Siles
+ *
+ * The RemotePlayer class is a Player subclass whose moves come from outside the game: over a network connection, or
+ * from a UI running on another thread. When the game needs a move, the player asks for one through its move request
+ * callback, and the game suspends (in runGameAsync) until the move is submitted. Its ships are placed randomly
+*/
+
+#include "RemotePlayer.h"
+
+RemotePlayer::RemotePlayer(string name, vector<int> shipLengths) : Player(name, shipLengths) {
+}
+
+void RemotePlayer::setScheduler(Scheduler *scheduler) {
+    _nextMove.setScheduler(scheduler);
+}
+
+void RemotePlayer::setMoveRequestCallback(function<void(RemotePlayer &player)> callback) {
+    _moveRequested = callback;
+}
+
+void RemotePlayer::submitMove(int xPos, int yPos) {
+    _nextMove.set(make_pair(xPos, yPos));
+}
+
+bool RemotePlayer::validMove(int xPos, int yPos) {
+    return _trackingBoard.validGuess(xPos, yPos);
+}
+
+pair<int, int> RemotePlayer::getMove() {
+    return syncWait(getMoveAsync(Deadline()));
+}
+
+// The deadline isn't watched while waiting, since nothing runs then; the game still checks the time the move took
+Task<pair<int, int>> RemotePlayer::getMoveAsync(Deadline) {
+    while(true) {
+        if(_moveRequested) {
+            _moveRequested(*this);
+        }
+
+        pair<int, int> move = co_await _nextMove;
+
+        // A move off the board is passed on, so the game treats it as a forfeit. One that was fired at before is
+        // asked for again
+        if(move.first < 0 || move.first >= Board::GRID_SIZE || move.second < 0 || move.second >= Board::GRID_SIZE ||
+           validMove(move.first, move.second)) {
+            co_return move;
+        }
+    }
+}
+
+void RemotePlayer::placeShips() {
+    placeShipsRandomly();
+}
+
+void RemotePlayer::reportGameover(bool) {
+}
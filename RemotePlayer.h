@@ -0,0 +1,48 @@
+/* RemotePlayer.h
+ *
+ * Author: Colin Siles
+ *
+ * The RemotePlayer class is a Player subclass whose moves come from outside the game: over a network connection, or
+ * from a UI running on another thread. When the game needs a move, the player asks for one through its move request
+ * callback, and the game suspends (in runGameAsync) until the move is submitted. Its ships are placed randomly
+*/
+
+#ifndef SFML_TEMPLATE_REMOTEPLAYER_H
+#define SFML_TEMPLATE_REMOTEPLAYER_H
+
+#include <functional>
+
+#include "AsyncValue.h"
+#include "Player.h"
+
+class RemotePlayer : public Player {
+public:
+    RemotePlayer(string name, vector<int> shipLengths);
+
+    // The scheduler to resume the game on when a move arrives (without one, the game resumes on the submitting thread)
+    void setScheduler(Scheduler *scheduler);
+
+    // Called whenever the game needs a move from this player, so whoever is on the other end knows to send one
+    void setMoveRequestCallback(function<void(RemotePlayer &player)> callback);
+
+    // Gives the player its next move. Safe to call from any thread. A move outside the grid forfeits the game, and a
+    // repeated one is ignored (the move is requested again)
+    void submitMove(int xPos, int yPos);
+
+    // Whether the given move would be accepted
+    bool validMove(int xPos, int yPos);
+
+    // The synchronous getMove blocks the calling thread until a move is submitted; the coroutine version suspends
+    using Player::getMove;
+    pair<int, int> getMove() override;
+    Task<pair<int, int>> getMoveAsync(Deadline deadline) override;
+
+    void placeShips() override;
+    void reportGameover(bool winner) override;
+
+private:
+    AsyncValue<pair<int, int>> _nextMove;
+    function<void(RemotePlayer &player)> _moveRequested;
+};
+
+#endif //SFML_TEMPLATE_REMOTEPLAYER_H
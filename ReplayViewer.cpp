@@ -0,0 +1,295 @@
+/* ReplayViewer.cpp
+ *
+ * Author: Colin Siles
+ *
+ * The ReplayViewer class plays back recorded games in an SFML window, using the BoardRenderer and FleetRenderer
+ * classes
+*/
+
+#include <bitset>
+#include <cstdio>
+#include <fstream>
+
+#include "BattlelogReader.h"
+#include "ReplayViewer.h"
+
+const double ReplayViewer::END_PAUSE_SECONDS = 0.5;
+
+// Where the progress bar under the boards is
+static const int BAR_X = 25;
+static const int BAR_Y = 605;
+static const int BAR_WIDTH = 1575;
+static const int BAR_HEIGHT = 12;
+
+// The fleet drawn for records that don't say what ships were played with (like text battlelogs)
+static const vector<int> DEFAULT_LENGTHS = {5, 4, 4, 3, 2};
+
+ReplayViewer::ReplayViewer() {
+    _gameIndex = 0;
+    _position = 0;
+    _movesPerSecond = 10;
+    _paused = false;
+    _autoAdvance = false;
+    _endTime = 0;
+
+    if(!_font.loadFromFile("data/arial.ttf")) {
+        cerr << "Error loading font" << endl;
+    }
+}
+
+int ReplayViewer::addFile(string filename) {
+    char magic[4] = {};
+    ifstream file(filename, ios::binary);
+    file.read(magic, 4);
+
+    // Text battlelogs hold one game each, and are only read when they're shown
+    if(!file || string(magic, 4) != "BSBL") {
+        _games.push_back({-1, {}, filename});
+        return 1;
+    }
+
+    unique_ptr<BinaryBattlelogReader> reader(new BinaryBattlelogReader());
+    if(!reader->open(filename)) {
+        return 0;
+    }
+
+    int added = 0;
+    BinaryGameView game;
+    while(reader->next(game)) {
+        _games.push_back({(int) _readers.size(), game, ""});
+        added++;
+    }
+
+    _readers.push_back(move(reader));
+    return added;
+}
+
+int ReplayViewer::getNumGames() const {
+    return _games.size();
+}
+
+void ReplayViewer::run(int firstGame, double movesPerSecond) {
+    if(_games.empty()) {
+        return;
+    }
+
+    _window.create(VideoMode(1625, 700), "Battleship Replay");
+    _window.setFramerateLimit(60);
+
+    _movesPerSecond = movesPerSecond;
+    _loadGame(firstGame);
+
+    Clock clock;
+
+    while(_window.isOpen()) {
+        double seconds = clock.restart().asSeconds();
+
+        Event event;
+        while(_window.pollEvent(event)) {
+            if(event.type == Event::Closed) {
+                _window.close();
+            } else if(event.type == Event::KeyPressed) {
+                _handleKey(event.key.code);
+            } else if(event.type == Event::MouseButtonPressed && event.mouseButton.button == Mouse::Left) {
+                _handleClick(event.mouseButton.x, event.mouseButton.y);
+            }
+        }
+
+        // However many moves have gone by since the last frame are skipped straight over
+        if(!_paused) {
+            _position = min(_position + seconds * _movesPerSecond, (double) _replay.getNumMoves());
+        }
+
+        if(_autoAdvance && !_paused && _position >= _replay.getNumMoves()) {
+            _endTime += seconds;
+
+            if(_endTime >= END_PAUSE_SECONDS && _gameIndex + 1 < _games.size()) {
+                _loadGame(_gameIndex + 1);
+            }
+        }
+
+        _replay.seek((int) _position);
+        _showFrame();
+        _draw();
+    }
+}
+
+void ReplayViewer::_loadGame(int index) {
+    _gameIndex = max(0, min(index, (int) _games.size() - 1));
+    _position = 0;
+    _endTime = 0;
+
+    const Source &source = _games.at(_gameIndex);
+    GameRecord record;
+
+    if(source.reader >= 0) {
+        source.game.toRecord(record);
+    } else if(!BattlelogReader::read(source.filename, record)) {
+        cerr << "Couldn't read " << source.filename << endl;
+        record = {{source.filename, ""}, {}, 0, {}, -1};
+    }
+
+    record.playerNames.resize(2);
+    if(record.shipLengths.empty()) {
+        record.shipLengths = DEFAULT_LENGTHS;
+    }
+
+    _replay.load(record);
+
+    // The renderers hold on to the boards and fleets, so everything is made again, in order
+    _fleetRenderers.clear();
+    _boardRenderers.clear();
+    _boards.clear();
+    _fleets.clear();
+
+    for(int i = 0; i < 2; i++) {
+        _fleets.push_back(unique_ptr<Fleet>(new Fleet(record.shipLengths)));
+        _boards.push_back(unique_ptr<Board>(new Board(*_fleets.at(i))));
+        _boardRenderers.push_back(unique_ptr<BoardRenderer>(new BoardRenderer(_window, *_boards.at(i), 25 + 800 * i,
+                                                                              25, record.playerNames.at(i) +
+                                                                                  "'s shots")));
+        _fleetRenderers.push_back(unique_ptr<FleetRenderer>(new FleetRenderer(*_fleets.at(i),
+                                                                              _boardRenderers.at(i).get(), _window)));
+    }
+}
+
+void ReplayViewer::_showFrame() {
+    const ReplayFrame &frame = _replay.getFrame();
+    const vector<int> &shipLengths = _replay.getRecord().shipLengths;
+
+    for(int player = 0; player < 2; player++) {
+        // Boards can't be cleared, so the player's board starts over from a fresh one each frame
+        *_boards.at(player) = Board(*_fleets.at(player));
+
+        for(int cell = 0; cell < NUM_CELLS; cell++) {
+            if(frame.shots[player][cell]) {
+                _boards.at(player)->markShot(cell / Board::GRID_SIZE, cell % Board::GRID_SIZE,
+                                             {frame.hits[player][cell], -1});
+            }
+        }
+
+        // Ships are replaced in place, since the fleet renderer points to them. Ships sunk without the record saying
+        // which are shown as the first ones still afloat
+        int unknownSunk = frame.numSunk[player] - bitset<32>(frame.sunkShips[player]).count();
+
+        for(int i = 0; i < shipLengths.size(); i++) {
+            Ship &ship = _fleets.at(player)->ship(i);
+            ship = Ship(shipLengths.at(i));
+
+            bool sunk = i < GameReplay::MAX_SHIPS && (frame.sunkShips[player] >> i & 1);
+            if(!sunk && unknownSunk > 0) {
+                sunk = true;
+                unknownSunk--;
+            }
+
+            if(sunk) {
+                ship.markAsSunk();
+            }
+        }
+    }
+}
+
+void ReplayViewer::_handleKey(Keyboard::Key key) {
+    int moves = _replay.getFrame().moves;
+
+    switch(key) {
+        case Keyboard::Space:
+            _paused = !_paused;
+            break;
+        case Keyboard::Right:
+            _paused = true;
+            _position = min(moves + 1, _replay.getNumMoves());
+            break;
+        case Keyboard::Left:
+            _paused = true;
+            _position = max(moves - 1, 0);
+            break;
+        case Keyboard::Up:
+            _movesPerSecond = min(_movesPerSecond * 2, 100000.0);
+            break;
+        case Keyboard::Down:
+            _movesPerSecond = max(_movesPerSecond / 2, 0.25);
+            break;
+        case Keyboard::Home:
+            _position = 0;
+            break;
+        case Keyboard::End:
+            _position = _replay.getNumMoves();
+            break;
+        case Keyboard::PageDown:
+            _loadGame(_gameIndex + 1);
+            break;
+        case Keyboard::PageUp:
+            _loadGame(_gameIndex - 1);
+            break;
+        case Keyboard::A:
+            _autoAdvance = !_autoAdvance;
+            break;
+        default:
+            break;
+    }
+}
+
+// Clicking the progress bar jumps to that point in the game
+void ReplayViewer::_handleClick(int xPos, int yPos) {
+    if(xPos >= BAR_X && xPos <= BAR_X + BAR_WIDTH && yPos >= BAR_Y - 5 && yPos <= BAR_Y + BAR_HEIGHT + 5) {
+        _position = (int) ((double) (xPos - BAR_X) / BAR_WIDTH * _replay.getNumMoves() + 0.5);
+    }
+}
+
+void ReplayViewer::_draw() {
+    _window.clear(Color::Black);
+
+    for(int i = 0; i < 2; i++) {
+        _boardRenderers.at(i)->draw();
+        _fleetRenderers.at(i)->draw(false);
+    }
+
+    // Highlights the last move made, on the board of the player that made it
+    const ReplayFrame &frame = _replay.getFrame();
+    if(frame.moves > 0) {
+        const RecordedMove &move = _replay.getMove(frame.moves);
+        BoardRenderer &renderer = *_boardRenderers.at(move.player);
+
+        renderer.drawStatusSquare(renderer.getDispX() + 50 * move.xPos + 25, renderer.getDispY() + 50 * move.yPos + 25);
+    }
+
+    // The progress bar, filled up to the current move
+    RectangleShape bar(Vector2f(BAR_WIDTH, BAR_HEIGHT));
+    bar.setPosition(BAR_X, BAR_Y);
+    bar.setFillColor(Color(60, 60, 60));
+    _window.draw(bar);
+
+    double progress = _replay.getNumMoves() > 0 ? (double) frame.moves / _replay.getNumMoves() : 0;
+    bar.setSize(Vector2f(BAR_WIDTH * progress, BAR_HEIGHT));
+    bar.setFillColor(Color(120, 120, 120));
+    _window.draw(bar);
+
+    // Which game and move this is, and how it's being played
+    const GameRecord &record = _replay.getRecord();
+    string winner = record.winner >= 0 ? record.playerNames.at(record.winner) + " won" : "unfinished";
+
+    char status[256];
+    snprintf(status, sizeof(status), "Game %d of %d (%s)     Move %d of %d     %g moves/s%s%s", _gameIndex + 1,
+             (int) _games.size(), winner.c_str(), frame.moves, _replay.getNumMoves(), _movesPerSecond,
+             _paused ? "     paused" : "", _autoAdvance ? "     auto-advancing" : "");
+
+    Text statusText;
+    statusText.setFont(_font);
+    statusText.setString(status);
+    statusText.setCharacterSize(24);
+    statusText.setFillColor(Color::White);
+    statusText.setPosition(BAR_X, BAR_Y + 25);
+    _window.draw(statusText);
+
+    Text helpText;
+    helpText.setFont(_font);
+    helpText.setString("Space: play/pause   Left/Right: step   Up/Down: speed   Home/End: start/end   "
+                       "Page Up/Down: previous/next game   A: auto-advance   Click the bar to jump");
+    helpText.setCharacterSize(16);
+    helpText.setFillColor(Color(180, 180, 180));
+    helpText.setPosition(BAR_X, BAR_Y + 60);
+    _window.draw(helpText);
+
+    _window.display();
+}
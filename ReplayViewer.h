@@ -0,0 +1,90 @@
+/* ReplayViewer.h
+ *
+ * Author: Colin Siles
+ *
+ * The ReplayViewer class plays back recorded games in an SFML window, using the BoardRenderer and FleetRenderer
+ * classes. Each side shows a player's shots at their opponent, and the opponent's ships they've sunk. Games play at
+ * any speed (up to thousands of moves a second), can be paused, stepped through a move at a time, or jumped around
+ * in (see GameReplay for how seeking stays fast), and a whole battlelog's worth of games can be flicked through, or
+ * played one after another
+ *
+ * Controls: Space to play/pause, Left/Right to step a move, Up/Down to double/halve the speed, Home/End to go to the
+ * start/end of the game, Page Up/Page Down for the previous/next game, A to go on to the next game automatically,
+ * and clicking the bar under the boards to jump to that point in the game
+*/
+
+#ifndef SFML_TEMPLATE_REPLAYVIEWER_H
+#define SFML_TEMPLATE_REPLAYVIEWER_H
+
+#include <SFML/Graphics.hpp>
+using namespace sf;
+
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "BinaryBattlelogReader.h"
+#include "Board.h"
+#include "BoardRenderer.h"
+#include "Fleet.h"
+#include "FleetRenderer.h"
+#include "GameReplay.h"
+
+using namespace std;
+
+class ReplayViewer {
+public:
+    ReplayViewer();
+
+    // Adds the games in a binary battlelog, or a text battlelog. Returns how many games were added
+    int addFile(string filename);
+    int getNumGames() const;
+
+    // Opens the window and plays the games, starting with the given one, until the window is closed
+    void run(int firstGame, double movesPerSecond);
+
+    // How long the end of a game stays up before going on to the next one (when that's turned on)
+    static const double END_PAUSE_SECONDS;
+
+private:
+    RenderWindow _window;
+    Font _font;
+
+    // Where each game is: binary games point into their reader's mapped file, and text battlelogs are read when
+    // they're shown
+    struct Source {
+        int reader;
+        BinaryGameView game;
+        string filename;
+    };
+
+    vector<unique_ptr<BinaryBattlelogReader>> _readers;
+    vector<Source> _games;
+
+    int _gameIndex;
+    GameReplay _replay;
+
+    // Each player's tracking board, and their opponent's fleet. Rebuilt for each game, since fleets can differ
+    vector<unique_ptr<Fleet>> _fleets;
+    vector<unique_ptr<Board>> _boards;
+    vector<unique_ptr<BoardRenderer>> _boardRenderers;
+    vector<unique_ptr<FleetRenderer>> _fleetRenderers;
+
+    // Playback: how far into the game (in moves, including part of the next one), and how fast it's going
+    double _position;
+    double _movesPerSecond;
+    bool _paused;
+    bool _autoAdvance;
+    double _endTime; // Seconds spent at the end of the game
+
+    void _loadGame(int index);
+
+    // Sets the boards and fleets to the replay's current frame
+    void _showFrame();
+
+    void _handleKey(Keyboard::Key key);
+    void _handleClick(int xPos, int yPos);
+    void _draw();
+};
+
+#endif //SFML_TEMPLATE_REPLAYVIEWER_H
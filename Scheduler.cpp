@@ -0,0 +1,135 @@
+/* Scheduler.cpp
+ *
+ * Author: Colin Siles
+ *
+ * The Scheduler class runs coroutines (like Game::runGameAsync) on a small pool of threads. A coroutine only holds
+ * a thread while it has work to do: when it waits for something (like a move from a remote player), it's suspended
+ * and its thread moves on to another one, so waiting games cost no CPU, and only the memory for their state
+*/
+
+#include <iostream>
+
+#include "Scheduler.h"
+
+// Starts suspended, so spawn can queue it, and cleans itself up when it's done
+struct Scheduler::DetachedTask {
+    struct promise_type {
+        DetachedTask get_return_object() {
+            return {coroutine_handle<promise_type>::from_promise(*this)};
+        }
+
+        suspend_always initial_suspend() noexcept {
+            return {};
+        }
+
+        suspend_never final_suspend() noexcept {
+            return {};
+        }
+
+        void return_void() {
+        }
+
+        void unhandled_exception() {
+            terminate();
+        }
+    };
+
+    coroutine_handle<promise_type> handle;
+};
+
+Scheduler::Scheduler(int numThreads) {
+    _running = 0;
+    _stopping = false;
+
+    if(numThreads <= 0) {
+        numThreads = max(1, (int) thread::hardware_concurrency());
+    }
+
+    for(int i = 0; i < numThreads; i++) {
+        _threads.push_back(thread(&Scheduler::_work, this));
+    }
+}
+
+Scheduler::~Scheduler() {
+    {
+        lock_guard<mutex> lock(_mutex);
+        _stopping = true;
+    }
+
+    _readyCondition.notify_all();
+
+    for(int i = 0; i < _threads.size(); i++) {
+        _threads.at(i).join();
+    }
+}
+
+void Scheduler::spawn(Task<void> task) {
+    {
+        lock_guard<mutex> lock(_mutex);
+        _running++;
+    }
+
+    schedule(_runDetached(this, move(task)).handle);
+}
+
+void Scheduler::schedule(coroutine_handle<> handle) {
+    {
+        lock_guard<mutex> lock(_mutex);
+        _ready.push_back(handle);
+    }
+
+    _readyCondition.notify_one();
+}
+
+Scheduler::ScheduleAwaiter Scheduler::yield() {
+    return {this};
+}
+
+void Scheduler::waitIdle() {
+    unique_lock<mutex> lock(_mutex);
+    _idleCondition.wait(lock, [this] { return _running == 0; });
+}
+
+int Scheduler::numRunning() {
+    lock_guard<mutex> lock(_mutex);
+    return _running;
+}
+
+void Scheduler::_work() {
+    while(true) {
+        coroutine_handle<> handle;
+
+        {
+            unique_lock<mutex> lock(_mutex);
+            _readyCondition.wait(lock, [this] { return _stopping || !_ready.empty(); });
+
+            if(_ready.empty()) {
+                return;
+            }
+
+            handle = _ready.front();
+            _ready.pop_front();
+        }
+
+        // Runs until the coroutine finishes or suspends again
+        handle.resume();
+    }
+}
+
+Scheduler::DetachedTask Scheduler::_runDetached(Scheduler *scheduler, Task<void> task) {
+    try {
+        co_await task;
+    } catch(exception &error) {
+        cerr << "A scheduled task failed: " << error.what() << endl;
+    }
+
+    scheduler->_taskFinished();
+}
+
+void Scheduler::_taskFinished() {
+    lock_guard<mutex> lock(_mutex);
+
+    if(--_running == 0) {
+        _idleCondition.notify_all();
+    }
+}
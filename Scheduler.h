@@ -0,0 +1,81 @@
+/* Scheduler.h
+ *
+ * Author: Colin Siles
+ *
+ * The Scheduler class runs coroutines (like Game::runGameAsync) on a small pool of threads. A coroutine only holds
+ * a thread while it has work to do: when it waits for something (like a move from a remote player), it's suspended
+ * and its thread moves on to another one, so waiting games cost no CPU, and only the memory for their state
+*/
+
+#ifndef SFML_TEMPLATE_SCHEDULER_H
+#define SFML_TEMPLATE_SCHEDULER_H
+
+#include <condition_variable>
+#include <coroutine>
+#include <deque>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#include "Task.h"
+
+using namespace std;
+
+class Scheduler {
+public:
+    // Starts the given number of threads (one per core by default)
+    Scheduler(int numThreads = 0);
+    ~Scheduler(); // Destructor, which waits for the running coroutines to suspend, then stops the threads
+
+    // Starts running a task on the pool. The scheduler owns the task until it finishes
+    void spawn(Task<void> task);
+
+    // Queues a suspended coroutine to be resumed on the pool. Safe to call from any thread
+    void schedule(coroutine_handle<> handle);
+
+    // Awaitable that moves the awaiting coroutine onto the pool (or to the back of its queue, if already on it)
+    struct ScheduleAwaiter {
+        Scheduler *scheduler;
+
+        bool await_ready() noexcept {
+            return false;
+        }
+
+        void await_suspend(coroutine_handle<> handle) {
+            scheduler->schedule(handle);
+        }
+
+        void await_resume() noexcept {
+        }
+    };
+
+    ScheduleAwaiter yield();
+
+    // Blocks until every spawned task has finished
+    void waitIdle();
+
+    // Number of spawned tasks that haven't finished
+    int numRunning();
+
+private:
+    vector<thread> _threads;
+
+    // Coroutines ready to be resumed
+    deque<coroutine_handle<>> _ready;
+    mutex _mutex;
+    condition_variable _readyCondition;
+    condition_variable _idleCondition;
+
+    int _running;
+    bool _stopping;
+
+    // Loop each thread runs, resuming ready coroutines until the scheduler is destroyed
+    void _work();
+
+    // Coroutine that runs a spawned task, then tells the scheduler it finished
+    struct DetachedTask;
+    static DetachedTask _runDetached(Scheduler *scheduler, Task<void> task);
+    void _taskFinished();
+};
+
+#endif //SFML_TEMPLATE_SCHEDULER_H
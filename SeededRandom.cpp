@@ -0,0 +1,33 @@
+/* SeededRandom.cpp
+ *
+ * Author: Colin Siles
+ *
+ * The SeededRandom class is a mt19937 that remembers its seed and counts its draws, so its state is just those two
+*/
+
+#include "SeededRandom.h"
+
+SeededRandom::SeededRandom(result_type seed) {
+    this->seed(seed);
+}
+
+void SeededRandom::seed(result_type seed) {
+    _generator.seed(seed);
+    _seed = seed;
+    _draws = 0;
+}
+
+void SeededRandom::restore(result_type seed, uint64_t draws) {
+    this->seed(seed);
+
+    _generator.discard(draws);
+    _draws = draws;
+}
+
+SeededRandom::result_type SeededRandom::getSeed() const {
+    return _seed;
+}
+
+uint64_t SeededRandom::getDraws() const {
+    return _draws;
+}
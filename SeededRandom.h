@@ -0,0 +1,53 @@
+/* SeededRandom.h
+ *
+ * Author: Colin Siles
+ *
+ * The SeededRandom class is a mt19937 that remembers the seed it was given and counts the numbers it has drawn since,
+ * so its state can be saved as just those two numbers (rather than the generator's 624 words) and brought back by
+ * seeding a generator again and skipping as many numbers. It can be used anywhere a random number generator can
+*/
+
+#ifndef SFML_TEMPLATE_SEEDEDRANDOM_H
+#define SFML_TEMPLATE_SEEDEDRANDOM_H
+
+#include <cstdint>
+#include <random>
+
+using namespace std;
+
+class SeededRandom {
+public:
+    typedef mt19937::result_type result_type;
+
+    explicit SeededRandom(result_type seed = mt19937::default_seed);
+
+    static constexpr result_type min() {
+        return mt19937::min();
+    }
+
+    static constexpr result_type max() {
+        return mt19937::max();
+    }
+
+    // Draws the next number (in the header, since it's called so often)
+    result_type operator()() {
+        _draws++;
+        return _generator();
+    }
+
+    // Starts over from the seed, with nothing drawn
+    void seed(result_type seed);
+
+    // Starts over from the seed, and skips the given number of draws (which takes time in proportion to them)
+    void restore(result_type seed, uint64_t draws);
+
+    result_type getSeed() const;
+    uint64_t getDraws() const;
+
+private:
+    mt19937 _generator;
+    result_type _seed;
+    uint64_t _draws;
+};
+
+#endif //SFML_TEMPLATE_SEEDEDRANDOM_H
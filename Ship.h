@@ -54,6 +54,7 @@ public:
 
     // Friend classes to prevent a lot of extra getters and setters for this class
     friend class Board;
+    friend class Fleet;
     friend class ShipRenderer;
 
 private:
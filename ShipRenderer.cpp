@@ -7,41 +7,68 @@
 */
 
 #include "ShipRenderer.h"
+#include "VertexShapes.h"
 
 // Primary constructor: simple copy the arguments
-ShipRenderer::ShipRenderer(RenderWindow &window, Ship *ship, double dispX, double dispY) {
+ShipRenderer::ShipRenderer(RenderWindow &window, Ship *ship, double dispX, double dispY) : _vertices(Triangles) {
     _window = &window;
     _ship = ship;
     _dispX = dispX;
     _dispY = dispY;
+
+    _built = false;
 }
 
 void ShipRenderer::draw(bool placingShips) {
+    updateVertices(placingShips);
+    _window->draw(_vertices);
+}
+
+bool ShipRenderer::updateVertices(bool placingShips) {
     // Only draw if this ship hasn't been placed, or ships aren't being placed
     // The reason is that the board will draw placed ships, so this avoid duplicates being drawn
-    if(!_ship->_placed || !placingShips) {
-        Orientation drawOrientation = _ship->_orientation;
+    bool visible = !_ship->_placed || !placingShips;
 
-        // Draw horizontally if not placing ships, because they are always drawn that way on the side
-        if(!placingShips) {
-            drawOrientation = HORIZONTAL;
-        }
+    // Draw horizontally if not placing ships, because they are always drawn that way on the side
+    Orientation drawOrientation = placingShips ? _ship->_orientation : HORIZONTAL;
+
+    if(_built && visible == _drawnVisible && _ship->isSunk() == _drawnSunk && drawOrientation == _drawnOrientation &&
+       _dispX == _drawnX && _dispY == _drawnY) {
+        return false;
+    }
 
+    _built = true;
+    _drawnVisible = visible;
+    _drawnSunk = _ship->isSunk();
+    _drawnOrientation = drawOrientation;
+    _drawnX = _dispX;
+    _drawnY = _dispY;
+
+    _vertices.clear();
+
+    if(visible) {
         int xStep = drawOrientation == HORIZONTAL;
         int yStep = drawOrientation == VERTICAL;
+        Color color = _ship->isSunk() ? Color::Red : Color(125, 125, 125);
 
-        // Iterate through each square and draw the rectangle for the ship
+        // Iterate through each square, adding the rectangle for the ship and then its 2 pixel outline
         for(int i = 0; i < _ship->getLength(); i++) {
-            RectangleShape shipPart(Vector2f(50, 50));
-            shipPart.setPosition(_dispX + i * xStep * 50, _dispY + i * yStep * 50);
-            shipPart.setOutlineColor(Color::Black);
-            shipPart.setOutlineThickness(2);
-
-            shipPart.setFillColor(_ship->isSunk() ? Color::Red : Color(125, 125, 125));
+            float xPos = _dispX + i * xStep * 50;
+            float yPos = _dispY + i * yStep * 50;
 
-            _window->draw(shipPart);
+            addRectangle(_vertices, xPos, yPos, 50, 50, color);
+            addRectangle(_vertices, xPos - 2, yPos - 2, 54, 2, Color::Black);
+            addRectangle(_vertices, xPos - 2, yPos + 50, 54, 2, Color::Black);
+            addRectangle(_vertices, xPos - 2, yPos, 2, 50, Color::Black);
+            addRectangle(_vertices, xPos + 50, yPos, 2, 50, Color::Black);
         }
     }
+
+    return true;
+}
+
+const VertexArray &ShipRenderer::getVertices() const {
+    return _vertices;
 }
 
 // Returns true if the mousePos is within the ship's drawing boundaries
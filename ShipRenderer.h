@@ -21,6 +21,11 @@ public:
     // Draws the ship, unless ships are being placed, and this one was placed
     void draw(bool placingShips);
 
+    // Brings the ship's vertices up to date (empty if the ship isn't drawn), and returns true if they changed. Lets
+    // the FleetRenderer draw the whole fleet at once
+    bool updateVertices(bool placingShips);
+    const VertexArray &getVertices() const;
+
     // Sets the coordinates of teh ship within the window
     void setXY(double xPos, double yPos);
 
@@ -39,6 +44,15 @@ private:
     Ship *_ship; // Store a pointer to the ship, so that it can be modified
     double _dispX;
     double _dispY;
+
+    // The ship's squares, kept until the ship moves, turns, sinks or is hidden, along with what they were built from
+    VertexArray _vertices;
+    bool _built;
+    bool _drawnVisible;
+    bool _drawnSunk;
+    Orientation _drawnOrientation;
+    double _drawnX;
+    double _drawnY;
 };
 
 #endif //SFML_TEMPLATE_SHIPRENDERER_H
@@ -0,0 +1,183 @@
+/* Simulation.cpp
+ *
+ * Author: Colin Siles
+ *
+ * Helper functions for running games without a window or a battlelog, for benchmarks and other batch simulations
+*/
+
+#include <algorithm>
+#include <atomic>
+#include <thread>
+
+#include "PlacementTable.h"
+#include "Simulation.h"
+
+int huntToSink(Player &hunter, Player &target, HuntStats &stats) {
+    int shots = 0;
+
+    // Same loop as Game::runGame, but with only one side shooting
+    while(!target.allShipsSunk()) {
+        chrono::steady_clock::time_point start = chrono::steady_clock::now();
+        pair<int, int> move = hunter.getMove();
+        stats.moveTime += chrono::duration<double>(chrono::steady_clock::now() - start).count();
+
+        ShotOutcome outcome = target.fireShotAt(move.first, move.second);
+        hunter.markShot(move.first, move.second, outcome);
+
+        shots++;
+    }
+
+    stats.shots += shots;
+    return shots;
+}
+
+// Same check as Game::_validMoves: at least one move, each on the board, not fired at already, and not repeated
+static bool validMoves(Player &player, const vector<pair<int, int>> &moves) {
+    if(moves.empty()) {
+        return false;
+    }
+
+    CellMask aimed;
+
+    for(int i = 0; i < moves.size(); i++) {
+        int xPos = moves.at(i).first;
+        int yPos = moves.at(i).second;
+
+        if(!player.validGuess(xPos, yPos) || aimed.test(cellIndex(xPos, yPos))) {
+            return false;
+        }
+
+        aimed.set(cellIndex(xPos, yPos));
+    }
+
+    return true;
+}
+
+int playGame(Player &first, Player &second, int &winnerShots) {
+    vector<Player *> players = {&first, &second};
+    vector<int> shots = {0, 0};
+
+    for(int i = 0; i < 2; i++) {
+        players.at(i)->placeShips();
+    }
+
+    // Same loop as Game::runGame
+    for(int turn = 0; true; turn = !turn) {
+        pair<int, int> move = players.at(turn)->getMove();
+
+        // A player that doesn't give a move that can be made (on the board, and not fired at already) forfeits
+        if(!players.at(turn)->validGuess(move.first, move.second)) {
+            winnerShots = shots.at(!turn);
+            return !turn;
+        }
+
+        ShotOutcome outcome = players.at(!turn)->fireShotAt(move.first, move.second);
+        players.at(turn)->markShot(move.first, move.second, outcome);
+
+        shots.at(turn)++;
+
+        if(players.at(!turn)->allShipsSunk()) {
+            players.at(turn)->reportGameover(true);
+            players.at(!turn)->reportGameover(false);
+
+            winnerShots = shots.at(turn);
+            return turn;
+        }
+    }
+}
+
+int playSalvoGame(Player &first, Player &second, int &winnerShots) {
+    vector<Player *> players = {&first, &second};
+    vector<int> shots = {0, 0};
+
+    for(int i = 0; i < 2; i++) {
+        players.at(i)->placeShips();
+    }
+
+    vector<ShotOutcome> outcomes;
+
+    // Same loop as Game::runGame with salvos turned on
+    for(int turn = 0; true; turn = !turn) {
+        int salvoSize = min(players.at(turn)->numShipsAfloat(), NUM_CELLS - shots.at(turn));
+        vector<pair<int, int>> moves = players.at(turn)->getMoves(salvoSize);
+
+        // A player that doesn't give moves that can be made forfeits
+        if(!validMoves(*players.at(turn), moves)) {
+            winnerShots = shots.at(!turn);
+            return !turn;
+        }
+
+        players.at(!turn)->fireShotsAt(moves, outcomes);
+        for(int i = 0; i < moves.size(); i++) {
+            players.at(turn)->markShot(moves.at(i).first, moves.at(i).second, outcomes.at(i));
+        }
+
+        shots.at(turn) += moves.size();
+
+        if(players.at(!turn)->allShipsSunk()) {
+            players.at(turn)->reportGameover(true);
+            players.at(!turn)->reportGameover(false);
+
+            winnerShots = shots.at(turn);
+            return turn;
+        }
+    }
+}
+
+vector<int> randomFleet(const vector<int> &shipLengths, mt19937 &random) {
+    // Boxing a ship in is very unlikely with a normal fleet, but just start over if it does happen
+    while(true) {
+        vector<int> fleet;
+        CellMask occupied;
+
+        for(int i = 0; i < shipLengths.size(); i++) {
+            const vector<Placement> &placements = PlacementTable::forLength(shipLengths.at(i)).placements();
+
+            vector<int> fitting;
+            for(int j = 0; j < placements.size(); j++) {
+                if((placements.at(j).mask & occupied).none()) {
+                    fitting.push_back(j);
+                }
+            }
+
+            if(fitting.empty()) {
+                break;
+            }
+
+            int chosen = fitting.at(random() % fitting.size());
+            fleet.push_back(chosen);
+            occupied |= placements.at(chosen).mask;
+        }
+
+        if(fleet.size() == shipLengths.size()) {
+            return fleet;
+        }
+    }
+}
+
+void runJobs(int numJobs, int numThreads, const function<void(int)> &job, chrono::steady_clock::time_point deadline) {
+    // Each thread takes the next job nobody has started yet
+    atomic<int> nextJob(0);
+
+    auto worker = [&]() {
+        while(chrono::steady_clock::now() < deadline) {
+            int current = nextJob++;
+            if(current >= numJobs) {
+                return;
+            }
+
+            job(current);
+        }
+    };
+
+    vector<thread> threads;
+    for(int i = 1; i < numThreads; i++) {
+        threads.push_back(thread(worker));
+    }
+
+    worker();
+
+    for(int i = 0; i < threads.size(); i++) {
+        threads.at(i).join();
+    }
+}
@@ -0,0 +1,47 @@
+/* Simulation.h
+ *
+ * Author: Colin Siles
+ *
+ * Helper functions for running games without a window or a battlelog, for benchmarks and other batch simulations
+*/
+
+#ifndef SFML_TEMPLATE_SIMULATION_H
+#define SFML_TEMPLATE_SIMULATION_H
+
+#include <chrono>
+#include <functional>
+#include <random>
+#include <vector>
+
+#include "Player.h"
+
+// Tracks the totals of a batch of simulated hunts
+struct HuntStats {
+    long shots;        // Total shots fired across all the hunts
+    double moveTime;   // Total time spent in getMove (in seconds)
+};
+
+// Has the hunter fire at the target (which must have placed its ships) until every one of the target's ships is sunk
+// Returns the number of shots it took, and adds the shots and time spent choosing moves to the stats
+int huntToSink(Player &hunter, Player &target, HuntStats &stats);
+
+// Plays a whole game between two players, without a window or battlelog (so without reporting the opponent either,
+// which keeps the computer from reading and writing its learned models). Both players place their ships, then take
+// turns firing, starting with the first. A player that gives a move off the board, or at a square it has fired at
+// already, forfeits. Returns the index of the winner, and stores the number of shots they fired
+int playGame(Player &first, Player &second, int &winnerShots);
+
+// The same, for the salvo variant (see Game::setSalvo): each turn, a player fires a salvo of one shot for each of their
+// ships afloat, resolved all at once
+int playSalvoGame(Player &first, Player &second, int &winnerShots);
+
+// Draws a random fleet, one ship at a time from the placements that don't overlap the ships before it
+// Returns the index of each ship's placement in the PlacementTable for its length (see Player::placeShipsAt)
+vector<int> randomFleet(const vector<int> &shipLengths, mt19937 &random);
+
+// Runs job(0) through job(numJobs - 1) on the given number of threads (the calling thread being one of them)
+// Jobs that haven't started by the deadline are skipped
+void runJobs(int numJobs, int numThreads, const function<void(int)> &job,
+             chrono::steady_clock::time_point deadline = chrono::steady_clock::time_point::max());
+
+#endif //SFML_TEMPLATE_SIMULATION_H
@@ -0,0 +1,194 @@
+/* SunkShipTracker.cpp
+ *
+ * Author: Colin Siles
+ *
+ * The SunkShipTracker class works out which hits belong to ships that have already been sunk. Every time a ship sinks,
+ * it records each placement that ship could have had (it has to cover the square that sank it, and every one of its
+ * squares must have been hit). It then keeps only the combinations of placements for the sunken ships that don't
+ * overlap, and that leave every other hit coverable by a ship still afloat. Squares that are sunk in every
+ * combination are resolved; squares that are sunk in some combinations but not others stay ambiguous until later shots
+ * settle them
+*/
+
+#include "SunkShipTracker.h"
+
+// Caps the search, in case a very unusual fleet makes the number of combinations explode
+static const int MAX_SEARCH_STEPS = 100000;
+
+SunkShipTracker::SunkShipTracker(vector<int> shipLengths) : _candidates(shipLengths.size()) {
+    _lengths = shipLengths;
+    _sunk.assign(shipLengths.size(), false);
+
+    _combinations = 0;
+    _steps = 0;
+}
+
+void SunkShipTracker::markShot(int cell, ShotOutcome outcome) {
+    if(outcome.hit) {
+        _hits.set(cell);
+    } else {
+        _misses.set(cell);
+    }
+
+    if(outcome.sunkenIndex >= 0) {
+        _addSunkShip(outcome.sunkenIndex, cell);
+
+    // Any other shot can still settle an ambiguous hit: a miss can leave a ship afloat with nowhere to go but over it,
+    // and so can a hit (a ship afloat can't have all its squares hit)
+    } else if(_ambiguousCells.none()) {
+        return;
+    }
+
+    // The search has to run with the whole outcome marked, or the ship that just sank would look like it was afloat
+    _solve();
+}
+
+void SunkShipTracker::_addSunkShip(int ship, int cell) {
+    const PlacementTable &table = PlacementTable::forLength(_lengths.at(ship));
+    const vector<int> &covering = table.covering(cell);
+
+    _sunk.at(ship) = true;
+    _candidates.at(ship).clear();
+
+    // The ship must cover the square that sank it, and every one of its squares must have been hit by now
+    for(int i = 0; i < covering.size(); i++) {
+        const CellMask &mask = table.placements().at(covering.at(i)).mask;
+
+        if((mask & ~_hits).none()) {
+            _candidates.at(ship).push_back(covering.at(i));
+        }
+    }
+}
+
+// Getters for the results of the search
+CellMask SunkShipTracker::sunkCells() const {
+    return _sunkCells;
+}
+
+CellMask SunkShipTracker::ambiguousCells() const {
+    return _ambiguousCells;
+}
+
+bool SunkShipTracker::isResolved(int ship) const {
+    return _sunk.at(ship) && _candidates.at(ship).size() == 1;
+}
+
+void SunkShipTracker::_solve() {
+    // Gather the sunken ships, and reset the record of which of their placements show up in a valid combination
+    _sunkShips.clear();
+    _usedCandidates.assign(_lengths.size(), vector<bool>());
+
+    for(int i = 0; i < _lengths.size(); i++) {
+        if(_sunk.at(i)) {
+            _sunkShips.push_back(i);
+            _usedCandidates.at(i).assign(_candidates.at(i).size(), false);
+        }
+    }
+
+    _alwaysSunk.set();
+    _sometimesSunk.reset();
+    _combinations = 0;
+    _steps = 0;
+
+    vector<int> chosen;
+    _search(0, CellMask(), chosen);
+
+    // If nothing is consistent (which shouldn't happen), or the search gave up, keep what we knew before
+    if(_combinations == 0 || _steps > MAX_SEARCH_STEPS) {
+        return;
+    }
+
+    // Later shots can only rule out more placements, so drop the ones that didn't fit any combination for good
+    for(int i = 0; i < _sunkShips.size(); i++) {
+        int ship = _sunkShips.at(i);
+        vector<int> remaining;
+
+        for(int j = 0; j < _candidates.at(ship).size(); j++) {
+            if(_usedCandidates.at(ship).at(j)) {
+                remaining.push_back(_candidates.at(ship).at(j));
+            }
+        }
+
+        _candidates.at(ship) = remaining;
+    }
+
+    _sunkCells = _alwaysSunk;
+    _ambiguousCells = _sometimesSunk & ~_alwaysSunk;
+}
+
+void SunkShipTracker::_search(int depth, CellMask occupied, vector<int> &chosen) {
+    if(++_steps > MAX_SEARCH_STEPS) {
+        return;
+    }
+
+    // Every sunken ship has a placement. Keep the combination if the rest of the hits still make sense
+    if(depth == _sunkShips.size()) {
+        if(!_hitsCoverable(occupied)) {
+            return;
+        }
+
+        _combinations++;
+        _alwaysSunk &= occupied;
+        _sometimesSunk |= occupied;
+
+        for(int i = 0; i < chosen.size(); i++) {
+            _usedCandidates.at(_sunkShips.at(i)).at(chosen.at(i)) = true;
+        }
+
+        return;
+    }
+
+    int ship = _sunkShips.at(depth);
+
+    for(int i = 0; i < _candidates.at(ship).size(); i++) {
+        const CellMask &mask = _placement(ship, _candidates.at(ship).at(i)).mask;
+
+        // Sunken ships can't overlap each other
+        if((mask & occupied).any()) {
+            continue;
+        }
+
+        chosen.push_back(i);
+        _search(depth + 1, occupied | mask, chosen);
+        chosen.pop_back();
+    }
+}
+
+bool SunkShipTracker::_hitsCoverable(const CellMask &sunk) {
+    CellMask loose = _hits & ~sunk;
+
+    for(int cell = 0; cell < NUM_CELLS; cell++) {
+        if(!loose.test(cell)) {
+            continue;
+        }
+
+        bool coverable = false;
+
+        // Look for any ship still afloat that could sit on the hit, without covering a miss or a sunken ship,
+        // and without every one of its squares being hit (then it would have sunk)
+        for(int i = 0; i < _lengths.size() && !coverable; i++) {
+            if(_sunk.at(i)) {
+                continue;
+            }
+
+            const PlacementTable &table = PlacementTable::forLength(_lengths.at(i));
+            const vector<int> &covering = table.covering(cell);
+
+            for(int j = 0; j < covering.size() && !coverable; j++) {
+                const CellMask &mask = table.placements().at(covering.at(j)).mask;
+
+                coverable = (mask & (_misses | sunk)).none() && (mask & ~_hits).any();
+            }
+        }
+
+        if(!coverable) {
+            return false;
+        }
+    }
+
+    return true;
+}
+
+const Placement &SunkShipTracker::_placement(int ship, int index) const {
+    return PlacementTable::forLength(_lengths.at(ship)).placements().at(index);
+}
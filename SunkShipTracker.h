@@ -0,0 +1,74 @@
+/* SunkShipTracker.h
+ *
+ * Author: Colin Siles
+ *
+ * The SunkShipTracker class works out which hits belong to ships that have already been sunk. Every time a ship sinks,
+ * it records each placement that ship could have had (it has to cover the square that sank it, and every one of its
+ * squares must have been hit). It then keeps only the combinations of placements for the sunken ships that don't
+ * overlap, and that leave every other hit coverable by a ship still afloat. Squares that are sunk in every
+ * combination are resolved; squares that are sunk in some combinations but not others stay ambiguous until later shots
+ * settle them
+*/
+
+#ifndef SFML_TEMPLATE_SUNKSHIPTRACKER_H
+#define SFML_TEMPLATE_SUNKSHIPTRACKER_H
+
+#include <vector>
+
+#include "PlacementTable.h"
+
+using namespace std;
+
+class SunkShipTracker {
+public:
+    SunkShipTracker(vector<int> shipLengths);
+
+    // Records the outcome of a shot, and works out which hits are now known to be sunk
+    void markShot(int cell, ShotOutcome outcome);
+
+    // Hits known to belong to a sunken ship
+    CellMask sunkCells() const;
+
+    // Hits that might belong to a sunken ship, or to a ship that's still afloat
+    CellMask ambiguousCells() const;
+
+    // Returns true if the exact position of the (sunken) ship is known
+    bool isResolved(int ship) const;
+
+private:
+    vector<int> _lengths;
+    vector<bool> _sunk;
+
+    CellMask _hits;
+    CellMask _misses;
+
+    // For every sunken ship, the placements it could still have
+    vector<vector<int>> _candidates;
+
+    CellMask _sunkCells;
+    CellMask _ambiguousCells;
+
+    // Work areas for the search over combinations of placements
+    vector<int> _sunkShips;
+    vector<vector<bool>> _usedCandidates;
+    CellMask _alwaysSunk;
+    CellMask _sometimesSunk;
+    int _combinations;
+    int _steps;
+
+    // Records the placements a ship that just sank could have
+    void _addSunkShip(int ship, int cell);
+
+    // Re-runs the search over the combinations of placements of the sunken ships
+    void _solve();
+
+    // Recursive helper for _solve: picks a placement for the sunken ship at the given depth
+    void _search(int depth, CellMask occupied, vector<int> &chosen);
+
+    // Returns true if every hit outside of the sunken ships could belong to a ship that's still afloat
+    bool _hitsCoverable(const CellMask &sunk);
+
+    const Placement &_placement(int ship, int index) const;
+};
+
+#endif //SFML_TEMPLATE_SUNKSHIPTRACKER_H
@@ -0,0 +1,248 @@
+/* Task.h (includes both the header and the implementation, since this class is templated)
+ *
+ * Author: Colin Siles
+ *
+ * The Task class is the return type of the coroutine versions of the Player functions (and of Game::runGameAsync).
+ * A task doesn't start until it's awaited, and when it finishes it resumes whoever awaited it. Tasks are run on a
+ * Scheduler, or synchronously with syncWait
+*/
+
+#ifndef SFML_TEMPLATE_TASK_H
+#define SFML_TEMPLATE_TASK_H
+
+#include <condition_variable>
+#include <coroutine>
+#include <exception>
+#include <mutex>
+#include <optional>
+#include <utility>
+
+using namespace std;
+
+template<typename T>
+class Task;
+
+// The parts of a task's promise that don't depend on the type it returns
+class TaskPromiseBase {
+public:
+    // Tasks start suspended, so they only run once they're awaited
+    suspend_always initial_suspend() noexcept {
+        return {};
+    }
+
+    // When the task finishes, hand control straight back to the coroutine that awaited it (if any)
+    struct FinalAwaiter {
+        bool await_ready() noexcept {
+            return false;
+        }
+
+        template<typename Promise>
+        coroutine_handle<> await_suspend(coroutine_handle<Promise> handle) noexcept {
+            coroutine_handle<> continuation = handle.promise()._continuation;
+            return continuation ? continuation : noop_coroutine();
+        }
+
+        void await_resume() noexcept {
+        }
+    };
+
+    FinalAwaiter final_suspend() noexcept {
+        return {};
+    }
+
+    void unhandled_exception() {
+        _exception = current_exception();
+    }
+
+    void setContinuation(coroutine_handle<> continuation) {
+        _continuation = continuation;
+    }
+
+protected:
+    coroutine_handle<> _continuation;
+    exception_ptr _exception;
+
+    void _rethrow() {
+        if(_exception) {
+            rethrow_exception(_exception);
+        }
+    }
+};
+
+template<typename T>
+class TaskPromise : public TaskPromiseBase {
+public:
+    Task<T> get_return_object();
+
+    void return_value(T value) {
+        _value = move(value);
+    }
+
+    T result() {
+        _rethrow();
+        return move(*_value);
+    }
+
+private:
+    optional<T> _value;
+};
+
+template<>
+class TaskPromise<void> : public TaskPromiseBase {
+public:
+    Task<void> get_return_object();
+
+    void return_void() {
+    }
+
+    void result() {
+        _rethrow();
+    }
+};
+
+template<typename T = void>
+class Task {
+public:
+    typedef TaskPromise<T> promise_type;
+
+    explicit Task(coroutine_handle<promise_type> handle) : _handle(handle) {
+    }
+
+    // Tasks can be moved, but not copied, since each one owns its coroutine
+    Task(Task &&other) noexcept : _handle(exchange(other._handle, nullptr)) {
+    }
+
+    Task &operator=(Task &&other) noexcept {
+        if(this != &other) {
+            if(_handle) {
+                _handle.destroy();
+            }
+
+            _handle = exchange(other._handle, nullptr);
+        }
+
+        return *this;
+    }
+
+    Task(const Task &) = delete;
+    Task &operator=(const Task &) = delete;
+
+    ~Task() {
+        if(_handle) {
+            _handle.destroy();
+        }
+    }
+
+    // Awaiting a task starts it, and suspends the awaiting coroutine until it's done
+    bool await_ready() const noexcept {
+        return !_handle || _handle.done();
+    }
+
+    coroutine_handle<> await_suspend(coroutine_handle<> awaiting) noexcept {
+        _handle.promise().setContinuation(awaiting);
+        return _handle;
+    }
+
+    T await_resume() {
+        return _handle.promise().result();
+    }
+
+private:
+    coroutine_handle<promise_type> _handle;
+};
+
+template<typename T>
+Task<T> TaskPromise<T>::get_return_object() {
+    return Task<T>(coroutine_handle<TaskPromise<T>>::from_promise(*this));
+}
+
+inline Task<void> TaskPromise<void>::get_return_object() {
+    return Task<void>(coroutine_handle<TaskPromise<void>>::from_promise(*this));
+}
+
+// Coroutine used by syncWait: runs the task, then wakes up the waiting thread. It isn't awaited by anything, so it
+// starts right away and cleans itself up when it's done
+struct SyncWaitTask {
+    struct promise_type {
+        SyncWaitTask get_return_object() {
+            return {};
+        }
+
+        suspend_never initial_suspend() noexcept {
+            return {};
+        }
+
+        suspend_never final_suspend() noexcept {
+            return {};
+        }
+
+        void return_void() {
+        }
+
+        void unhandled_exception() {
+            terminate();
+        }
+    };
+};
+
+// Runs a task on the calling thread, blocking until it finishes (if it suspends, whatever resumes it may be another
+// thread). This is how the synchronous interface is kept working on top of the coroutines
+template<typename T>
+T syncWait(Task<T> task) {
+    mutex finishedMutex;
+    condition_variable finishedCondition;
+    bool finished = false;
+    optional<T> value;
+    exception_ptr exception;
+
+    [](Task<T> &task, optional<T> &value, exception_ptr &exception, mutex &finishedMutex,
+       condition_variable &finishedCondition, bool &finished) -> SyncWaitTask {
+        try {
+            value.emplace(co_await task);
+        } catch(...) {
+            exception = current_exception();
+        }
+
+        lock_guard<mutex> lock(finishedMutex);
+        finished = true;
+        finishedCondition.notify_one();
+    }(task, value, exception, finishedMutex, finishedCondition, finished);
+
+    unique_lock<mutex> lock(finishedMutex);
+    finishedCondition.wait(lock, [&] { return finished; });
+
+    if(exception) {
+        rethrow_exception(exception);
+    }
+
+    return move(*value);
+}
+
+inline void syncWait(Task<void> task) {
+    mutex finishedMutex;
+    condition_variable finishedCondition;
+    bool finished = false;
+    exception_ptr exception;
+
+    [](Task<void> &task, exception_ptr &exception, mutex &finishedMutex, condition_variable &finishedCondition,
+       bool &finished) -> SyncWaitTask {
+        try {
+            co_await task;
+        } catch(...) {
+            exception = current_exception();
+        }
+
+        lock_guard<mutex> lock(finishedMutex);
+        finished = true;
+        finishedCondition.notify_one();
+    }(task, exception, finishedMutex, finishedCondition, finished);
+
+    unique_lock<mutex> lock(finishedMutex);
+    finishedCondition.wait(lock, [&] { return finished; });
+
+    if(exception) {
+        rethrow_exception(exception);
+    }
+}
+
+#endif //SFML_TEMPLATE_TASK_H
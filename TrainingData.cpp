@@ -0,0 +1,317 @@
+/* TrainingData.cpp
+ *
+ * Author: Colin Siles
+ *
+ * Exports training examples for machine learning from simulated games (see TrainingData.h for the layout)
+*/
+
+#include <cerrno>
+#include <cstring>
+#include <iostream>
+#include <memory>
+#include <random>
+
+#include <fcntl.h>
+#include <unistd.h>
+
+#include "Board.h"
+#include "IntelligentComputer.h"
+#include "PlayerRegistry.h"
+#include "Simulation.h"
+#include "TrainingData.h"
+
+// Sets bit cellIndex(x, y) of the bytes for each cell in the mask
+static void packCells(const CellMask &cells, uint8_t bytes[16]) {
+    for(int cell = 0; cell < NUM_CELLS; cell++) {
+        if(cells[cell]) {
+            bytes[cell / 8] |= 1 << (cell % 8);
+        }
+    }
+}
+
+// Writes all the bytes, unless the file can't be written to
+static bool writeAll(int fileDescriptor, const void *data, size_t size) {
+    size_t written = 0;
+
+    while(written < size) {
+        ssize_t result = write(fileDescriptor, (const char *) data + written, size - written);
+
+        if(result < 0 && errno == EINTR) {
+            continue;
+        }
+
+        if(result <= 0) {
+            return false;
+        }
+
+        written += result;
+    }
+
+    return true;
+}
+
+TrainingShardWriter::TrainingShardWriter(string prefix, int producer, long examplesPerShard) {
+    _prefix = prefix;
+    _producer = producer;
+    _examplesPerShard = max(examplesPerShard, 1L);
+
+    _fileDescriptor = -1;
+    _numShards = 0;
+    _shardExamples = 0;
+    _numExamples = 0;
+
+    _buffer.resize(BUFFER_EXAMPLES);
+    _buffered = 0;
+}
+
+TrainingShardWriter::~TrainingShardWriter() {
+    _flush();
+    _finishShard();
+}
+
+TrainingExample *TrainingShardWriter::reserve(int count) {
+    if(_buffered + count > BUFFER_EXAMPLES) {
+        _flush();
+    }
+
+    // Starts a new shard rather than splitting the examples between two
+    long inShard = _shardExamples + _buffered;
+    if(inShard > 0 && inShard + count > _examplesPerShard) {
+        _flush();
+        _finishShard();
+    }
+
+    return _buffer.data() + _buffered;
+}
+
+void TrainingShardWriter::commit(int count) {
+    _buffered += count;
+    _numExamples += count;
+}
+
+long TrainingShardWriter::getNumExamples() const {
+    return _numExamples;
+}
+
+int TrainingShardWriter::getNumShards() const {
+    return _numShards;
+}
+
+void TrainingShardWriter::_flush() {
+    if(_buffered == 0) {
+        return;
+    }
+
+    if(_fileDescriptor < 0) {
+        _startShard();
+    }
+
+    if(_fileDescriptor >= 0 && !writeAll(_fileDescriptor, _buffer.data(), _buffered * sizeof(TrainingExample))) {
+        cerr << "Failed to write training examples" << endl;
+    }
+
+    _shardExamples += _buffered;
+    _buffered = 0;
+}
+
+void TrainingShardWriter::_startShard() {
+    string filename = _prefix + "_" + to_string(_producer) + "_" + to_string(_numShards) + ".examples";
+
+    _fileDescriptor = open(filename.c_str(), O_WRONLY | O_CREAT | O_TRUNC | O_CLOEXEC, 0644);
+    if(_fileDescriptor < 0) {
+        cerr << "Failed to open " << filename << endl;
+        return;
+    }
+
+    // The numbers are written as they are in memory, which is little-endian on the machines this runs on
+    uint8_t header[HEADER_SIZE] = {};
+    uint16_t version = VERSION;
+    uint16_t exampleSize = sizeof(TrainingExample);
+
+    memcpy(header, "BSTX", 4);
+    memcpy(header + 4, &version, 2);
+    memcpy(header + 6, &exampleSize, 2);
+    header[8] = Board::GRID_SIZE;
+
+    if(!writeAll(_fileDescriptor, header, HEADER_SIZE)) {
+        cerr << "Failed to write to " << filename << endl;
+    }
+
+    _numShards++;
+    _shardExamples = 0;
+}
+
+// Fills in the number of examples, now that it's known
+void TrainingShardWriter::_finishShard() {
+    if(_fileDescriptor < 0) {
+        return;
+    }
+
+    uint64_t numExamples = _shardExamples;
+    if(pwrite(_fileDescriptor, &numExamples, 8, 16) != 8) {
+        cerr << "Failed to finish a shard of training examples" << endl;
+    }
+
+    close(_fileDescriptor);
+    _fileDescriptor = -1;
+    _shardExamples = 0;
+}
+
+TrainingDataExporter::TrainingDataExporter(string prefix, string firstPlayer, string secondPlayer,
+                                           vector<int> shipLengths) {
+    _prefix = prefix;
+    _playerDescriptions[0] = firstPlayer;
+    _playerDescriptions[1] = secondPlayer;
+    _shipLengths = shipLengths;
+
+    _numExamples = 0;
+    _numGames = 0;
+    _numShards = 0;
+}
+
+bool TrainingDataExporter::run(long numGames, int numThreads, uint64_t firstGameId, long examplesPerShard) {
+    numThreads = max(numThreads, 1);
+    atomic<bool> failed(false);
+
+    // Each thread is a producer, playing its share of the games into its own shards, with its own two players (which
+    // are started over for each game, rather than created again)
+    runJobs(numThreads, numThreads, [&](int producer) {
+        unique_ptr<Player> players[2];
+
+        for(int i = 0; i < 2; i++) {
+            players[i].reset(PlayerRegistry::create(_playerDescriptions[i], "Player " + to_string(i + 1), _shipLengths));
+            if(!players[i]) {
+                failed = true;
+                return;
+            }
+        }
+
+        TrainingShardWriter writer(_prefix, producer, examplesPerShard);
+
+        long firstGame = numGames * producer / numThreads;
+        long endGame = numGames * (producer + 1) / numThreads;
+
+        for(long game = firstGame; game < endGame && !failed; game++) {
+            _playGame(firstGameId + game, players, writer);
+        }
+
+        _numShards += writer.getNumShards();
+    });
+
+    return !failed;
+}
+
+long TrainingDataExporter::getNumExamples() const {
+    return _numExamples;
+}
+
+long TrainingDataExporter::getNumGames() const {
+    return _numGames;
+}
+
+int TrainingDataExporter::getNumShards() const {
+    return _numShards;
+}
+
+void TrainingDataExporter::_playGame(uint64_t gameId, unique_ptr<Player> players[2], TrainingShardWriter &writer) {
+    IntelligentComputer *computers[2];
+
+    // Every game is seeded from its id, so any example's game can be played again
+    seed_seq seeds = {(uint32_t) gameId, (uint32_t) (gameId >> 32)};
+    mt19937 seeder(seeds);
+
+    for(int i = 0; i < 2; i++) {
+        players[i]->resetState();
+        players[i]->setSeed(seeder());
+        players[i]->placeShips();
+        computers[i] = dynamic_cast<IntelligentComputer *>(players[i].get());
+    }
+
+    // No game can have more moves than there are cells on both boards
+    const int maxExamples = 2 * NUM_CELLS;
+    TrainingExample *examples = writer.reserve(maxExamples);
+    int numExamples = 0;
+
+    CellMask misses[2];
+    CellMask hits[2];
+    uint32_t afloat = _shipLengths.size() >= 32 ? UINT32_MAX : (1u << _shipLengths.size()) - 1;
+    uint32_t shipsAfloat[2] = {afloat, afloat};
+    int shots[2] = {0, 0};
+    int winner = -1;
+
+    // Same loop as playGame (see Simulation.h), noting down each move
+    for(int turn = 0; winner < 0 && numExamples < maxExamples; turn = !turn) {
+        pair<int, int> move = players[turn]->getMove();
+
+        // A player that doesn't give a move forfeits
+        if(move.first < 0 || move.first >= Board::GRID_SIZE || move.second < 0 || move.second >= Board::GRID_SIZE) {
+            winner = !turn;
+            break;
+        }
+
+        TrainingExample &example = examples[numExamples++];
+        memset(&example, 0, sizeof(TrainingExample));
+
+        packCells(misses[turn], example.misses);
+        packCells(hits[turn], example.hits);
+
+        if(computers[turn]) {
+            const vector<vector<int>> &density = computers[turn]->getLastDensity();
+
+            int largest = 0;
+            for(int x = 0; x < Board::GRID_SIZE; x++) {
+                for(int y = 0; y < Board::GRID_SIZE; y++) {
+                    largest = max(largest, density.at(x).at(y));
+                }
+            }
+
+            if(largest > 0) {
+                for(int x = 0; x < Board::GRID_SIZE; x++) {
+                    for(int y = 0; y < Board::GRID_SIZE; y++) {
+                        example.density[cellIndex(x, y)] = (uint64_t) max(density.at(x).at(y), 0) * 65535 / largest;
+                    }
+                }
+            } else {
+                example.flags |= TrainingExample::ENDGAME_MOVE;
+            }
+        } else {
+            example.flags |= TrainingExample::NO_DENSITY;
+        }
+
+        int cell = cellIndex(move.first, move.second);
+
+        example.shipsAfloat = shipsAfloat[turn];
+        example.shotNumber = shots[turn];
+        example.cell = cell;
+        example.player = turn;
+        example.gameId = gameId;
+
+        ShotOutcome outcome = players[!turn]->fireShotAt(move.first, move.second);
+        players[turn]->markShot(move.first, move.second, outcome);
+
+        (outcome.hit ? hits : misses)[turn].set(cell);
+        if(outcome.sunkenIndex >= 0 && outcome.sunkenIndex < 32) {
+            shipsAfloat[turn] &= ~(1u << outcome.sunkenIndex);
+        }
+
+        example.outcome = outcome.sunkenIndex >= 0 ? 2 : outcome.hit;
+        shots[turn]++;
+
+        if(players[!turn]->allShipsSunk()) {
+            players[turn]->reportGameover(true);
+            players[!turn]->reportGameover(false);
+            winner = turn;
+        }
+    }
+
+    // How the game turned out is only known now
+    for(int i = 0; i < numExamples; i++) {
+        examples[i].gameShots = shots[examples[i].player];
+        examples[i].won = examples[i].player == winner;
+    }
+
+    writer.commit(numExamples);
+
+    _numExamples += numExamples;
+    _numGames++;
+}
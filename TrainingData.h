@@ -0,0 +1,141 @@
+/* TrainingData.h
+ *
+ * Author: Colin Siles
+ *
+ * Exports training examples for machine learning from simulated games. Every move of a game becomes an example of
+ * what the shooter knew before the move, how the IntelligentComputer rated each square, the move made, and how it
+ * (and the game) turned out. Examples are fixed size, and are written straight from reused buffers into shard files,
+ * one series of shards for each producer thread, so writing an example doesn't allocate anything. Each producer creates
+ * its two players once, and starts them over for every game (the players may still allocate a little doing that, or
+ * choosing a move, though the computer's density grids are reused)
+ *
+ * Shard file: a 64 byte header, then the examples back to back. Numbers are little-endian
+ *   Header:  "BSTX", u16 version, u16 example size (256), u8 board size, 7 unused bytes, u64 number of examples,
+ *            then unused bytes up to 64. The number of examples is filled in when the shard is finished (until then
+ *            it's 0, and the file size gives it)
+ *
+ * Example (256 bytes, every field at a multiple of its size, so it can be read as a packed C struct or numpy dtype):
+ *   0    u8[16]   Misses so far: bit cellIndex(x, y) (byte index / 8, bit index % 8, lowest first) set for a miss
+ *   16   u8[16]   Hits so far, the same way
+ *   32   u16[100] The IntelligentComputer's density for each cell (cellIndex order), scaled so the largest is 65535.
+ *                 All zeros if the density isn't known (see flags)
+ *   232  u32      Bit i set if the opponent's ship i was still afloat before the move
+ *   236  u16      How many shots the shooter had fired before this one
+ *   238  u16      How many shots the shooter fired in the whole game
+ *   240  u8       The cell fired at (cellIndex)
+ *   241  u8       What the shot did: 0 for a miss, 1 for a hit, 2 for a hit that sank a ship
+ *   242  u8       1 if the shooter went on to win the game
+ *   243  u8       Flags: ENDGAME_MOVE if the endgame solver chose the move, NO_DENSITY if the shooter isn't an
+ *                 IntelligentComputer
+ *   244  u8       Which player fired (0 went first)
+ *   245  u8[3]    Unused
+ *   248  u64      Which game the example came from (every example from a game has the same id, and ids are unique
+ *                 across shards), so training and test sets can be split by game
+*/
+
+#ifndef SFML_TEMPLATE_TRAININGDATA_H
+#define SFML_TEMPLATE_TRAININGDATA_H
+
+#include <atomic>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "PlacementTable.h"
+#include "Player.h"
+
+using namespace std;
+
+struct TrainingExample {
+    uint8_t misses[16];
+    uint8_t hits[16];
+    uint16_t density[NUM_CELLS];
+    uint32_t shipsAfloat;
+    uint16_t shotNumber;
+    uint16_t gameShots;
+    uint8_t cell;
+    uint8_t outcome;
+    uint8_t won;
+    uint8_t flags;
+    uint8_t player;
+    uint8_t unused[3];
+    uint64_t gameId;
+
+    static const uint8_t ENDGAME_MOVE = 1;
+    static const uint8_t NO_DENSITY = 2;
+};
+
+static_assert(sizeof(TrainingExample) == 256, "TrainingExample has to match the documented layout");
+
+// Writes one producer's examples into a series of shards, named "<prefix>_<producer>_<shard>.examples"
+class TrainingShardWriter {
+public:
+    TrainingShardWriter(string prefix, int producer, long examplesPerShard);
+    ~TrainingShardWriter(); // Destructor, which finishes the last shard
+
+    // Returns room for the given number of examples, which are written once they're committed. A game's examples
+    // are reserved all at once, so that they end up in the same shard
+    TrainingExample *reserve(int count);
+    void commit(int count);
+
+    long getNumExamples() const;
+    int getNumShards() const;
+
+    static const uint16_t VERSION = 1;
+    static const int HEADER_SIZE = 64;
+
+    // How many examples are written to the file at a time
+    static const int BUFFER_EXAMPLES = 4096;
+
+private:
+    string _prefix;
+    int _producer;
+    long _examplesPerShard;
+
+    int _fileDescriptor;
+    int _numShards;
+    long _shardExamples;
+    long _numExamples;
+
+    vector<TrainingExample> _buffer;
+    int _buffered;
+
+    void _flush();
+    void _startShard();
+    void _finishShard();
+};
+
+class TrainingDataExporter {
+public:
+    // Games are played between players created from the given PlayerRegistry descriptions, and both sides' moves
+    // are exported
+    TrainingDataExporter(string prefix, string firstPlayer = "intelligent", string secondPlayer = "intelligent",
+                         vector<int> shipLengths = {5, 4, 4, 3, 2});
+
+    // Plays the given number of games on the given number of threads (each one a producer, with its own shards)
+    // Game ids, and the seeds the games are played with, start from firstGameId. Returns false if the players
+    // couldn't be created
+    bool run(long numGames, int numThreads, uint64_t firstGameId = 0, long examplesPerShard = DEFAULT_SHARD_EXAMPLES);
+
+    long getNumExamples() const;
+    long getNumGames() const;
+    int getNumShards() const;
+
+    static const long DEFAULT_SHARD_EXAMPLES = 1 << 20;
+
+private:
+    string _prefix;
+    string _playerDescriptions[2];
+    vector<int> _shipLengths;
+
+    atomic<long> _numExamples;
+    atomic<long> _numGames;
+    atomic<int> _numShards;
+
+    // Plays one game between the producer's two players (started over and seeded from the game id), writing its
+    // examples
+    void _playGame(uint64_t gameId, unique_ptr<Player> players[2], TrainingShardWriter &writer);
+};
+
+#endif //SFML_TEMPLATE_TRAININGDATA_H
@@ -0,0 +1,44 @@
+/* VertexShapes.cpp
+ *
+ * Author: Colin Siles
+ *
+ * Helper functions that add rectangles and circles to a VertexArray of triangles
+*/
+
+#include <cmath>
+
+#include "VertexShapes.h"
+
+static const double PI = acos(-1.0);
+
+void addRectangle(VertexArray &vertices, float xPos, float yPos, float width, float height, Color color) {
+    Vertex topLeft(Vector2f(xPos, yPos), color);
+    Vertex topRight(Vector2f(xPos + width, yPos), color);
+    Vertex bottomRight(Vector2f(xPos + width, yPos + height), color);
+    Vertex bottomLeft(Vector2f(xPos, yPos + height), color);
+
+    vertices.append(topLeft);
+    vertices.append(topRight);
+    vertices.append(bottomRight);
+
+    vertices.append(topLeft);
+    vertices.append(bottomRight);
+    vertices.append(bottomLeft);
+}
+
+// A fan of triangles around the center. The points start at the top, like a CircleShape's do
+void addCircle(VertexArray &vertices, float xPos, float yPos, float radius, int pointCount, Color color) {
+    Vector2f center(xPos + radius, yPos + radius);
+    Vector2f last(center.x, center.y - radius);
+
+    for(int i = 1; i <= pointCount; i++) {
+        float angle = i * 2 * PI / pointCount - PI / 2;
+        Vector2f point(center.x + radius * cos(angle), center.y + radius * sin(angle));
+
+        vertices.append(Vertex(center, color));
+        vertices.append(Vertex(last, color));
+        vertices.append(Vertex(point, color));
+
+        last = point;
+    }
+}
@@ -0,0 +1,21 @@
+/* VertexShapes.h
+ *
+ * Author: Colin Siles
+ *
+ * Helper functions that add rectangles and circles to a VertexArray of triangles, so that the renderers can keep a
+ * whole board or fleet in one array and draw it all at once, rather than drawing a shape at a time
+*/
+
+#ifndef SFML_TEMPLATE_VERTEXSHAPES_H
+#define SFML_TEMPLATE_VERTEXSHAPES_H
+
+#include <SFML/Graphics.hpp>
+using namespace sf;
+
+// Adds a filled rectangle, with its upper left-hand corner at the given position
+void addRectangle(VertexArray &vertices, float xPos, float yPos, float width, float height, Color color);
+
+// Adds a filled circle, placed the same way a CircleShape with the same radius and point count would be
+void addCircle(VertexArray &vertices, float xPos, float yPos, float radius, int pointCount, Color color);
+
+#endif //SFML_TEMPLATE_VERTEXSHAPES_H
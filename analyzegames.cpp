@@ -0,0 +1,148 @@
+/* CSCI 261 Final Project: GUI Battleship (Game Analyzer)
+ *
+ * Author: Colin Siles
+ *
+ * Gathers archived games (from binary or text battlelogs) into a column store (see GameColumns.h), and runs the
+ * built-in queries over it (see GameQueries.h), printing the answers as a table or as CSV
+ *
+ * Usage: analyzegames ingest store_directory games.bsl|battlelog.txt [more...]
+ *        analyzegames wins store_directory [options]
+ *        analyzegames firstmoves store_directory [--shots n] [--limit n] [--player name] [options]
+ *        analyzegames sinkorder store_directory [--player name] [options]
+ *
+ *        Options: --csv (print CSV instead of a table), --threads n (defaults to one for each core)
+*/
+
+#include <chrono>
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+#include <iostream>
+#include <string>
+#include <thread>
+
+#include "BattlelogReader.h"
+#include "BinaryBattlelogReader.h"
+#include "GameColumns.h"
+#include "GameQueries.h"
+
+using namespace std;
+
+static bool isBinaryBattlelog(string filename) {
+    char magic[4] = {};
+    ifstream file(filename, ios::binary);
+    file.read(magic, 4);
+    return file && memcmp(magic, "BSBL", 4) == 0;
+}
+
+static int ingest(int argc, char *argv[]) {
+    GameColumnWriter writer(argv[2]);
+    if(!writer.isOpen()) {
+        return 1;
+    }
+
+    size_t startingGames = writer.getNumGames();
+    chrono::steady_clock::time_point start = chrono::steady_clock::now();
+
+    for(int i = 3; i < argc; i++) {
+        GameRecord record;
+
+        if(isBinaryBattlelog(argv[i])) {
+            BinaryBattlelogReader reader;
+            if(!reader.open(argv[i])) {
+                continue;
+            }
+
+            BinaryGameView game;
+            while(reader.next(game)) {
+                game.toRecord(record);
+                writer.append(record);
+            }
+        } else if(BattlelogReader::read(argv[i], record)) {
+            writer.append(record);
+        } else {
+            fprintf(stderr, "Skipping %s: not a battlelog\n", argv[i]);
+        }
+    }
+
+    writer.flush();
+
+    double seconds = chrono::duration<double>(chrono::steady_clock::now() - start).count();
+    printf("Added %zu games in %.2f s (%zu in the store)\n", writer.getNumGames() - startingGames, seconds,
+           writer.getNumGames());
+
+    return 0;
+}
+
+static int query(string command, int argc, char *argv[]) {
+    bool csv = false;
+    int numThreads = max((int) thread::hardware_concurrency(), 1);
+    int shots = 1;
+    int limit = 10;
+    string player;
+
+    for(int i = 3; i < argc; i++) {
+        string option = argv[i];
+        bool hasValue = i + 1 < argc;
+
+        if(option == "--csv") {
+            csv = true;
+        } else if(option == "--threads" && hasValue) {
+            numThreads = stoi(argv[++i]);
+        } else if(option == "--shots" && hasValue) {
+            shots = stoi(argv[++i]);
+        } else if(option == "--limit" && hasValue) {
+            limit = stoi(argv[++i]);
+        } else if(option == "--player" && hasValue) {
+            player = argv[++i];
+        } else {
+            fprintf(stderr, "Unknown option %s\n", argv[i]);
+            return 1;
+        }
+    }
+
+    GameColumns store;
+    if(!store.open(argv[2])) {
+        fprintf(stderr, "%s has no games\n", argv[2]);
+        return 1;
+    }
+
+    GameQueries queries(store, numThreads);
+    chrono::steady_clock::time_point start = chrono::steady_clock::now();
+
+    QueryTable table = command == "wins" ? queries.shotsToWin()
+                     : command == "firstmoves" ? queries.firstMoves(shots, limit, player)
+                     : queries.sinkOrder(player);
+
+    double seconds = chrono::duration<double>(chrono::steady_clock::now() - start).count();
+
+    if(csv) {
+        table.printCsv(cout);
+    } else {
+        table.print(cout);
+    }
+
+    // Kept off the standard output, so the CSV can be piped straight somewhere else
+    fprintf(stderr, "Scanned %zu games (%zu moves) in %.1f ms on %d threads\n", store.getNumGames(),
+            store.getNumMoves(), seconds * 1000, numThreads);
+
+    return 0;
+}
+
+int main(int argc, char *argv[]) {
+    string command = argc > 1 ? argv[1] : "";
+
+    if(command == "ingest" && argc >= 4) {
+        return ingest(argc, argv);
+    } else if((command == "wins" || command == "firstmoves" || command == "sinkorder") && argc >= 3) {
+        return query(command, argc, argv);
+    }
+
+    fprintf(stderr, "Usage: analyzegames ingest store_directory games.bsl|battlelog.txt [more...]\n"
+                    "       analyzegames wins store_directory [options]\n"
+                    "       analyzegames firstmoves store_directory [--shots n] [--limit n] [--player name] "
+                    "[options]\n"
+                    "       analyzegames sinkorder store_directory [--player name] [options]\n"
+                    "       Options: --csv, --threads n\n");
+    return 1;
+}
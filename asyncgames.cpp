@@ -0,0 +1,155 @@
+/* CSCI 261 Final Project: GUI Battleship (Asynchronous Games Demo)
+ *
+ * Author: Colin Siles
+ *
+ * Runs many games at once on a couple of threads, with Game::runGameAsync and a Scheduler. In every game, a
+ * RemotePlayer plays a RandomComputerPlayer. The remote players' moves all come from a single "network" thread, which
+ * answers their move requests after a delay, the way a remote client would. While the games wait on it, they use no
+ * thread at all, so the number of games isn't limited by the number of threads
+ *
+ * Every game publishes its events to one shared GameEventBus, with a GameStats subscriber totalling them up, and
+ * optionally a BinaryBattlelogWriter recording them (each game is seeded with its number, so it can be replayed)
+ *
+ * Usage: asyncgames [games] [scheduler threads] [reply delay (ms)] [binary battlelog]
+*/
+
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <random>
+#include <thread>
+#include <vector>
+
+#include <sys/resource.h>
+
+#include "BinaryBattlelogWriter.h"
+#include "Game.h"
+#include "GameEventBus.h"
+#include "GameStats.h"
+#include "RandomComputerPlayer.h"
+#include "RemotePlayer.h"
+#include "Scheduler.h"
+
+using namespace std;
+
+typedef Game<RemotePlayer, RandomComputerPlayer> RemoteGame;
+
+// Peak memory use of the process, in kilobytes
+long peakMemory() {
+    struct rusage usage;
+    getrusage(RUSAGE_SELF, &usage);
+
+    return usage.ru_maxrss;
+}
+
+int main(int argc, char *argv[]) {
+    int numGames = argc > 1 ? atoi(argv[1]) : 10000;
+    int numThreads = argc > 2 ? atoi(argv[2]) : 2;
+    double delay = argc > 3 ? atof(argv[3]) : 5;
+    string battlelogName = argc > 4 ? argv[4] : "";
+
+    long baseMemory = peakMemory();
+
+    // Move requests from the remote players, waiting to be answered, with the time each one can be answered at
+    deque<pair<chrono::steady_clock::time_point, RemotePlayer *>> requests;
+    mutex requestMutex;
+
+    // The subscribers are declared before the bus, and the bus before the scheduler, so that each is gone before
+    // anything it depends on
+    GameStats stats;
+    unique_ptr<BinaryBattlelogWriter> battlelog;
+    GameEventBus eventBus;
+    eventBus.subscribe(&stats);
+
+    if(!battlelogName.empty()) {
+        battlelog = make_unique<BinaryBattlelogWriter>(battlelogName);
+        // Thousands of games finish every second, so writing them out once a second is plenty
+        FlushPolicy flushPolicy;
+        flushPolicy.mode = FLUSH_ON_TIMER;
+        eventBus.subscribe(battlelog.get(), flushPolicy);
+    }
+
+    Scheduler scheduler(numThreads);
+
+    vector<unique_ptr<RemoteGame>> games;
+    for(int i = 0; i < numGames; i++) {
+        // No battlelog, since there would be thousands of them
+        games.push_back(make_unique<RemoteGame>("Remote", "Random", vector<int>{5, 4, 4, 3, 2}, ""));
+        games.back()->setEventBus(&eventBus, i);
+        games.back()->setSeed(i + 1);
+
+        RemotePlayer &remote = games.back()->getPlayerOne();
+        remote.setScheduler(&scheduler);
+        remote.setMoveRequestCallback([&, delay](RemotePlayer &player) {
+            lock_guard<mutex> lock(requestMutex);
+            requests.push_back(make_pair(chrono::steady_clock::now() + chrono::microseconds((long) (delay * 1000)),
+                                         &player));
+        });
+    }
+
+    chrono::steady_clock::time_point start = chrono::steady_clock::now();
+
+    for(int i = 0; i < numGames; i++) {
+        scheduler.spawn(games.at(i)->runGameAsync());
+    }
+
+    // The "network" thread: answers each request with a random move once its delay has passed
+    bool finished = false;
+    thread network([&]() {
+        mt19937 random(1);
+
+        while(true) {
+            RemotePlayer *player = nullptr;
+
+            {
+                lock_guard<mutex> lock(requestMutex);
+
+                if(finished && requests.empty()) {
+                    return;
+                }
+
+                if(!requests.empty() && requests.front().first <= chrono::steady_clock::now()) {
+                    player = requests.front().second;
+                    requests.pop_front();
+                }
+            }
+
+            if(!player) {
+                this_thread::sleep_for(chrono::microseconds(100));
+                continue;
+            }
+
+            int xPos;
+            int yPos;
+            do {
+                xPos = random() % Board::GRID_SIZE;
+                yPos = random() % Board::GRID_SIZE;
+            } while(!player->validMove(xPos, yPos));
+
+            player->submitMove(xPos, yPos);
+        }
+    });
+
+    scheduler.waitIdle();
+
+    double seconds = chrono::duration<double>(chrono::steady_clock::now() - start).count();
+
+    {
+        lock_guard<mutex> lock(requestMutex);
+        finished = true;
+    }
+    network.join();
+
+    printf("%d games on %d threads in %.2f s (%.0f games/s)\n", numGames, numThreads, seconds, numGames / seconds);
+    eventBus.flush();
+    printf("Events: %ld games, %.1f shots per game, %ld hits, %ld sinks, %.3f ms per move (%ld dropped)\n",
+           stats.getGames(), stats.getAverageShotsPerGame(), stats.getHits(), stats.getSinks(),
+           stats.getAverageThinkTime(), eventBus.numDropped());
+    printf("Peak memory: %.1f MB (%.1f KB per game)\n", peakMemory() / 1024.0,
+           (double) (peakMemory() - baseMemory) / numGames);
+
+    return 0;
+}
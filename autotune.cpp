@@ -0,0 +1,164 @@
+/* CSCI 261 Final Project: GUI Battleship (Parameter Auto-Tuner)
+ *
+ * Author: Colin Siles
+ *
+ * Tunes the IntelligentComputer's parameters (see AIParameters) by self-play: the computer hunts fleets placed the
+ * same way its own placeShips places them, on every core. Random parameter sets are compared with successive halving:
+ * each round every surviving set plays the same games (same fleets, same tie-breaking seeds), the worse half is
+ * dropped, and the rest play twice as many games in the next round. Sets whose average move takes longer than the
+ * time limit are dropped too. The winner is written to the parameter file the game loads at startup
+ *
+ * Usage: autotune [parameter sets] [games in the first round] [move time limit (us)] [output file]
+*/
+
+#include <algorithm>
+#include <cstdio>
+#include <cstdlib>
+#include <random>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "AIParameters.h"
+#include "IntelligentComputer.h"
+#include "RandomComputerPlayer.h"
+#include "Simulation.h"
+
+using namespace std;
+
+// How one parameter set has done so far
+struct Candidate {
+    AIParameters parameters;
+    vector<int> shots;  // Shots taken in each game, in the order of the game seeds
+    long totalShots;
+    double moveTime;    // Total time spent choosing moves (in seconds)
+};
+
+// Draws a random parameter set from the ranges worth exploring
+AIParameters randomParameters(mt19937 &random) {
+    AIParameters parameters;
+
+    parameters.endgameThreshold = random() % 65;
+    parameters.endgameSteps = 500 + random() % 8 * 500;
+    parameters.latticePruning = random() % 2;
+    parameters.informationGain = random() % 2;
+    parameters.entropyCandidates = 1 + random() % 8;
+
+    return parameters;
+}
+
+void printParameters(const AIParameters &parameters) {
+    printf("endgame %2d/%4d  lattice %d  infogain %d/%d", parameters.endgameThreshold, parameters.endgameSteps,
+           parameters.latticePruning, parameters.informationGain, parameters.entropyCandidates);
+}
+
+int main(int argc, char *argv[]) {
+    int numCandidates = argc > 1 ? atoi(argv[1]) : 32;
+    int firstRoundGames = argc > 2 ? atoi(argv[2]) : 100;
+    double moveTimeLimit = argc > 3 ? atof(argv[3]) : 1000;
+    string outputFile = argc > 4 ? argv[4] : AIParameters::DEFAULT_FILE;
+
+    vector<int> shipLengths = {5, 4, 4, 3, 2};
+    int numThreads = max(1, (int) thread::hardware_concurrency());
+
+    mt19937 random(1);
+
+    // Always include the current defaults, so the tuner can't do worse than them
+    vector<Candidate> candidates(numCandidates);
+    for(int i = 0; i < numCandidates; i++) {
+        candidates.at(i).parameters = i == 0 ? AIParameters() : randomParameters(random);
+        candidates.at(i).totalShots = 0;
+        candidates.at(i).moveTime = 0;
+    }
+
+    vector<int> alive;
+    for(int i = 0; i < numCandidates; i++) {
+        alive.push_back(i);
+    }
+
+    for(int games = firstRoundGames; alive.size() > 1; games *= 2) {
+        // Play every surviving set up to the round's number of games: job j is game (j / alive) for set (j % alive)
+        int played = candidates.at(alive.front()).shots.size();
+        int numJobs = (games - played) * alive.size();
+
+        vector<int> shots(numJobs);
+        vector<double> moveTimes(numJobs);
+
+        runJobs(numJobs, numThreads, [&](int job) {
+            int game = played + job / alive.size();
+            Candidate &candidate = candidates.at(alive.at(job % alive.size()));
+
+            // The game number seeds both the fleet and the hunter, so every set faces exactly the same games
+            mt19937 gameRandom(game + 1);
+
+            RandomComputerPlayer target("Target", shipLengths);
+            target.placeShipsAt(randomFleet(shipLengths, gameRandom));
+
+            IntelligentComputer hunter("Hunter", shipLengths);
+            hunter.setParameters(candidate.parameters);
+            hunter.setSeed(gameRandom());
+
+            HuntStats stats = {0, 0.0};
+            shots.at(job) = huntToSink(hunter, target, stats);
+            moveTimes.at(job) = stats.moveTime;
+        });
+
+        for(int job = 0; job < numJobs; job++) {
+            Candidate &candidate = candidates.at(alive.at(job % alive.size()));
+
+            candidate.shots.push_back(shots.at(job));
+            candidate.totalShots += shots.at(job);
+            candidate.moveTime += moveTimes.at(job);
+        }
+
+        // Rank the sets that are fast enough by their average number of shots
+        vector<pair<double, int>> ranked;
+        for(int i = 0; i < alive.size(); i++) {
+            Candidate &candidate = candidates.at(alive.at(i));
+            double averageShots = (double) candidate.totalShots / games;
+            double averageMove = candidate.moveTime * 1e6 / candidate.totalShots;
+
+            if(averageMove <= moveTimeLimit) {
+                ranked.push_back(make_pair(averageShots, alive.at(i)));
+            }
+        }
+
+        sort(ranked.begin(), ranked.end());
+
+        printf("Round with %d games, %d sets:\n", games, (int) alive.size());
+        for(int i = 0; i < ranked.size(); i++) {
+            Candidate &candidate = candidates.at(ranked.at(i).second);
+
+            printf("  %8.3f shots %10.1f us/move  ", ranked.at(i).first,
+                   candidate.moveTime * 1e6 / candidate.totalShots);
+            printParameters(candidate.parameters);
+            printf("\n");
+        }
+
+        // If nothing is fast enough, there's nothing to tune
+        if(ranked.empty()) {
+            fprintf(stderr, "No parameter set is within the move time limit\n");
+            return 1;
+        }
+
+        alive.clear();
+        for(int i = 0; i < (ranked.size() + 1) / 2; i++) {
+            alive.push_back(ranked.at(i).second);
+        }
+    }
+
+    const AIParameters &best = candidates.at(alive.front()).parameters;
+
+    printf("\nBest: ");
+    printParameters(best);
+    printf("\n");
+
+    if(!best.save(outputFile)) {
+        fprintf(stderr, "Failed to write %s\n", outputFile.c_str());
+        return 1;
+    }
+
+    printf("Written to %s\n", outputFile.c_str());
+
+    return 0;
+}
@@ -0,0 +1,71 @@
+/* CSCI 261 Final Project: GUI Battleship (Benchmark)
+ *
+ * Author: Colin Siles
+ *
+ * Measures how many shots the IntelligentComputer needs to sink a randomly placed fleet, and how long it takes to
+ * choose each move, with and without each of its optional strategies. Every configuration plays against the same
+ * fleets (the random number generator is re-seeded before each one is placed), so the numbers can be compared directly
+ *
+ * Usage: benchmark [number of games]
+*/
+
+#include <cstdio>
+#include <cstdlib>
+#include <string>
+#include <vector>
+
+#include "IntelligentComputer.h"
+#include "RandomComputerPlayer.h"
+#include "Simulation.h"
+
+using namespace std;
+
+// The options being compared in each row of the benchmark
+struct BenchmarkConfig {
+    string name;
+    bool latticePruning;
+    int endgameThreshold;
+    bool informationGain;
+};
+
+int main(int argc, char *argv[]) {
+    int numGames = argc > 1 ? atoi(argv[1]) : 1000;
+
+    vector<int> shipLengths = {5, 4, 4, 3, 2};
+
+    vector<BenchmarkConfig> configs = {
+        {"density", false, 0, false},
+        {"density + lattice", true, 0, false},
+        {"density + endgame", false, 32, false},
+        {"density + lattice + endgame", true, 32, false},
+        {"information gain", false, 0, true},
+        {"information gain + endgame", false, 32, true},
+    };
+
+    printf("%-30s %12s %16s\n", "Configuration", "Avg shots", "Avg move (us)");
+
+    for(int i = 0; i < configs.size(); i++) {
+        HuntStats stats = {0, 0.0};
+
+        for(int j = 0; j < numGames; j++) {
+            // Seed the same way for every configuration, so they all face the same fleets
+            srand(j + 1);
+
+            RandomComputerPlayer target("Target", shipLengths);
+            target.placeShips();
+
+            IntelligentComputer hunter("Hunter", shipLengths);
+            hunter.setLatticePruning(configs.at(i).latticePruning);
+            hunter.setEndgameThreshold(configs.at(i).endgameThreshold);
+            hunter.setTargetingMode(configs.at(i).informationGain ? IntelligentComputer::INFORMATION_GAIN :
+                                    IntelligentComputer::DENSITY);
+
+            huntToSink(hunter, target, stats);
+        }
+
+        printf("%-30s %12.3f %16.2f\n", configs.at(i).name.c_str(), (double) stats.shots / numGames,
+               stats.moveTime / stats.shots * 1e6);
+    }
+
+    return 0;
+}
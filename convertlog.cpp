@@ -0,0 +1,128 @@
+/* CSCI 261 Final Project: GUI Battleship (Battlelog Converter)
+ *
+ * Author: Colin Siles
+ *
+ * Converts between text battlelogs (as written by the Battlelog class) and binary ones (see BinaryBattlelogWriter),
+ * and scans binary battlelogs to check them and measure how fast they can be read
+ *
+ * Usage: convertlog tobinary out.bsl battlelog.txt [more battlelogs...]
+ *        convertlog totext in.bsl prefix     (writes prefix_0.txt, prefix_1.txt... one for each game)
+ *        convertlog scan in.bsl [more...]
+*/
+
+#include <chrono>
+#include <cstdio>
+#include <string>
+
+#include "Battlelog.h"
+#include "BattlelogReader.h"
+#include "BinaryBattlelogReader.h"
+#include "BinaryBattlelogWriter.h"
+
+using namespace std;
+
+static int toBinary(int argc, char *argv[]) {
+    BinaryBattlelogWriter writer(argv[2], {});
+    if(!writer.isOpen()) {
+        return 1;
+    }
+
+    int converted = 0;
+    for(int i = 3; i < argc; i++) {
+        GameRecord record;
+
+        if(!BattlelogReader::read(argv[i], record)) {
+            fprintf(stderr, "Skipping %s: not a battlelog\n", argv[i]);
+            continue;
+        }
+
+        writer.append(record);
+        converted++;
+    }
+
+    printf("Converted %d battlelogs\n", converted);
+    return 0;
+}
+
+static int toText(char *argv[]) {
+    BinaryBattlelogReader reader;
+    if(!reader.open(argv[2])) {
+        return 1;
+    }
+
+    BinaryGameView game;
+    int converted = 0;
+
+    while(reader.next(game)) {
+        string names[2] = {string(game.getPlayerName(0)), string(game.getPlayerName(1))};
+        Battlelog battlelog(string(argv[3]) + "_" + to_string(converted) + ".txt", names[0], names[1]);
+
+        // The text battlelog only says whether a ship was sunk, not which one
+        RecordedMove move;
+        while(game.nextMove(move)) {
+            battlelog.recordMove(move.xPos, move.yPos, {move.hit, move.sunk ? max(move.sunkenIndex, 0) : -1});
+        }
+
+        if(game.getWinner() >= 0) {
+            battlelog.recordWinner(names[game.getWinner()]);
+        }
+
+        converted++;
+    }
+
+    printf("Wrote %d battlelogs\n", converted);
+    return 0;
+}
+
+static int scan(int argc, char *argv[]) {
+    long games = 0;
+    long moves = 0;
+    long hits = 0;
+    long finished = 0;
+
+    chrono::steady_clock::time_point start = chrono::steady_clock::now();
+
+    for(int i = 2; i < argc; i++) {
+        BinaryBattlelogReader reader;
+        if(!reader.open(argv[i])) {
+            continue;
+        }
+
+        BinaryGameView game;
+        while(reader.next(game)) {
+            games++;
+            finished += game.getWinner() >= 0;
+
+            RecordedMove move;
+            while(game.nextMove(move)) {
+                moves++;
+                hits += move.hit;
+            }
+        }
+    }
+
+    double seconds = chrono::duration<double>(chrono::steady_clock::now() - start).count();
+
+    printf("%ld games (%ld finished), %ld moves, %ld hits\n", games, finished, moves, hits);
+    printf("Read in %.3f s (%.2f million games/s, %.0f million moves/s)\n", seconds, games / seconds / 1e6,
+           moves / seconds / 1e6);
+
+    return 0;
+}
+
+int main(int argc, char *argv[]) {
+    string command = argc > 1 ? argv[1] : "";
+
+    if(command == "tobinary" && argc >= 4) {
+        return toBinary(argc, argv);
+    } else if(command == "totext" && argc == 4) {
+        return toText(argv);
+    } else if(command == "scan" && argc >= 3) {
+        return scan(argc, argv);
+    }
+
+    fprintf(stderr, "Usage: convertlog tobinary out.bsl battlelog.txt [more battlelogs...]\n"
+                    "       convertlog totext in.bsl prefix\n"
+                    "       convertlog scan in.bsl [more...]\n");
+    return 1;
+}
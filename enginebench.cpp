@@ -0,0 +1,87 @@
+/* CSCI 261 Final Project: GUI Battleship (Engine Benchmark)
+ *
+ * Author: Colin Siles
+ *
+ * Measures the cost of playing through an ExternalEnginePlayer: plays games between an engine and a
+ * RandomComputerPlayer, then the same number of games with the engine's side played in-process, and compares the time
+ * per move and games per second. With a trivial engine (like exampleengine), the difference is the cost of the IPC
+ *
+ * Usage: enginebench [games] [engine command]
+ * e.g.   enginebench 1000 ./exampleengine
+*/
+
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <string>
+#include <vector>
+
+#include "ExternalEnginePlayer.h"
+#include "RandomComputerPlayer.h"
+#include "Simulation.h"
+
+using namespace std;
+
+int main(int argc, char *argv[]) {
+    int numGames = argc > 1 ? atoi(argv[1]) : 1000;
+    string command = argc > 2 ? argv[2] : "./exampleengine";
+
+    vector<int> shipLengths = {5, 4, 4, 3, 2};
+
+    // Through the engine
+    long requests = 0;
+    long moves = 0;
+    double roundTrips = 0;
+    double startTime = 0;
+    int wins = 0;
+
+    chrono::steady_clock::time_point start = chrono::steady_clock::now();
+
+    for(int i = 0; i < numGames; i++) {
+        chrono::steady_clock::time_point created = chrono::steady_clock::now();
+
+        ExternalEnginePlayer engine("Engine", shipLengths, command);
+        RandomComputerPlayer opponent("Random", shipLengths);
+
+        startTime += chrono::duration<double, milli>(chrono::steady_clock::now() - created).count();
+
+        if(!engine.isRunning()) {
+            fprintf(stderr, "Failed to start %s\n", command.c_str());
+            return 1;
+        }
+
+        int shots;
+        wins += playGame(engine, opponent, shots) == 0;
+
+        requests += engine.getRequests();
+        roundTrips += engine.getAverageRoundTrip() * engine.getRequests();
+        moves += engine.getRequests() - 1;
+    }
+
+    double engineSeconds = chrono::duration<double>(chrono::steady_clock::now() - start).count();
+
+    // The same games, in-process
+    start = chrono::steady_clock::now();
+
+    for(int i = 0; i < numGames; i++) {
+        RandomComputerPlayer local("Local", shipLengths);
+        RandomComputerPlayer opponent("Random", shipLengths);
+
+        int shots;
+        playGame(local, opponent, shots);
+    }
+
+    double localSeconds = chrono::duration<double>(chrono::steady_clock::now() - start).count();
+
+    printf("Engine: %d games in %.2f s (%.0f games/s), won %.1f%%\n", numGames, engineSeconds, numGames / engineSeconds,
+           100.0 * wins / numGames);
+    printf("        %.1f us per request (%ld requests, %ld moves), %.2f ms to start the engine\n",
+           1000 * roundTrips / requests, requests, moves, startTime / numGames);
+    printf("Local:  %d games in %.2f s (%.0f games/s)\n", numGames, localSeconds, numGames / localSeconds);
+
+    // Everything the engine's games took that the local ones didn't, apart from starting the engine
+    printf("Overhead: %.1f us per engine move\n",
+           (1e6 * (engineSeconds - localSeconds) - 1000 * startTime) / moves);
+
+    return 0;
+}
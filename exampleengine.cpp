@@ -0,0 +1,141 @@
+/* CSCI 261 Final Project: GUI Battleship (Example Engine)
+ *
+ * Author: Colin Siles
+ *
+ * A small engine for the ExternalEnginePlayer's protocol (see ExternalEnginePlayer.h), to show what an engine looks
+ * like and to measure the cost of talking to one. It places its ships randomly, fires randomly until it hits something,
+ * then fires around its hits until they're sunk. It doesn't use any of the game's code, so it builds on its own:
+ *
+ *     g++ -std=c++17 -O2 exampleengine.cpp -o exampleengine
+ *
+ * Usage: exampleengine [seed]
+*/
+
+#include <cstdio>
+#include <cstdlib>
+#include <iostream>
+#include <random>
+#include <sstream>
+#include <string>
+#include <vector>
+
+using namespace std;
+
+static const int GRID_SIZE = 10;
+
+int main(int argc, char *argv[]) {
+    mt19937 random(argc > 1 ? atoi(argv[1]) : random_device()());
+
+    vector<int> shipLengths;
+
+    // What's known about each of the opponent's cells: 0 untried, 1 miss, 2 hit (on a ship that isn't sunk yet)
+    vector<vector<int>> cells(GRID_SIZE, vector<int>(GRID_SIZE, 0));
+
+    string line;
+    while(getline(cin, line)) {
+        stringstream words(line);
+        string command;
+        words >> command;
+
+        if(command == "ships") {
+            int length;
+            while(words >> length) {
+                shipLengths.push_back(length);
+            }
+        } else if(command == "place") {
+            vector<vector<bool>> occupied(GRID_SIZE, vector<bool>(GRID_SIZE, false));
+            string reply = "placement";
+
+            for(int length : shipLengths) {
+                while(true) {
+                    bool vertical = random() % 2;
+                    int xPos = random() % GRID_SIZE;
+                    int yPos = random() % GRID_SIZE;
+
+                    // Horizontal ships run along xPos, vertical ones along yPos
+                    bool fits = true;
+                    for(int i = 0; i < length && fits; i++) {
+                        int x = vertical ? xPos : xPos + i;
+                        int y = vertical ? yPos + i : yPos;
+
+                        fits = x < GRID_SIZE && y < GRID_SIZE && !occupied[x][y];
+                    }
+
+                    if(!fits) {
+                        continue;
+                    }
+
+                    for(int i = 0; i < length; i++) {
+                        occupied[vertical ? xPos : xPos + i][vertical ? yPos + i : yPos] = true;
+                    }
+
+                    reply += " " + to_string(xPos) + " " + to_string(yPos) + (vertical ? " v" : " h");
+                    break;
+                }
+            }
+
+            cout << reply << endl;
+        } else if(command == "move") {
+            // Untried cells next to a hit come first
+            vector<pair<int, int>> targets;
+            vector<pair<int, int>> untried;
+
+            for(int x = 0; x < GRID_SIZE; x++) {
+                for(int y = 0; y < GRID_SIZE; y++) {
+                    if(cells[x][y] != 0) {
+                        continue;
+                    }
+
+                    untried.push_back(make_pair(x, y));
+
+                    bool nextToHit = (x > 0 && cells[x - 1][y] == 2) || (x < GRID_SIZE - 1 && cells[x + 1][y] == 2) ||
+                                     (y > 0 && cells[x][y - 1] == 2) || (y < GRID_SIZE - 1 && cells[x][y + 1] == 2);
+                    if(nextToHit) {
+                        targets.push_back(make_pair(x, y));
+                    }
+                }
+            }
+
+            vector<pair<int, int>> &choices = targets.empty() ? untried : targets;
+            pair<int, int> shot = choices.at(random() % choices.size());
+
+            cout << "shot " << shot.first << " " << shot.second << endl;
+        } else if(command == "outcome") {
+            int xPos;
+            int yPos;
+            string result;
+            words >> xPos >> yPos >> result;
+
+            cells[xPos][yPos] = result == "miss" ? 1 : 2;
+
+            // Without knowing where the sunken ship was, just stop targeting the hits around the sinking shot
+            if(result == "sunk") {
+                vector<pair<int, int>> around = {make_pair(xPos, yPos)};
+
+                while(!around.empty()) {
+                    pair<int, int> cell = around.back();
+                    around.pop_back();
+
+                    if(cell.first < 0 || cell.second < 0 || cell.first >= GRID_SIZE || cell.second >= GRID_SIZE ||
+                       cells[cell.first][cell.second] != 2) {
+                        continue;
+                    }
+
+                    cells[cell.first][cell.second] = 3;
+                    around.push_back(make_pair(cell.first + 1, cell.second));
+                    around.push_back(make_pair(cell.first - 1, cell.second));
+                    around.push_back(make_pair(cell.first, cell.second + 1));
+                    around.push_back(make_pair(cell.first, cell.second - 1));
+                }
+            }
+        } else if(command == "newgame") {
+            cells.assign(GRID_SIZE, vector<int>(GRID_SIZE, 0));
+        } else if(command == "quit") {
+            break;
+        }
+
+        // Anything else (opponent, incoming, gameover) doesn't need an answer
+    }
+
+    return 0;
+}
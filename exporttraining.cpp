@@ -0,0 +1,46 @@
+/* CSCI 261 Final Project: GUI Battleship (Training Data Exporter)
+ *
+ * Author: Colin Siles
+ *
+ * Plays games between computer players, and exports every move as a training example for machine learning, in
+ * shards written by parallel producers (see TrainingData.h for the layout). Players are given as PlayerRegistry
+ * descriptions, e.g. "intelligent:informationGain=0"
+ *
+ * Usage: exporttraining out_prefix [games] [threads] [first player] [second player] [first game id]
+*/
+
+#include <chrono>
+#include <cstdio>
+#include <string>
+#include <thread>
+
+#include "TrainingData.h"
+
+using namespace std;
+
+int main(int argc, char *argv[]) {
+    if(argc < 2) {
+        fprintf(stderr, "Usage: exporttraining out_prefix [games] [threads] [first player] [second player] "
+                        "[first game id]\n");
+        return 1;
+    }
+
+    long numGames = argc > 2 ? stol(argv[2]) : 10000;
+    int numThreads = argc > 3 ? stoi(argv[3]) : max((int) thread::hardware_concurrency(), 1);
+    string firstPlayer = argc > 4 ? argv[4] : "intelligent";
+    string secondPlayer = argc > 5 ? argv[5] : "intelligent";
+    uint64_t firstGameId = argc > 6 ? stoull(argv[6]) : 0;
+
+    TrainingDataExporter exporter(argv[1], firstPlayer, secondPlayer);
+
+    chrono::steady_clock::time_point start = chrono::steady_clock::now();
+    bool succeeded = exporter.run(numGames, numThreads, firstGameId);
+    double seconds = chrono::duration<double>(chrono::steady_clock::now() - start).count();
+
+    printf("%ld games, %ld examples in %d shards (%.1f MB)\n", exporter.getNumGames(), exporter.getNumExamples(),
+           exporter.getNumShards(), exporter.getNumExamples() * sizeof(TrainingExample) / 1e6);
+    printf("%.2f s on %d threads: %.2f million examples per minute\n", seconds, numThreads,
+           exporter.getNumExamples() / seconds * 60 / 1e6);
+
+    return succeeded ? 0 : 1;
+}
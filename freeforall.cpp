@@ -0,0 +1,136 @@
+/* CSCI 261 Final Project: GUI Battleship (Free-For-All)
+ *
+ * Author: Colin Siles
+ *
+ * Plays free-for-all matches (see FreeForAll.h) between any number of players from the PlayerRegistry, on every core,
+ * and prints how often each seat won, where it finished on average, and how many matches and shots were played each
+ * second. Each match is seeded with its number, so the same matches are played every time
+ *
+ * Usage: freeforall [--matches n] player player...
+ * e.g.   freeforall --matches 1000 intelligent intelligent intelligent intelligent random random random random
+*/
+
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <memory>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "FreeForAll.h"
+#include "PlayerRegistry.h"
+#include "Simulation.h"
+
+using namespace std;
+
+// Matches played one after another by a thread, reusing the same FreeForAll
+static const int MATCHES_PER_JOB = 10;
+
+int main(int argc, char *argv[]) {
+    int numMatches = 1000;
+    vector<string> descriptions;
+
+    for(int i = 1; i < argc; i++) {
+        string argument = argv[i];
+
+        if(argument == "--matches" && i + 1 < argc) {
+            numMatches = max(1, atoi(argv[++i]));
+        } else {
+            descriptions.push_back(argument);
+        }
+    }
+
+    vector<int> shipLengths = {5, 4, 4, 3, 2};
+    int numPlayers = descriptions.size();
+
+    if(numPlayers < 2) {
+        fprintf(stderr, "Usage: freeforall [--matches n] player player...\n");
+        fprintf(stderr, "Player types:");
+        for(string type : PlayerRegistry::types()) {
+            fprintf(stderr, " %s", type.c_str());
+        }
+        fprintf(stderr, "\n");
+        return 1;
+    }
+
+    // Make sure every player can be created before playing anything
+    for(int i = 0; i < numPlayers; i++) {
+        unique_ptr<Player> player(PlayerRegistry::create(descriptions.at(i), descriptions.at(i), shipLengths));
+        if(!player) {
+            return 1;
+        }
+    }
+
+    // Each match's finishing order (winner first), and the turns and shots it took
+    vector<int> finishes(numMatches * numPlayers, -1);
+    vector<int> turns(numMatches, 0);
+    vector<long> shots(numMatches, 0);
+
+    int numJobs = (numMatches + MATCHES_PER_JOB - 1) / MATCHES_PER_JOB;
+    int numThreads = max(1, (int) thread::hardware_concurrency());
+
+    chrono::steady_clock::time_point start = chrono::steady_clock::now();
+
+    runJobs(numJobs, numThreads, [&](int job) {
+        FreeForAll match(descriptions, shipLengths);
+
+        for(int game = job * MATCHES_PER_JOB; game < min((job + 1) * MATCHES_PER_JOB, numMatches); game++) {
+            if(!match.reset(game)) {
+                continue;
+            }
+
+            finishes.at(game * numPlayers) = match.run();
+
+            const vector<int> &eliminated = match.getEliminated();
+            for(int i = 0; i < eliminated.size(); i++) {
+                finishes.at(game * numPlayers + numPlayers - 1 - i) = eliminated.at(i);
+            }
+
+            turns.at(game) = match.getTurns();
+            for(int seat = 0; seat < numPlayers; seat++) {
+                shots.at(game) += match.getShots(seat);
+            }
+        }
+    });
+
+    double seconds = chrono::duration<double>(chrono::steady_clock::now() - start).count();
+
+    vector<int> wins(numPlayers, 0);
+    vector<double> placeTotals(numPlayers, 0.0);
+    double totalTurns = 0;
+    double totalShots = 0;
+    int played = 0;
+
+    for(int game = 0; game < numMatches; game++) {
+        if(finishes.at(game * numPlayers) < 0) {
+            continue;
+        }
+
+        played++;
+        wins.at(finishes.at(game * numPlayers))++;
+
+        for(int place = 0; place < numPlayers; place++) {
+            placeTotals.at(finishes.at(game * numPlayers + place)) += place + 1;
+        }
+
+        totalTurns += turns.at(game);
+        totalShots += shots.at(game);
+    }
+
+    if(played == 0) {
+        fprintf(stderr, "No matches were played\n");
+        return 1;
+    }
+
+    printf("%-6s %-50s %8s %12s\n", "Seat", "Player", "Wins", "Avg place");
+    for(int seat = 0; seat < numPlayers; seat++) {
+        printf("%-6d %-50s %7.1f%% %12.2f\n", seat + 1, descriptions.at(seat).c_str(), 100.0 * wins.at(seat) / played,
+               placeTotals.at(seat) / played);
+    }
+
+    printf("\n%d matches of %d players on %d threads in %.2f s: %.1f turns per match, %.0f matches/s, %.0f shots/s\n",
+           played, numPlayers, numThreads, seconds, totalTurns / played, played / seconds, totalShots / seconds);
+
+    return 0;
+}
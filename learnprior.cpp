@@ -0,0 +1,67 @@
+/* CSCI 261 Final Project: GUI Battleship (Placement Prior Learner)
+ *
+ * Author: Colin Siles
+ *
+ * Goes through old battlelogs, and adds every fleet that was completely sunk to the placement model of the player it
+ * belonged to (see PlacementPrior). An IntelligentComputer with placement learning on (as in the main game) picks up
+ * those models the next time it plays that player
+ *
+ * Usage: learnprior battlelog.txt [more battlelogs...]
+*/
+
+#include <iostream>
+#include <map>
+
+#include "BattlelogReader.h"
+#include "PlacementPrior.h"
+
+using namespace std;
+
+int main(int argc, char *argv[]) {
+    if(argc < 2) {
+        cerr << "Usage: learnprior battlelog.txt [more battlelogs...]" << endl;
+        return 1;
+    }
+
+    // Number of fleets learned for each player
+    map<string, int> learned;
+
+    for(int i = 1; i < argc; i++) {
+        GameRecord record;
+
+        if(!BattlelogReader::read(argv[i], record)) {
+            cerr << "Skipping " << argv[i] << ": not a battlelog" << endl;
+            continue;
+        }
+
+        // Only games that finished tell us where all of the loser's ships were
+        if(record.winner < 0) {
+            continue;
+        }
+
+        int loser = !record.winner;
+
+        // Every hit the winner made was on one of the loser's ships
+        CellMask shipCells;
+        for(int j = 0; j < record.moves.size(); j++) {
+            const RecordedMove &move = record.moves.at(j);
+
+            if(move.player == record.winner && move.hit) {
+                shipCells.set(cellIndex(move.xPos, move.yPos));
+            }
+        }
+
+        PlacementPrior prior;
+        if(prior.open(PlacementPrior::filenameFor(record.playerNames.at(loser)))) {
+            prior.recordFleet(shipCells);
+            learned[record.playerNames.at(loser)]++;
+        }
+    }
+
+    for(auto &entry : learned) {
+        cout << entry.first << ": learned " << entry.second << " fleet(s), written to "
+             << PlacementPrior::filenameFor(entry.first) << endl;
+    }
+
+    return 0;
+}
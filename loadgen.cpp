@@ -0,0 +1,263 @@
+/* CSCI 261 Final Project: GUI Battleship (Load Generator)
+ *
+ * Author: Colin Siles
+ *
+ * Puts a MatchServer under load: opens many connections at once, and plays games on all of them back to back (firing
+ * randomly), all from one thread with epoll. Prints the games per second, and the latency of each move: from sending
+ * it to hearing its outcome, and to being asked for the next one (which includes the server's computer taking its turn)
+ *
+ * With --forfeits n, every nth game is forfeited with a move off the board, to check that the server still reports
+ * those games over (as losses) rather than leaving the client waiting
+ *
+ * Usage: loadgen [--port n | --unix path] [--connections n] [--games n] [--opponent random|intelligent] [--forfeits n]
+ * e.g.   loadgen --unix /tmp/battleship.sock --connections 2000 --games 20000
+*/
+
+#include <algorithm>
+#include <bitset>
+#include <cerrno>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <random>
+#include <string>
+#include <vector>
+
+#include <arpa/inet.h>
+#include <netinet/in.h>
+#include <netinet/tcp.h>
+#include <sys/epoll.h>
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <unistd.h>
+
+#include "MatchProtocol.h"
+
+using namespace std;
+
+typedef chrono::steady_clock Clock;
+
+// One of the load generator's connections, and the game it's playing
+struct Client {
+    int socket;
+    uint8_t partial[sizeof(MatchMessage)];
+    int partialSize;
+
+    bitset<Board::GRID_SIZE * Board::GRID_SIZE> fired;
+    Clock::time_point moveSent;
+    bool waitingForOutcome;
+    bool forfeiting; // Whether the client forfeits this game
+};
+
+static int connectTo(int port, string unixPath) {
+    int connected;
+    int client;
+
+    if(unixPath.empty()) {
+        struct sockaddr_in address = {};
+        address.sin_family = AF_INET;
+        address.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+        address.sin_port = htons(port);
+
+        client = socket(AF_INET, SOCK_STREAM | SOCK_CLOEXEC, 0);
+        connected = connect(client, (struct sockaddr *) &address, sizeof(address));
+
+        int noDelay = 1;
+        setsockopt(client, IPPROTO_TCP, TCP_NODELAY, &noDelay, sizeof(noDelay));
+    } else {
+        struct sockaddr_un address = {};
+        address.sun_family = AF_UNIX;
+        strncpy(address.sun_path, unixPath.c_str(), sizeof(address.sun_path) - 1);
+
+        client = socket(AF_UNIX, SOCK_STREAM | SOCK_CLOEXEC, 0);
+        connected = connect(client, (struct sockaddr *) &address, sizeof(address));
+    }
+
+    if(connected != 0) {
+        close(client);
+        return -1;
+    }
+
+    return client;
+}
+
+static void sendMessage(Client &client, MatchMessage message) {
+    send(client.socket, &message, sizeof(message), MSG_NOSIGNAL);
+}
+
+// The value below which the given fraction of the (sorted) latencies fall
+static double percentile(const vector<float> &sorted, double fraction) {
+    if(sorted.empty()) {
+        return 0;
+    }
+
+    return sorted.at(min((size_t) (fraction * sorted.size()), sorted.size() - 1));
+}
+
+int main(int argc, char *argv[]) {
+    int port = 7777;
+    string unixPath;
+    int numConnections = 100;
+    long numGames = 10000;
+    uint8_t opponent = MATCH_RANDOM_OPPONENT;
+    long forfeitEvery = 0;
+
+    for(int i = 1; i + 1 < argc; i += 2) {
+        string option = argv[i];
+
+        if(option == "--port") {
+            port = atoi(argv[i + 1]);
+        } else if(option == "--unix") {
+            unixPath = argv[i + 1];
+        } else if(option == "--connections") {
+            numConnections = atoi(argv[i + 1]);
+        } else if(option == "--games") {
+            numGames = atol(argv[i + 1]);
+        } else if(option == "--opponent") {
+            opponent = string(argv[i + 1]) == "intelligent" ? MATCH_INTELLIGENT_OPPONENT : MATCH_RANDOM_OPPONENT;
+        } else if(option == "--forfeits") {
+            forfeitEvery = atol(argv[i + 1]);
+        } else {
+            fprintf(stderr, "Usage: loadgen [--port n | --unix path] [--connections n] [--games n] "
+                            "[--opponent random|intelligent] [--forfeits n]\n");
+            return 1;
+        }
+    }
+
+    int epoll = epoll_create1(EPOLL_CLOEXEC);
+    vector<Client> clients(numConnections);
+    mt19937 random(1);
+
+    // Latencies in milliseconds, until the move's outcome, and until the next move is asked for
+    vector<float> outcomeLatencies;
+    vector<float> turnLatencies;
+
+    long started = 0;
+    long finished = 0;
+    long won = 0;
+    long forfeited = 0;
+    int open = 0;
+
+    Clock::time_point start = Clock::now();
+
+    for(int i = 0; i < numConnections; i++) {
+        Client &client = clients.at(i);
+        client.socket = connectTo(port, unixPath);
+
+        if(client.socket < 0) {
+            fprintf(stderr, "Failed to connect (%d connections made)\n", i);
+            return 1;
+        }
+
+        client.partialSize = 0;
+        client.waitingForOutcome = false;
+        open++;
+
+        epoll_event event = {};
+        event.events = EPOLLIN;
+        event.data.u32 = i;
+        epoll_ctl(epoll, EPOLL_CTL_ADD, client.socket, &event);
+
+        // Start the first game, if there are games left to play
+        if(started < numGames) {
+            started++;
+            client.forfeiting = forfeitEvery > 0 && started % forfeitEvery == 0;
+            sendMessage(client, {MATCH_START, {opponent, 0, 0}});
+        }
+    }
+
+    epoll_event events[256];
+    while(finished < numGames) {
+        int numEvents = epoll_wait(epoll, events, 256, -1);
+
+        for(int i = 0; i < numEvents; i++) {
+            Client &client = clients.at(events[i].data.u32);
+
+            uint8_t buffer[4096];
+            ssize_t result = recv(client.socket, buffer, sizeof(buffer), MSG_DONTWAIT);
+
+            if(result == 0 || (result < 0 && errno != EAGAIN && errno != EINTR)) {
+                fprintf(stderr, "The server closed a connection\n");
+                return 1;
+            }
+
+            for(int j = 0; j < result; j++) {
+                client.partial[client.partialSize++] = buffer[j];
+
+                if(client.partialSize < sizeof(MatchMessage)) {
+                    continue;
+                }
+
+                MatchMessage message;
+                memcpy(&message, client.partial, sizeof(message));
+                client.partialSize = 0;
+
+                Clock::time_point now = Clock::now();
+
+                if(message.type == MATCH_OUTCOME && client.waitingForOutcome) {
+                    outcomeLatencies.push_back(chrono::duration<float, milli>(now - client.moveSent).count());
+                    client.waitingForOutcome = false;
+                } else if(message.type == MATCH_MOVE_REQUEST && client.forfeiting) {
+                    sendMessage(client, {MATCH_MOVE, {0xFF, 0xFF, 0}});
+                } else if(message.type == MATCH_MOVE_REQUEST) {
+                    // The first request of a game doesn't follow a move
+                    if(client.fired.any()) {
+                        turnLatencies.push_back(chrono::duration<float, milli>(now - client.moveSent).count());
+                    }
+
+                    int cell;
+                    do {
+                        cell = random() % client.fired.size();
+                    } while(client.fired.test(cell));
+
+                    client.fired.set(cell);
+                    client.moveSent = now;
+                    client.waitingForOutcome = true;
+
+                    sendMessage(client, {MATCH_MOVE, {(uint8_t) (cell / Board::GRID_SIZE),
+                                                      (uint8_t) (cell % Board::GRID_SIZE), 0}});
+                } else if(message.type == MATCH_GAME_OVER) {
+                    if(client.forfeiting && message.args[0]) {
+                        fprintf(stderr, "A forfeited game was reported as won\n");
+                        return 1;
+                    }
+
+                    finished++;
+                    won += message.args[0];
+                    forfeited += client.forfeiting;
+                    client.fired.reset();
+                    client.waitingForOutcome = false;
+
+                    if(started < numGames) {
+                        started++;
+                        client.forfeiting = forfeitEvery > 0 && started % forfeitEvery == 0;
+                        sendMessage(client, {MATCH_START, {opponent, 0, 0}});
+                    }
+                }
+            }
+        }
+    }
+
+    double seconds = chrono::duration<double>(Clock::now() - start).count();
+
+    for(int i = 0; i < clients.size(); i++) {
+        close(clients.at(i).socket);
+    }
+    close(epoll);
+
+    sort(outcomeLatencies.begin(), outcomeLatencies.end());
+    sort(turnLatencies.begin(), turnLatencies.end());
+
+    printf("%ld games on %d connections in %.2f s (%.0f games/s), won %.1f%%\n", finished, open, seconds,
+           finished / seconds, 100.0 * won / finished);
+    if(forfeitEvery > 0) {
+        printf("Forfeited %ld games, all reported over\n", forfeited);
+    }
+    printf("Move to outcome:      p50 %.3f ms, p99 %.3f ms (%zu moves)\n", percentile(outcomeLatencies, 0.5),
+           percentile(outcomeLatencies, 0.99), outcomeLatencies.size());
+    printf("Move to next request: p50 %.3f ms, p99 %.3f ms\n", percentile(turnLatencies, 0.5),
+           percentile(turnLatencies, 0.99));
+
+    return 0;
+}
@@ -0,0 +1,158 @@
+/* CSCI 261 Final Project: GUI Battleship (Logging Benchmark)
+ *
+ * Author: Colin Siles
+ *
+ * Measures what logging costs a batch simulation: plays the same games (with the same seeds) with nothing listening
+ * to the event bus, then with a BinaryBattlelogWriter subscribed under each flush policy, and prints how much slower
+ * each one was. Games are played one after another on this thread, the way a simulation would. Each run is repeated a
+ * few times, taking turns with the others, and its best time is kept
+ *
+ * Usage: logbench [games] [random|intelligent] [rounds]
+*/
+
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <memory>
+#include <string>
+#include <type_traits>
+#include <vector>
+
+#include <unistd.h>
+
+#include "BinaryBattlelogWriter.h"
+#include "Game.h"
+#include "IntelligentComputer.h"
+#include "RandomComputerPlayer.h"
+
+using namespace std;
+
+static const char *BENCHMARK_FILE = "logbench.bsl";
+
+// Events published to time publishing on its own
+static const int TIMED_EVENTS = 1000000;
+
+// Counts the events published, to find how many there are in a game
+class EventCounter : public GameEventSubscriber {
+public:
+    long events = 0;
+
+    void onEvent(const GameEvent &) override {
+        events++;
+    }
+};
+
+// Plays the games on the given bus, returning how long they took in seconds
+template<typename PlayerType>
+double playGames(int numGames, GameEventBus &eventBus) {
+    chrono::steady_clock::time_point start = chrono::steady_clock::now();
+
+    for(int i = 0; i < numGames; i++) {
+        Game<PlayerType, PlayerType> game("One", "Two", {5, 4, 4, 3, 2}, "");
+        game.setEventBus(&eventBus, i);
+        game.setSeed(i + 1);
+
+        // The computers don't learn between games here, so every run plays the same games
+        if constexpr(is_same_v<PlayerType, IntelligentComputer>) {
+            for(IntelligentComputer *player : {&game.getPlayerOne(), &game.getPlayerTwo()}) {
+                player->setPlacementLearning(false);
+                player->setFiringProfiling(false);
+            }
+        }
+
+        game.runGame();
+    }
+
+    return chrono::duration<double>(chrono::steady_clock::now() - start).count();
+}
+
+// Plays the games with the given flush policy (or without logging, if there isn't one), returning how long they took
+// in seconds. The bus is destroyed (after writing out everything) before the time is taken, so that's counted too
+template<typename PlayerType>
+double timeGames(int numGames, const FlushPolicy *flushPolicy) {
+    unlink(BENCHMARK_FILE);
+
+    BinaryBattlelogWriter battlelog(BENCHMARK_FILE);
+    chrono::steady_clock::time_point start = chrono::steady_clock::now();
+
+    {
+        GameEventBus eventBus;
+        if(flushPolicy) {
+            eventBus.subscribe(&battlelog, *flushPolicy);
+        }
+
+        playGames<PlayerType>(numGames, eventBus);
+    }
+
+    return chrono::duration<double>(chrono::steady_clock::now() - start).count();
+}
+
+// Plays the games without logging, and then with each of the flush policies. The runs take turns, and each one's best
+// time is kept, so that noise from the rest of the machine affects them all alike
+template<typename PlayerType>
+void compare(int numGames, int numRounds) {
+    vector<string> names = {"No logging", "Flush per game", "Flush every 4096 events", "Flush every 100 ms"};
+    vector<FlushPolicy> policies(3);
+    policies.at(1).mode = FLUSH_EVERY_N_EVENTS;
+    policies.at(2).mode = FLUSH_ON_TIMER;
+    policies.at(2).milliseconds = 100;
+
+    vector<double> best(names.size(), 1e30);
+
+    for(int round = 0; round < numRounds; round++) {
+        for(int i = 0; i < names.size(); i++) {
+            best.at(i) = min(best.at(i), timeGames<PlayerType>(numGames, i == 0 ? nullptr : &policies.at(i - 1)));
+        }
+    }
+
+    for(int i = 0; i < names.size(); i++) {
+        printf("%-24s %9.2f us per game (%+.2f%%)\n", names.at(i).c_str(), 1e6 * best.at(i) / numGames,
+               100 * (best.at(i) - best.at(0)) / best.at(0));
+    }
+
+    // The times above include the battlelog's own thread, which only costs the games anything when it has to share a
+    // core with them. What the game's thread itself pays is the time to publish each event
+    EventCounter counter;
+    {
+        GameEventBus eventBus;
+        eventBus.subscribe(&counter);
+        playGames<PlayerType>(min(numGames, 100), eventBus);
+    }
+
+    double eventsPerGame = (double) counter.events / min(numGames, 100);
+
+    unlink(BENCHMARK_FILE);
+    BinaryBattlelogWriter battlelog(BENCHMARK_FILE);
+    GameEventBus eventBus;
+    eventBus.subscribe(&battlelog);
+
+    // Timing events, which the battlelog takes off the ring but doesn't keep
+    GameEvent event = {MOVE_TIMED, 0, 0, -1, -1, false, -1, 1.0, 0, {}};
+    chrono::steady_clock::time_point start = chrono::steady_clock::now();
+
+    for(int i = 0; i < TIMED_EVENTS; i++) {
+        eventBus.publish(event);
+    }
+
+    double publishSeconds = chrono::duration<double>(chrono::steady_clock::now() - start).count() / TIMED_EVENTS;
+
+    printf("Publishing: %.1f ns per event, %.0f events per game, so %.3f%% of the game's thread\n", 1e9 * publishSeconds,
+           eventsPerGame, 100 * publishSeconds * eventsPerGame / (best.at(0) / numGames));
+
+    unlink(BENCHMARK_FILE);
+}
+
+int main(int argc, char *argv[]) {
+    int numGames = argc > 1 ? atoi(argv[1]) : 1000;
+    string players = argc > 2 ? argv[2] : "intelligent";
+    int numRounds = argc > 3 ? atoi(argv[3]) : 3;
+
+    if(players == "random") {
+        compare<RandomComputerPlayer>(numGames, numRounds);
+    } else {
+        compare<IntelligentComputer>(numGames, numRounds);
+    }
+
+    return 0;
+}
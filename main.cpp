@@ -6,6 +6,7 @@
  *
  * A 2D vector is used to store the board
  * A file, called "battlelog.txt" is written to, which reports all the shots made during the game
+ * A game that's closed before it's over is saved to "savedgame.snapshot", and picked up again next time
  * A series of classes were created to implement Battleship
 */
 
@@ -20,6 +21,12 @@ int main() {
     // Seed random number generator for the computer player
     srand(time(0));
 
+    // Use the computer's tuned parameters, if they've been tuned (see autotune.cpp)
+    AIParameters parameters;
+    if(parameters.load(AIParameters::DEFAULT_FILE)) {
+        IntelligentComputer::setDefaultParameters(parameters);
+    }
+
     // Uncomment these lines to customize the length of the ships you play with
     /*
     vector<int> shipLengths = {3, 3, 3, 3, 3, 3};
@@ -29,6 +36,14 @@ int main() {
     // Instantiate the game object with the given types and names
     Game<HumanSFMLPlayer, IntelligentComputer> game("Human", "Computer");
 
+    // The computer learns how you place your ships and where you fire, over every game you play against it
+    game.getPlayerTwo().setPlacementLearning(true);
+    game.getPlayerTwo().setFiringProfiling(true);
+
+    // Pick up where the last game left off if its window was closed part way through, and keep saving this one
+    game.loadSnapshot(GameSnapshot::DEFAULT_FILE);
+    game.setAutosave(GameSnapshot::DEFAULT_FILE);
+
     // Run the game
     game.runGame();
 }
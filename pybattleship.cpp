@@ -0,0 +1,568 @@
+/* CSCI 261 Final Project: GUI Battleship (Python Bindings)
+ *
+ * Author: Colin Siles
+ *
+ * A Python extension module ("battleship") for running the headless engine from Python. GameBatch plays many games
+ * at once (see GameBatch.h), and its state comes back as read-only arrays that look straight at the engine's memory,
+ * through the buffer protocol, so numpy.asarray (or memoryview) wraps them without copying. They're updated in place
+ * by step() and reset(), so they only need getting once. The GIL is let go while the engine works, so other Python
+ * threads keep running (including stepping other batches)
+ *
+ *   import battleship, numpy
+ *   batch = battleship.GameBatch(1000, "intelligent", "random", seed=1, threads=8)
+ *   boards = numpy.asarray(batch.boards)        # [game, player, x, y]: 0 unknown, 1 miss, 2 hit
+ *   densities = numpy.asarray(batch.densities)  # [game, player, x, y]
+ *   while batch.step(10):                        # 10 moves in every game still going
+ *       ...
+ *   winners = numpy.asarray(batch.winners)
+ *   density = numpy.asarray(battleship.density([(4, 4, True, -1), (4, 5, False, -1)]))
+ *
+ * Build: g++ -O2 -std=c++20 -shared -fPIC $(python3-config --includes) pybattleship.cpp <the engine's .cpp files>
+ *            -o battleship$(python3-config --extension-suffix) -lpthread
+ *        (the engine's files being the ones starting with a capital letter, apart from HumanSFMLPlayer, the
+ *        renderers and ReplayViewer, which need SFML). Needs Python 3.10 or later
+*/
+
+#define PY_SSIZE_T_CLEAN
+#include <Python.h>
+
+#include <exception>
+#include <string>
+#include <vector>
+
+#include "Board.h"
+#include "GameBatch.h"
+#include "PlacementTable.h"
+
+using namespace std;
+
+// A read-only array, looking at memory belonging to another object (which it keeps alive), or to itself
+struct ArrayObject {
+    PyObject_HEAD
+    PyObject *owner;
+    vector<int32_t> *ownData;
+    const void *data;
+    const char *format;
+    Py_ssize_t itemSize;
+    int ndim;
+    Py_ssize_t shape[4];
+    Py_ssize_t strides[4];
+};
+
+// A batch is only initialized once, so the arrays handed out over its state stay valid for as long as it's around
+struct BatchObject {
+    PyObject_HEAD
+    GameBatch *batch;
+    int threads;
+    bool busy; // Set while the engine is working without the GIL, so the batch isn't stepped twice at once
+};
+
+// The types are created from their specs (below) when the module is loaded
+static PyTypeObject *ArrayType = nullptr;
+static PyTypeObject *BatchType = nullptr;
+
+// Reads a fleet's ship lengths, which have to fit on the board. Returns false (with an exception set) if they don't
+static bool parseShipLengths(PyObject *lengthsObject, vector<int> &shipLengths) {
+    PyObject *sequence = PySequence_Fast(lengthsObject, "ship_lengths must be a sequence of ints");
+    if(!sequence) {
+        return false;
+    }
+
+    shipLengths.clear();
+    for(Py_ssize_t i = 0; i < PySequence_Fast_GET_SIZE(sequence); i++) {
+        shipLengths.push_back(PyLong_AsLong(PySequence_Fast_GET_ITEM(sequence, i)));
+    }
+    Py_DECREF(sequence);
+
+    if(PyErr_Occurred()) {
+        return false;
+    }
+
+    int squares = 0;
+    for(int i = 0; i < shipLengths.size(); i++) {
+        if(shipLengths.at(i) < 1 || shipLengths.at(i) > Board::GRID_SIZE) {
+            PyErr_Format(PyExc_ValueError, "ship lengths have to be from 1 to %d", Board::GRID_SIZE);
+            return false;
+        }
+
+        squares += shipLengths.at(i);
+    }
+
+    if(shipLengths.empty() || squares > NUM_CELLS) {
+        PyErr_SetString(PyExc_ValueError, "ship_lengths has to have at least one ship, and fit on the board");
+        return false;
+    }
+
+    return true;
+}
+
+// Raises a C++ exception the engine threw (caught while the GIL was let go, since it can't pass through Python) as a
+// RuntimeError
+static void raiseEngineError(const string &message) {
+    PyErr_Format(PyExc_RuntimeError, "the engine failed: %s", message.c_str());
+}
+
+// Creates an array over the given memory, with the given shape (C order)
+static PyObject *newArray(PyObject *owner, const void *data, const char *format, Py_ssize_t itemSize,
+                          vector<Py_ssize_t> shape) {
+    ArrayObject *array = (ArrayObject *) ArrayType->tp_alloc(ArrayType, 0);
+    if(!array) {
+        return nullptr;
+    }
+
+    Py_XINCREF(owner);
+    array->owner = owner;
+    array->ownData = nullptr;
+    array->data = data;
+    array->format = format;
+    array->itemSize = itemSize;
+    array->ndim = shape.size();
+
+    Py_ssize_t stride = itemSize;
+    for(int i = array->ndim - 1; i >= 0; i--) {
+        array->shape[i] = shape.at(i);
+        array->strides[i] = stride;
+        stride *= shape.at(i);
+    }
+
+    return (PyObject *) array;
+}
+
+// Instances of a heap type hold a reference to it, which goes when they do
+static void Array_dealloc(ArrayObject *self) {
+    PyTypeObject *type = Py_TYPE(self);
+
+    Py_XDECREF(self->owner);
+    delete self->ownData;
+    type->tp_free((PyObject *) self);
+    Py_DECREF(type);
+}
+
+static int Array_getbuffer(ArrayObject *self, Py_buffer *view, int flags) {
+    if(flags & PyBUF_WRITABLE) {
+        PyErr_SetString(PyExc_BufferError, "battleship arrays are read only");
+        return -1;
+    }
+
+    Py_ssize_t length = self->itemSize;
+    for(int i = 0; i < self->ndim; i++) {
+        length *= self->shape[i];
+    }
+
+    view->obj = (PyObject *) self;
+    Py_INCREF(self);
+
+    view->buf = (void *) self->data;
+    view->len = length;
+    view->readonly = 1;
+    view->itemsize = self->itemSize;
+    view->format = (flags & PyBUF_FORMAT) ? (char *) self->format : nullptr;
+    view->ndim = self->ndim;
+    view->shape = (flags & PyBUF_ND) ? self->shape : nullptr;
+    view->strides = (flags & PyBUF_STRIDES) == PyBUF_STRIDES ? self->strides : nullptr;
+    view->suboffsets = nullptr;
+    view->internal = nullptr;
+
+    return 0;
+}
+
+static PyObject *Array_getShape(ArrayObject *self, void *) {
+    PyObject *shape = PyTuple_New(self->ndim);
+    for(int i = 0; shape && i < self->ndim; i++) {
+        PyTuple_SET_ITEM(shape, i, PyLong_FromSsize_t(self->shape[i]));
+    }
+
+    return shape;
+}
+
+static PyGetSetDef arrayGetSets[] = {
+    {"shape", (getter) Array_getShape, nullptr, "The size of each dimension", nullptr},
+    {nullptr, nullptr, nullptr, nullptr, nullptr}
+};
+
+// Arrays are only made by the module, so they can't be created from Python
+static PyType_Slot arraySlots[] = {
+    {Py_tp_doc, (void *) "A read-only view of engine memory (wrap it with numpy.asarray or memoryview)"},
+    {Py_tp_dealloc, (void *) Array_dealloc},
+    {Py_tp_getset, arrayGetSets},
+    {Py_bf_getbuffer, (void *) Array_getbuffer},
+    {0, nullptr}
+};
+
+static PyType_Spec arraySpec = {
+    "battleship.Array", sizeof(ArrayObject), 0, Py_TPFLAGS_DEFAULT | Py_TPFLAGS_DISALLOW_INSTANTIATION, arraySlots
+};
+
+static int Batch_init(BatchObject *self, PyObject *args, PyObject *kwargs) {
+    static const char *keywords[] = {"games", "first", "second", "seed", "ship_lengths", "threads", nullptr};
+
+    int games;
+    const char *first = "intelligent";
+    const char *second = "intelligent";
+    unsigned long long seed = 0;
+    PyObject *lengthsObject = nullptr;
+    int threads = 1;
+
+    if(!PyArg_ParseTupleAndKeywords(args, kwargs, "i|ssKOi", (char **) keywords, &games, &first, &second, &seed,
+                                    &lengthsObject, &threads)) {
+        return -1;
+    }
+
+    vector<int> shipLengths = {5, 4, 4, 3, 2};
+    if(lengthsObject && lengthsObject != Py_None && !parseShipLengths(lengthsObject, shipLengths)) {
+        return -1;
+    }
+
+    if(games < 0) {
+        PyErr_SetString(PyExc_ValueError, "games can't be negative");
+        return -1;
+    }
+
+    // Initializing again would free the memory the batch's arrays look at (or the batch while it's being stepped)
+    if(self->batch || self->busy) {
+        PyErr_SetString(PyExc_RuntimeError, "the GameBatch is already initialized");
+        return -1;
+    }
+
+    // Creating the players (and placing their ships) can take a while for big batches
+    GameBatch *batch = nullptr;
+    string firstPlayer = first;
+    string secondPlayer = second;
+    string error;
+
+    self->busy = true;
+
+    Py_BEGIN_ALLOW_THREADS
+    try {
+        batch = new GameBatch(games, firstPlayer, secondPlayer, shipLengths, seed);
+    } catch(const exception &thrown) {
+        error = thrown.what();
+    }
+    Py_END_ALLOW_THREADS
+
+    self->busy = false;
+
+    if(!batch) {
+        raiseEngineError(error);
+        return -1;
+    }
+
+    if(games > 0 && batch->getNumRunning() == 0) {
+        delete batch;
+        PyErr_SetString(PyExc_ValueError, "couldn't create the players (see the message above)");
+        return -1;
+    }
+
+    self->batch = batch;
+    self->threads = max(threads, 1);
+    return 0;
+}
+
+static void Batch_dealloc(BatchObject *self) {
+    PyTypeObject *type = Py_TYPE(self);
+
+    delete self->batch;
+    type->tp_free((PyObject *) self);
+    Py_DECREF(type);
+}
+
+// Checks the batch can be used, and marks it busy. Returns false (with an exception set) if it can't
+static bool startWork(BatchObject *self) {
+    if(!self->batch) {
+        PyErr_SetString(PyExc_RuntimeError, "the GameBatch wasn't initialized");
+        return false;
+    }
+
+    if(self->busy) {
+        PyErr_SetString(PyExc_RuntimeError, "the GameBatch is already being stepped in another thread");
+        return false;
+    }
+
+    self->busy = true;
+    return true;
+}
+
+static PyObject *Batch_step(BatchObject *self, PyObject *args) {
+    int moves = 1;
+    if(!PyArg_ParseTuple(args, "|i", &moves) || !startWork(self)) {
+        return nullptr;
+    }
+
+    int running = 0;
+    bool failed = false;
+    string error;
+
+    Py_BEGIN_ALLOW_THREADS
+    try {
+        running = self->batch->step(moves, self->threads);
+    } catch(const exception &thrown) {
+        failed = true;
+        error = thrown.what();
+    }
+    Py_END_ALLOW_THREADS
+
+    self->busy = false;
+
+    if(failed) {
+        raiseEngineError(error);
+        return nullptr;
+    }
+
+    return PyLong_FromLong(running);
+}
+
+static PyObject *Batch_run(BatchObject *self, PyObject *) {
+    if(!startWork(self)) {
+        return nullptr;
+    }
+
+    bool failed = false;
+    string error;
+
+    Py_BEGIN_ALLOW_THREADS
+    try {
+        self->batch->run(self->threads);
+    } catch(const exception &thrown) {
+        failed = true;
+        error = thrown.what();
+    }
+    Py_END_ALLOW_THREADS
+
+    self->busy = false;
+
+    if(failed) {
+        raiseEngineError(error);
+        return nullptr;
+    }
+
+    Py_RETURN_NONE;
+}
+
+static PyObject *Batch_reset(BatchObject *self, PyObject *args) {
+    unsigned long long seed = 0;
+    if(!PyArg_ParseTuple(args, "|K", &seed) || !startWork(self)) {
+        return nullptr;
+    }
+
+    bool succeeded = false;
+    bool failed = false;
+    string error;
+
+    Py_BEGIN_ALLOW_THREADS
+    try {
+        succeeded = self->batch->reset(seed);
+    } catch(const exception &thrown) {
+        failed = true;
+        error = thrown.what();
+    }
+    Py_END_ALLOW_THREADS
+
+    self->busy = false;
+
+    if(failed) {
+        raiseEngineError(error);
+        return nullptr;
+    }
+
+    if(!succeeded) {
+        PyErr_SetString(PyExc_ValueError, "couldn't create the players (see the message above)");
+        return nullptr;
+    }
+
+    Py_RETURN_NONE;
+}
+
+static PyObject *Batch_getGames(BatchObject *self, void *) {
+    return PyLong_FromLong(self->batch ? self->batch->getNumGames() : 0);
+}
+
+static PyObject *Batch_getRunning(BatchObject *self, void *) {
+    return PyLong_FromLong(self->batch ? self->batch->getNumRunning() : 0);
+}
+
+static PyObject *Batch_getShipLengths(BatchObject *self, void *) {
+    vector<int> shipLengths = self->batch ? self->batch->getShipLengths() : vector<int>();
+
+    PyObject *lengths = PyTuple_New(shipLengths.size());
+    for(int i = 0; lengths && i < shipLengths.size(); i++) {
+        PyTuple_SET_ITEM(lengths, i, PyLong_FromLong(shipLengths.at(i)));
+    }
+
+    return lengths;
+}
+
+// The arrays over the batch's state, which keep the batch alive for as long as they're around
+static PyObject *Batch_getArray(BatchObject *self, void *which) {
+    if(!self->batch) {
+        PyErr_SetString(PyExc_RuntimeError, "the GameBatch wasn't initialized");
+        return nullptr;
+    }
+
+    const GameBatch &batch = *self->batch;
+    PyObject *owner = (PyObject *) self;
+    Py_ssize_t games = batch.getNumGames();
+    Py_ssize_t size = Board::GRID_SIZE;
+    string name = (const char *) which;
+
+    if(name == "boards") {
+        return newArray(owner, batch.getBoards(), "B", 1, {games, 2, size, size});
+    } else if(name == "densities") {
+        return newArray(owner, batch.getDensities(), "i", 4, {games, 2, size, size});
+    } else if(name == "last_moves") {
+        return newArray(owner, batch.getLastMoves(), "h", 2, {games, 2, 2});
+    } else if(name == "shots") {
+        return newArray(owner, batch.getShots(), "h", 2, {games, 2});
+    } else if(name == "ships_afloat") {
+        return newArray(owner, batch.getShipsAfloat(), "I", 4, {games, 2});
+    } else if(name == "turns") {
+        return newArray(owner, batch.getTurns(), "b", 1, {games});
+    }
+
+    return newArray(owner, batch.getWinners(), "b", 1, {games});
+}
+
+static PyMethodDef batchMethods[] = {
+    {"step", (PyCFunction) Batch_step, METH_VARARGS,
+     "step(moves=1): makes up to that many moves in every game still going, and returns how many still are"},
+    {"run", (PyCFunction) Batch_run, METH_NOARGS, "run(): plays every game to the end"},
+    {"reset", (PyCFunction) Batch_reset, METH_VARARGS, "reset(seed=0): starts every game over"},
+    {nullptr, nullptr, 0, nullptr}
+};
+
+static PyGetSetDef batchGetSets[] = {
+    {"games", (getter) Batch_getGames, nullptr, "Number of games in the batch", nullptr},
+    {"running", (getter) Batch_getRunning, nullptr, "Number of games still going", nullptr},
+    {"ship_lengths", (getter) Batch_getShipLengths, nullptr, "The fleet every game is played with", nullptr},
+    {"boards", (getter) Batch_getArray, nullptr, "uint8 [game, player, x, y]: 0 unknown, 1 miss, 2 hit",
+     (void *) "boards"},
+    {"densities", (getter) Batch_getArray, nullptr, "int32 [game, player, x, y]: density behind the last move",
+     (void *) "densities"},
+    {"last_moves", (getter) Batch_getArray, nullptr, "int16 [game, player, 2]: last move, or -1, -1",
+     (void *) "last_moves"},
+    {"shots", (getter) Batch_getArray, nullptr, "int16 [game, player]: shots fired", (void *) "shots"},
+    {"ships_afloat", (getter) Batch_getArray, nullptr, "uint32 [game, player]: bit i set if opponent ship i is afloat",
+     (void *) "ships_afloat"},
+    {"turns", (getter) Batch_getArray, nullptr, "int8 [game]: the player to move next", (void *) "turns"},
+    {"winners", (getter) Batch_getArray, nullptr, "int8 [game]: the winner, or -1 while going", (void *) "winners"},
+    {nullptr, nullptr, nullptr, nullptr, nullptr}
+};
+
+static PyType_Slot batchSlots[] = {
+    {Py_tp_doc, (void *) "GameBatch(games, first='intelligent', second='intelligent', seed=0, ship_lengths=None, "
+                         "threads=1)\nPlays many games at once between PlayerRegistry players"},
+    {Py_tp_new, (void *) PyType_GenericNew},
+    {Py_tp_init, (void *) Batch_init},
+    {Py_tp_dealloc, (void *) Batch_dealloc},
+    {Py_tp_methods, batchMethods},
+    {Py_tp_getset, batchGetSets},
+    {0, nullptr}
+};
+
+static PyType_Spec batchSpec = {"battleship.GameBatch", sizeof(BatchObject), 0, Py_TPFLAGS_DEFAULT, batchSlots};
+
+// density(moves, ship_lengths=None): moves are (x, y, hit, sunk index or -1) tuples
+static PyObject *density(PyObject *, PyObject *args, PyObject *kwargs) {
+    static const char *keywords[] = {"moves", "ship_lengths", nullptr};
+
+    PyObject *movesObject;
+    PyObject *lengthsObject = nullptr;
+
+    if(!PyArg_ParseTupleAndKeywords(args, kwargs, "O|O", (char **) keywords, &movesObject, &lengthsObject)) {
+        return nullptr;
+    }
+
+    PyObject *sequence = PySequence_Fast(movesObject, "moves must be a sequence of (x, y, hit, sunk index) tuples");
+    if(!sequence) {
+        return nullptr;
+    }
+
+    vector<int> shipLengths = {5, 4, 4, 3, 2};
+    if(lengthsObject && lengthsObject != Py_None && !parseShipLengths(lengthsObject, shipLengths)) {
+        Py_DECREF(sequence);
+        return nullptr;
+    }
+
+    // Moves off the board are skipped by densityFor, but a sunk index has to be one of the ships
+    vector<RecordedMove> moves;
+    for(Py_ssize_t i = 0; i < PySequence_Fast_GET_SIZE(sequence); i++) {
+        int xPos, yPos, hit, sunkenIndex;
+
+        if(!PyArg_ParseTuple(PySequence_Fast_GET_ITEM(sequence, i), "iipi", &xPos, &yPos, &hit, &sunkenIndex)) {
+            Py_DECREF(sequence);
+            return nullptr;
+        }
+
+        if(sunkenIndex < -1 || sunkenIndex >= (int) shipLengths.size()) {
+            PyErr_Format(PyExc_ValueError, "sunk index %d isn't -1 or one of the %d ships", sunkenIndex,
+                         (int) shipLengths.size());
+            Py_DECREF(sequence);
+            return nullptr;
+        }
+
+        moves.push_back({0, xPos, yPos, (bool) hit, sunkenIndex >= 0, sunkenIndex});
+    }
+    Py_DECREF(sequence);
+
+    vector<int32_t> *grid = new vector<int32_t>();
+    bool failed = false;
+    string error;
+
+    Py_BEGIN_ALLOW_THREADS
+    try {
+        *grid = GameBatch::densityFor(moves, shipLengths);
+    } catch(const exception &thrown) {
+        failed = true;
+        error = thrown.what();
+    }
+    Py_END_ALLOW_THREADS
+
+    if(failed) {
+        delete grid;
+        raiseEngineError(error);
+        return nullptr;
+    }
+
+    PyObject *array = newArray(nullptr, grid->data(), "i", 4, {Board::GRID_SIZE, Board::GRID_SIZE});
+    if(!array) {
+        delete grid;
+        return nullptr;
+    }
+
+    ((ArrayObject *) array)->ownData = grid;
+    return array;
+}
+
+static PyMethodDef moduleMethods[] = {
+    {"density", (PyCFunction) (void (*)(void)) density, METH_VARARGS | METH_KEYWORDS,
+     "density(moves, ship_lengths=None): the IntelligentComputer's density [x, y] after the given\n"
+     "(x, y, hit, sunk index or -1) moves"},
+    {nullptr, nullptr, 0, nullptr}
+};
+
+static PyModuleDef battleshipModule = {
+    PyModuleDef_HEAD_INIT, "battleship", "Bindings to the headless Battleship engine", -1, moduleMethods, nullptr,
+    nullptr, nullptr, nullptr
+};
+
+PyMODINIT_FUNC PyInit_battleship() {
+    ArrayType = (PyTypeObject *) PyType_FromSpec(&arraySpec);
+    BatchType = (PyTypeObject *) PyType_FromSpec(&batchSpec);
+
+    if(!ArrayType || !BatchType) {
+        return nullptr;
+    }
+
+    PyObject *module = PyModule_Create(&battleshipModule);
+    if(!module) {
+        return nullptr;
+    }
+
+    Py_INCREF(BatchType);
+    if(PyModule_AddObject(module, "GameBatch", (PyObject *) BatchType) < 0) {
+        Py_DECREF(BatchType);
+        Py_DECREF(module);
+        return nullptr;
+    }
+
+    return module;
+}
@@ -0,0 +1,47 @@
+/* CSCI 261 Final Project: GUI Battleship (Replay Viewer)
+ *
+ * Author: Colin Siles
+ *
+ * Plays back recorded games in a window, from binary battlelogs (any number of games each) or text battlelogs.
+ * See ReplayViewer.h for the controls
+ *
+ * Usage: replaygames [--speed moves_per_second] [--game first_game] games.bsl|battlelog.txt [more...]
+*/
+
+#include <cstdio>
+#include <string>
+
+#include "ReplayViewer.h"
+
+using namespace std;
+
+int main(int argc, char *argv[]) {
+    double movesPerSecond = 10;
+    int firstGame = 1;
+
+    ReplayViewer viewer;
+
+    for(int i = 1; i < argc; i++) {
+        string argument = argv[i];
+
+        if(argument == "--speed" && i + 1 < argc) {
+            movesPerSecond = stod(argv[++i]);
+        } else if(argument == "--game" && i + 1 < argc) {
+            firstGame = stoi(argv[++i]);
+        } else {
+            viewer.addFile(argument);
+        }
+    }
+
+    if(viewer.getNumGames() == 0) {
+        fprintf(stderr, "Usage: replaygames [--speed moves_per_second] [--game first_game] "
+                        "games.bsl|battlelog.txt [more...]\n");
+        return 1;
+    }
+
+    printf("Replaying %d games\n", viewer.getNumGames());
+
+    // Games are numbered from 1 on the screen
+    viewer.run(firstGame - 1, movesPerSecond);
+    return 0;
+}
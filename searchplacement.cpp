@@ -0,0 +1,61 @@
+/* CSCI 261 Final Project: GUI Battleship (Adversarial Placement Search)
+ *
+ * Author: Colin Siles
+ *
+ * Searches for a fleet placement that survives as long as possible against the IntelligentComputer (see
+ * PlacementSearch), then prints the fleet and how many shots the computer is expected to need to sink it
+ *
+ * Usage: searchplacement [milliseconds] [hunter endgame threshold] [seed]
+*/
+
+#include <cstdio>
+#include <cstdlib>
+#include <ctime>
+#include <vector>
+
+#include "PlacementSearch.h"
+#include "PlacementTable.h"
+
+using namespace std;
+
+int main(int argc, char *argv[]) {
+    double milliseconds = argc > 1 ? atof(argv[1]) : 2000;
+    int endgameThreshold = argc > 2 ? atoi(argv[2]) : 32;
+    unsigned seed = argc > 3 ? atoi(argv[3]) : time(0);
+
+    vector<int> shipLengths = {5, 4, 4, 3, 2};
+
+    PlacementSearch search(shipLengths);
+    search.setHunterEndgameThreshold(endgameThreshold);
+
+    PlacementSearchResult result = search.search(milliseconds, seed);
+
+    // Draw the fleet, with each ship labeled by its position in the fleet
+    vector<vector<char>> grid(Board::GRID_SIZE, vector<char>(Board::GRID_SIZE, '.'));
+
+    for(int i = 0; i < result.placements.size(); i++) {
+        const Placement &placement =
+                PlacementTable::forLength(shipLengths.at(i)).placements().at(result.placements.at(i));
+
+        for(int j = 0; j < placement.cells.size(); j++) {
+            pair<int, int> coords = cellCoords(placement.cells.at(j));
+            grid.at(coords.first).at(coords.second) = '1' + i;
+        }
+    }
+
+    // Rows are lettered by the y position, like the battlelog
+    for(int y = 0; y < Board::GRID_SIZE; y++) {
+        printf("%c ", 'A' + y);
+
+        for(int x = 0; x < Board::GRID_SIZE; x++) {
+            printf(" %c", grid.at(x).at(y));
+        }
+
+        printf("\n");
+    }
+
+    printf("\nExpected shots to sink: %.2f +/- %.2f (over %d hunts, %d simulated in total)\n", result.expectedShots,
+           result.standardError, result.hunts, result.totalHunts);
+
+    return 0;
+}
@@ -0,0 +1,109 @@
+/* CSCI 261 Final Project: GUI Battleship (Match Server)
+ *
+ * Author: Colin Siles
+ *
+ * Runs a MatchServer until interrupted, printing how many games are going, how many have finished, and how much
+ * memory the server is using every few seconds. Use loadgen to put it under load
+ *
+ * Usage: servematches [--port n | --unix path] [--threads n]
+ * e.g.   servematches --unix /tmp/battleship.sock --threads 2
+*/
+
+#include <atomic>
+#include <chrono>
+#include <csignal>
+#include <cstdio>
+#include <cstdlib>
+#include <string>
+#include <thread>
+
+#include <sys/resource.h>
+
+#include "MatchServer.h"
+
+using namespace std;
+
+// How often the stats are printed
+static const int REPORT_SECONDS = 5;
+
+static MatchServer *server = nullptr;
+
+static void handleSignal(int) {
+    server->stop();
+}
+
+// Peak memory use of the process, in kilobytes
+static long peakMemory() {
+    struct rusage usage;
+    getrusage(RUSAGE_SELF, &usage);
+
+    return usage.ru_maxrss;
+}
+
+int main(int argc, char *argv[]) {
+    int port = 7777;
+    string unixPath;
+    int numThreads = 2;
+
+    for(int i = 1; i + 1 < argc; i += 2) {
+        string option = argv[i];
+
+        if(option == "--port") {
+            port = atoi(argv[i + 1]);
+        } else if(option == "--unix") {
+            unixPath = argv[i + 1];
+        } else if(option == "--threads") {
+            numThreads = atoi(argv[i + 1]);
+        } else {
+            fprintf(stderr, "Usage: servematches [--port n | --unix path] [--threads n]\n");
+            return 1;
+        }
+    }
+
+    long baseMemory = peakMemory();
+
+    MatchServer matchServer(numThreads);
+    server = &matchServer;
+
+    if(unixPath.empty() ? !matchServer.listenTcp(port) : !matchServer.listenUnix(unixPath)) {
+        return 1;
+    }
+
+    signal(SIGINT, handleSignal);
+    signal(SIGTERM, handleSignal);
+
+    printf("Serving on %s with %d threads\n", unixPath.empty() ? ("port " + to_string(port)).c_str() : unixPath.c_str(),
+           numThreads);
+    fflush(stdout);
+
+    // The stats are printed from another thread, while this one runs the event loop
+    atomic<bool> finished(false);
+    thread reporter([&]() {
+        long lastFinished = 0;
+        int mostActive = 0;
+
+        while(!finished) {
+            for(int i = 0; i < REPORT_SECONDS * 10 && !finished; i++) {
+                this_thread::sleep_for(chrono::milliseconds(100));
+                mostActive = max(mostActive, matchServer.getActiveGames());
+            }
+
+            long finishedGames = matchServer.getFinishedGames();
+            long memory = peakMemory();
+
+            printf("%d games on, %ld finished (%.0f games/s), peak memory %.1f MB (%.1f KB per game at the busiest)\n",
+                   matchServer.getActiveGames(), finishedGames, (double) (finishedGames - lastFinished) / REPORT_SECONDS,
+                   memory / 1024.0, mostActive > 0 ? (double) (memory - baseMemory) / mostActive : 0.0);
+            fflush(stdout);
+
+            lastFinished = finishedGames;
+        }
+    });
+
+    matchServer.run();
+
+    finished = true;
+    reporter.join();
+
+    return 0;
+}
@@ -0,0 +1,276 @@
+/* CSCI 261 Final Project: GUI Battleship (Tournament)
+ *
+ * Author: Colin Siles
+ *
+ * Plays a round-robin tournament between players from the PlayerRegistry, on every core, and prints each player's
+ * Elo rating and average shots-to-win, and the result of each pairing, with 95% confidence intervals
+ *
+ * Each pairing is played in batches of games, alternating who fires first. After every batch, a sequential probability
+ * ratio test checks whether one player is clearly stronger (by at least the Elo margin), and stops the pairing as soon
+ * as it is, so one-sided matchups don't take the full number of games
+ *
+ * Usage: tournament [--games max per pairing] [--batch games] [--margin elo] [--alpha error rate] player player...
+ * e.g.   tournament random intelligent intelligent:latticePruning=0,endgameThreshold=0
+*/
+
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <memory>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "PlayerRegistry.h"
+#include "Simulation.h"
+
+using namespace std;
+
+// The games between two of the players
+struct Pairing {
+    int players[2];
+    int wins[2];
+    double logLikelihoodRatio;
+    int verdict; // Index of the stronger player once the test decides, -1 while it's still running, 2 if undecided
+};
+
+// The result of a single game, from the pairing's point of view
+struct GameResult {
+    int winner;
+    int winnerShots;
+};
+
+// 95% confidence interval half width for an average, from the sum and sum of squares of the values averaged
+double confidence(double total, double totalSquares, int count) {
+    if(count < 2) {
+        return 0;
+    }
+
+    double mean = total / count;
+    double variance = max(0.0, (totalSquares - total * mean) / (count - 1));
+
+    return 1.96 * sqrt(variance / count);
+}
+
+// Elo difference implied by a score (the share of games won)
+double eloFromScore(double score) {
+    return -400 * log10(1 / score - 1);
+}
+
+int main(int argc, char *argv[]) {
+    int maxGames = 1000;
+    int batchSize = 20;
+    double margin = 30;
+    double alpha = 0.05;
+    vector<string> descriptions;
+
+    for(int i = 1; i < argc; i++) {
+        string argument = argv[i];
+
+        if(argument == "--games" && i + 1 < argc) {
+            maxGames = atoi(argv[++i]);
+        } else if(argument == "--batch" && i + 1 < argc) {
+            batchSize = max(2, atoi(argv[++i]) / 2 * 2);
+        } else if(argument == "--margin" && i + 1 < argc) {
+            margin = atof(argv[++i]);
+        } else if(argument == "--alpha" && i + 1 < argc) {
+            alpha = atof(argv[++i]);
+        } else {
+            descriptions.push_back(argument);
+        }
+    }
+
+    vector<int> shipLengths = {5, 4, 4, 3, 2};
+
+    if(descriptions.size() < 2) {
+        fprintf(stderr, "Usage: tournament [--games n] [--batch n] [--margin elo] [--alpha rate] player player...\n");
+        fprintf(stderr, "Player types:");
+        for(string type : PlayerRegistry::types()) {
+            fprintf(stderr, " %s", type.c_str());
+        }
+        fprintf(stderr, "\n");
+        return 1;
+    }
+
+    // Make sure every player can be created before playing anything
+    for(int i = 0; i < descriptions.size(); i++) {
+        unique_ptr<Player> player(PlayerRegistry::create(descriptions.at(i), descriptions.at(i), shipLengths));
+        if(!player) {
+            return 1;
+        }
+    }
+
+    vector<Pairing> pairings;
+    for(int i = 0; i < descriptions.size(); i++) {
+        for(int j = i + 1; j < descriptions.size(); j++) {
+            pairings.push_back({{i, j}, {0, 0}, 0.0, -1});
+        }
+    }
+
+    // The test is between the first player being stronger by the margin, and the second being stronger by the margin
+    double strongerScore = 1 / (1 + pow(10, -margin / 400));
+    double winWeight = log(strongerScore / (1 - strongerScore));
+    double lowerBound = log(alpha / (1 - alpha));
+    double upperBound = log((1 - alpha) / alpha);
+
+    // Shots each player took to win, for their averages
+    vector<double> shotTotals(descriptions.size(), 0.0);
+    vector<double> shotSquares(descriptions.size(), 0.0);
+    vector<int> gamesWon(descriptions.size(), 0);
+
+    int numThreads = max(1, (int) thread::hardware_concurrency());
+
+    for(int played = 0; played < maxGames; played += batchSize) {
+        // A batch of games from every pairing that's still running
+        vector<int> active;
+        for(int i = 0; i < pairings.size(); i++) {
+            if(pairings.at(i).verdict < 0) {
+                active.push_back(i);
+            }
+        }
+
+        if(active.empty()) {
+            break;
+        }
+
+        int games = min(batchSize, maxGames - played);
+        vector<GameResult> results(active.size() * games);
+
+        runJobs(results.size(), numThreads, [&](int job) {
+            const Pairing &pairing = pairings.at(active.at(job / games));
+            int game = played + job % games;
+
+            // Players take turns going first, and the game number seeds both of them, so every pairing plays the
+            // same sequence of games
+            int first = game % 2;
+
+            unique_ptr<Player> players[2];
+            for(int side = 0; side < 2; side++) {
+                int index = pairing.players[side];
+
+                players[side].reset(PlayerRegistry::create(descriptions.at(index), descriptions.at(index),
+                                                           shipLengths));
+                players[side]->setSeed(game * 2 + side);
+            }
+
+            int winnerShots;
+            int winner = playGame(*players[first], *players[!first], winnerShots);
+
+            results.at(job) = {winner == 0 ? first : !first, winnerShots};
+        });
+
+        for(int job = 0; job < results.size(); job++) {
+            Pairing &pairing = pairings.at(active.at(job / games));
+            const GameResult &result = results.at(job);
+            int winner = pairing.players[result.winner];
+
+            pairing.wins[result.winner]++;
+            pairing.logLikelihoodRatio += result.winner == 0 ? winWeight : -winWeight;
+
+            shotTotals.at(winner) += result.winnerShots;
+            shotSquares.at(winner) += (double) result.winnerShots * result.winnerShots;
+            gamesWon.at(winner)++;
+        }
+
+        for(int i = 0; i < active.size(); i++) {
+            Pairing &pairing = pairings.at(active.at(i));
+
+            if(pairing.logLikelihoodRatio >= upperBound) {
+                pairing.verdict = 0;
+            } else if(pairing.logLikelihoodRatio <= lowerBound) {
+                pairing.verdict = 1;
+            }
+        }
+    }
+
+    // Pairings that used up every game without a decision
+    for(int i = 0; i < pairings.size(); i++) {
+        if(pairings.at(i).verdict < 0) {
+            pairings.at(i).verdict = 2;
+        }
+    }
+
+    printf("Pairings:\n");
+    for(int i = 0; i < pairings.size(); i++) {
+        const Pairing &pairing = pairings.at(i);
+        int games = pairing.wins[0] + pairing.wins[1];
+
+        // Keep the score off 0 and 1, where the Elo difference is infinite
+        double score = min(max((double) pairing.wins[0], 0.5), games - 0.5) / games;
+        double error = 1.96 * sqrt(score * (1 - score) / games);
+
+        printf("  %s vs %s: %d-%d, Elo %+.0f [%+.0f, %+.0f], ", descriptions.at(pairing.players[0]).c_str(),
+               descriptions.at(pairing.players[1]).c_str(), pairing.wins[0], pairing.wins[1], eloFromScore(score),
+               eloFromScore(max(score - error, 0.5 / games)), eloFromScore(min(score + error, 1 - 0.5 / games)));
+
+        if(pairing.verdict == 2) {
+            printf("undecided after %d games\n", games);
+        } else {
+            printf("%s is stronger (decided after %d games)\n",
+                   descriptions.at(pairing.players[pairing.verdict]).c_str(), games);
+        }
+    }
+
+    // Ratings for everyone at once (Bradley-Terry, fitted with the usual minorization-maximization updates). Each
+    // pairing gets half a win each way added, so a player that never won still gets a finite rating
+    int numPlayers = descriptions.size();
+    vector<vector<double>> wins(numPlayers, vector<double>(numPlayers, 0.0));
+
+    for(int i = 0; i < pairings.size(); i++) {
+        const Pairing &pairing = pairings.at(i);
+
+        wins.at(pairing.players[0]).at(pairing.players[1]) = pairing.wins[0] + 0.5;
+        wins.at(pairing.players[1]).at(pairing.players[0]) = pairing.wins[1] + 0.5;
+    }
+
+    vector<double> strength(numPlayers, 1.0);
+
+    for(int iteration = 0; iteration < 1000; iteration++) {
+        for(int i = 0; i < numPlayers; i++) {
+            double totalWins = 0;
+            double denominator = 0;
+
+            for(int j = 0; j < numPlayers; j++) {
+                if(i != j) {
+                    totalWins += wins.at(i).at(j);
+                    denominator += (wins.at(i).at(j) + wins.at(j).at(i)) / (strength.at(i) + strength.at(j));
+                }
+            }
+
+            strength.at(i) = totalWins / denominator;
+        }
+    }
+
+    // Center the ratings on zero
+    double averageLog = 0;
+    for(int i = 0; i < numPlayers; i++) {
+        averageLog += log10(strength.at(i)) / numPlayers;
+    }
+
+    printf("\n%-50s %16s %24s\n", "Player", "Elo", "Shots to win");
+    for(int i = 0; i < numPlayers; i++) {
+        // Standard error from the curvature of the likelihood around this player's rating
+        double information = 0;
+
+        for(int j = 0; j < numPlayers; j++) {
+            if(i != j) {
+                double winChance = strength.at(i) / (strength.at(i) + strength.at(j));
+                information += (wins.at(i).at(j) + wins.at(j).at(i)) * winChance * (1 - winChance);
+            }
+        }
+
+        double elo = 400 * (log10(strength.at(i)) - averageLog);
+        double eloError = 1.96 * 400 / log(10) / sqrt(information);
+
+        printf("%-50s %8.0f +/- %4.0f", descriptions.at(i).c_str(), elo, eloError);
+
+        if(gamesWon.at(i) > 0) {
+            printf(" %12.2f +/- %5.2f\n", shotTotals.at(i) / gamesWon.at(i),
+                   confidence(shotTotals.at(i), shotSquares.at(i), gamesWon.at(i)));
+        } else {
+            printf(" %24s\n", "never won");
+        }
+    }
+
+    return 0;
+}